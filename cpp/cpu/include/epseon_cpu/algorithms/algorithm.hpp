@@ -0,0 +1,50 @@
+#pragma once
+
+#include "epseon_cpu/predecl.hpp"
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+namespace epseon::cpu::cpp {
+
+    template <typename FP>
+    class Algorithm : public std::enable_shared_from_this<Algorithm<FP>> {
+        static_assert(std::is_floating_point<FP>::value, "FP must be an floating-point type.");
+
+      public: /* Public constructors. */
+        // Default constructor
+        Algorithm() = default;
+
+        // Copy constructor
+        Algorithm(const Algorithm&) = default;
+
+        // Copy assignment operator
+        Algorithm& operator=(const Algorithm&) = default;
+
+        // Move constructor
+        Algorithm(Algorithm&&) noexcept = default;
+
+        // Move assignment operator
+        Algorithm& operator=(Algorithm&&) noexcept = default;
+
+      public: /* Public destructor. */
+        virtual ~Algorithm() = default;
+
+      public: /* Public factory methods. */
+        /* CPU implementation of algorithm configured by config, raises
+         * std::runtime_error if there is none. */
+        static std::shared_ptr<Algorithm<FP>> create(const AlgorithmConfig<FP>& config) {
+            if (dynamic_cast<const VibwaAlgorithmConfig<FP>*>(&config) != nullptr) {
+                return std::make_shared<VibwaAlgorithm<FP>>();
+            }
+            throw std::runtime_error("Algorithm configuration has no CPU implementation.");
+        }
+
+      public: /* Public methods. */
+        /* Run algorithm, stop_requested is polled between batches of work. */
+        virtual void run(const std::atomic<bool>& stop_requested, TaskHandle<FP>*) = 0;
+    };
+
+} // namespace epseon::cpu::cpp
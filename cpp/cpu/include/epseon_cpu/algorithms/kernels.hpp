@@ -0,0 +1,63 @@
+#pragma once
+
+#include "epseon_cpu/enums.hpp"
+#include <cstdint>
+
+namespace epseon::cpu::cpp {
+
+    /* Block of potentials solved together by VIBWA kernel, one potential per SIMD lane.
+     * Energies are in cm^-1.
+     */
+    template <typename FP>
+    struct VibwaLaneBlock {
+        // Numerov factors scale * V(r_i), interleaved point by point - value for lane l of
+        // point i is stored at factors[i * laneCount + l].
+        const FP* factors     = nullptr;
+        // Bracket in which levels of each lane are searched, laneCount values each.
+        const FP* lowerBounds = nullptr;
+        const FP* upperBounds = nullptr;
+        // Output of each lane, levelCount values, nullptr for lanes used as padding.
+        FP* const* levels     = nullptr;
+        uint32_t   pointCount = {};
+        uint32_t   minLevel   = {};
+        uint32_t   levelCount = {};
+        // h^2 / (12 hbar^2 / 2 mu), converts energies to Numerov factors.
+        FP         scale      = {};
+    };
+
+    template <typename FP>
+    struct VibwaKernel {
+        InstructionSet instructionSet = InstructionSet::Scalar;
+        uint32_t       laneCount      = {};
+        void (*solve)(const VibwaLaneBlock<FP>&) = nullptr;
+    };
+
+    /* Get VIBWA kernel for given instruction set, raises std::runtime_error if it is not
+     * supported, see isInstructionSetSupported(). */
+    template <typename FP>
+    VibwaKernel<FP> getVibwaKernel(InstructionSet);
+
+    template <>
+    VibwaKernel<float> getVibwaKernel<float>(InstructionSet);
+
+    template <>
+    VibwaKernel<double> getVibwaKernel<double>(InstructionSet);
+
+    namespace kernels {
+        /* Kernels compiled for particular instruction sets, each lives in separate
+         * translation unit built with matching compiler flags. Use getVibwaKernel(), which
+         * checks if host CPU supports requested instruction set, instead of these. */
+        VibwaKernel<float>  getScalarVibwaKernelFloat32();
+        VibwaKernel<double> getScalarVibwaKernelFloat64();
+
+#if EPSEON_CPU_AVX2_KERNEL
+        VibwaKernel<float>  getAvx2VibwaKernelFloat32();
+        VibwaKernel<double> getAvx2VibwaKernelFloat64();
+#endif
+
+#if EPSEON_CPU_AVX512_KERNEL
+        VibwaKernel<float>  getAvx512VibwaKernelFloat32();
+        VibwaKernel<double> getAvx512VibwaKernelFloat64();
+#endif
+    } // namespace kernels
+} // namespace epseon::cpu::cpp
@@ -0,0 +1,251 @@
+#pragma once
+
+#include "epseon/libepseon.hpp"
+
+#include "epseon_cpu/predecl.hpp"
+
+#include "epseon/task_configurator/potential_source.hpp"
+#include "epseon_cpu/algorithms/algorithm.hpp"
+#include "epseon_cpu/algorithms/kernels.hpp"
+#include "epseon_cpu/task_handle.hpp"
+#include "fmt/format.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace epseon::cpu::cpp {
+
+    /* CPU implementation of VIBWA algorithm, computes same levels as GPU backend.
+     *
+     * Potentials are split into batches of HardwareConfig::group_size potentials, which
+     * are distributed dynamically between worker threads. Within batch, potentials are
+     * solved in blocks, one potential per SIMD lane of kernel selected for instruction set
+     * of ComputeContext. Last block is padded with copies of last potential.
+     */
+    template <typename FP>
+    class VibwaAlgorithm : public Algorithm<FP> {
+      public: /* Public constants. */
+        // hbar^2 / 2u in cm^-1 Angstrom^2, divided by reduced mass in u gives rotational
+        // constant B, as in GPU backend.
+        static constexpr FP kineticEnergyFactor = static_cast<FP>(16.857629206);
+        // Numerov recurrence needs at least a few points besides boundaries.
+        static constexpr uint32_t minPointCount = 6;
+
+      private: /* Private types. */
+        /* Buffers reused by worker thread for every block it solves. */
+        struct BlockBuffers {
+            std::vector<FP>  factors     = {};
+            std::vector<FP>  lowerBounds = {};
+            std::vector<FP>  upperBounds = {};
+            std::vector<FP*> levels      = {};
+
+            BlockBuffers(uint32_t laneCount, uint32_t pointCount) :
+                factors(static_cast<size_t>(laneCount) * pointCount),
+                lowerBounds(laneCount),
+                upperBounds(laneCount),
+                levels(laneCount) {}
+        };
+
+      public: /* Public constructors. */
+        // Default constructor
+        VibwaAlgorithm() = default;
+
+        // Copy constructor
+        VibwaAlgorithm(const VibwaAlgorithm&) = default;
+
+        // Copy assignment operator
+        VibwaAlgorithm& operator=(const VibwaAlgorithm&) = default;
+
+        // Move constructor
+        VibwaAlgorithm(VibwaAlgorithm&&) noexcept = default;
+
+        // Move assignment operator
+        VibwaAlgorithm& operator=(VibwaAlgorithm&&) noexcept = default;
+
+      public: /* Public destructor. */
+        virtual ~VibwaAlgorithm() = default;
+
+      public: /* Public methods. */
+        void run(const std::atomic<bool>& stop_requested, TaskHandle<FP>* handle) override {
+            const auto& configurator    = handle->getTaskConfigurator();
+            const auto  hardwareConfig  = configurator.getHardwareConfig();
+            const auto  algorithmConfig = std::dynamic_pointer_cast<VibwaAlgorithmConfig<FP>>(
+                configurator.getAlgorithmConfig()
+            );
+            if (!algorithmConfig) {
+                throw std::runtime_error("VibwaAlgorithm requires VibwaAlgorithmConfig.");
+            }
+            if (algorithmConfig->getMaxLevel() < algorithmConfig->getMinLevel()) {
+                throw std::runtime_error(fmt::format(
+                    "Max level ({}) must not be lower than min level ({}).",
+                    algorithmConfig->getMaxLevel(),
+                    algorithmConfig->getMinLevel()
+                ));
+            }
+            // Shared buffer, Morse curves are evaluated into it with vectorized evaluator,
+            // file and NumPy backed sources are used without copying.
+            const auto buffer     = configurator.getPotentialSource()->get_potential_buffer();
+            const auto potentials = buffer->getView();
+            validatePotentials(potentials, *hardwareConfig);
+
+            const uint32_t levelCount = algorithmConfig->getLevelCount();
+            handle->allocateResults(potentials.size(), levelCount);
+
+            if (potentials.empty()) {
+                return;
+            }
+            const auto kernel =
+                getVibwaKernel<FP>(handle->getComputeContext().getInstructionSet());
+
+            const uint32_t pointCount = static_cast<uint32_t>(potentials.getPointCount());
+            const FP       step       = algorithmConfig->getIntegrationStep();
+
+            VibwaLaneBlock<FP> blockTemplate{};
+            blockTemplate.pointCount = pointCount;
+            blockTemplate.minLevel   = algorithmConfig->getMinLevel();
+            blockTemplate.levelCount = levelCount;
+            blockTemplate.scale      = step * step / (12 * getReducedMassFactor(*algorithmConfig));
+
+            const size_t laneCount  = kernel.laneCount;
+            const size_t blockCount = (potentials.size() + laneCount - 1) / laneCount;
+            const size_t blocksPerBatch =
+                std::max<size_t>(hardwareConfig->getGroupSize() / laneCount, 1);
+            const size_t batchCount = (blockCount + blocksPerBatch - 1) / blocksPerBatch;
+
+            std::atomic<size_t> nextBatch{0};
+            std::mutex          errorMutex{};
+            std::exception_ptr  error{};
+
+            auto worker = [&]() {
+                try {
+                    BlockBuffers buffers{kernel.laneCount, pointCount};
+
+                    VibwaLaneBlock<FP> block = blockTemplate;
+                    block.factors            = buffers.factors.data();
+                    block.lowerBounds        = buffers.lowerBounds.data();
+                    block.upperBounds        = buffers.upperBounds.data();
+                    block.levels             = buffers.levels.data();
+
+                    for (size_t batch = nextBatch.fetch_add(1, std::memory_order_relaxed);
+                         batch < batchCount && !stop_requested.load(std::memory_order_relaxed);
+                         batch = nextBatch.fetch_add(1, std::memory_order_relaxed)) {
+                        const size_t lastBlock =
+                            std::min((batch + 1) * blocksPerBatch, blockCount);
+
+                        for (size_t index = batch * blocksPerBatch; index < lastBlock; ++index) {
+                            prepareBlock(
+                                handle,
+                                potentials,
+                                *algorithmConfig,
+                                index * laneCount,
+                                blockTemplate.scale,
+                                buffers
+                            );
+                            kernel.solve(block);
+                        }
+                    }
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock{errorMutex};
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                    // Make other workers run out of batches.
+                    nextBatch.store(batchCount, std::memory_order_relaxed);
+                }
+            };
+
+            const size_t threadCount =
+                std::min<size_t>(handle->getComputeContext().getThreadCount(), batchCount);
+
+            std::vector<std::thread> threads{};
+            threads.reserve(threadCount - 1);
+            try {
+                for (size_t i = 1; i < threadCount; ++i) {
+                    threads.emplace_back(worker);
+                }
+            } catch (const std::system_error&) {
+                // Not being able to spawn all threads is not fatal, batches are distributed
+                // dynamically, so remaining threads will process all of them.
+            }
+            // Calling thread takes part in computations too.
+            worker();
+
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+      private: /* Private methods. */
+        /* Potentials in buffer always have same point count, only its range is checked. */
+        static void validatePotentials(
+            const PotentialView<FP>& potentials, const HardwareConfig<FP>& hardwareConfig
+        ) {
+            if (potentials.empty()) {
+                return;
+            }
+            const size_t pointCount = potentials.getPointCount();
+
+            if (pointCount > hardwareConfig.getPotentialBufferSize()) {
+                throw std::runtime_error(fmt::format(
+                    "Potential point count ({}) exceeds potential buffer size ({}).",
+                    pointCount,
+                    hardwareConfig.getPotentialBufferSize()
+                ));
+            }
+            if (pointCount < minPointCount) {
+                throw std::runtime_error(fmt::format(
+                    "Potential must have at least {} points, got {}.", minPointCount, pointCount
+                ));
+            }
+        }
+
+        /* hbar^2 / 2 mu in cm^-1 Angstrom^2, with atom masses given in u. */
+        static FP getReducedMassFactor(const VibwaAlgorithmConfig<FP>& config) {
+            const FP reducedMass = (config.getMassAtom0() * config.getMassAtom1()) /
+                                   (config.getMassAtom0() + config.getMassAtom1());
+            return kineticEnergyFactor / reducedMass;
+        }
+
+        /* Interleave potentials starting from firstPotential into lanes of buffers. */
+        static void prepareBlock(
+            TaskHandle<FP>*                 handle,
+            const PotentialView<FP>&        potentials,
+            const VibwaAlgorithmConfig<FP>& config,
+            size_t                          firstPotential,
+            FP                              scale,
+            BlockBuffers&                   buffers
+        ) {
+            const size_t laneCount  = buffers.levels.size();
+            const size_t pointCount = potentials.getPointCount();
+
+            for (size_t lane = 0; lane < laneCount; ++lane) {
+                const size_t potentialIndex = firstPotential + lane;
+                const bool   isPadding      = potentialIndex >= potentials.size();
+                const auto   potential =
+                    potentials[isPadding ? potentials.size() - 1 : potentialIndex];
+
+                buffers.levels[lane] =
+                    isPadding ? nullptr : handle->getPotentialLevelEnergies(potentialIndex);
+                buffers.lowerBounds[lane] = *std::min_element(potential.begin(), potential.end());
+                buffers.upperBounds[lane] =
+                    potential[pointCount - 1] - config.getMinDistanceToAsymptote();
+
+                for (size_t i = 0; i < pointCount; ++i) {
+                    buffers.factors[i * laneCount + lane] = scale * potential[i];
+                }
+            }
+        }
+    };
+
+} // namespace epseon::cpu::cpp
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "epseon_cpu/predecl.hpp"
+
+#include "epseon/task_configurator/task_configurator.hpp"
+#include "epseon_cpu/enums.hpp"
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+namespace epseon::cpu::cpp {
+
+    /* Entry point for running algorithms on CPU, counterpart of GPU ComputeDeviceInterface.
+     * Holds number of worker threads used by tasks and instruction set of SIMD kernels.
+     */
+    class ComputeContext : public std::enable_shared_from_this<ComputeContext> {
+      private: /* Private members. */
+        uint32_t       thread_count    = {};
+        InstructionSet instruction_set = InstructionSet::Scalar;
+
+      public: /* Public constructors. */
+        ComputeContext(uint32_t thread_count_, InstructionSet instruction_set_);
+
+      public: /* Public destructor. */
+        virtual ~ComputeContext() = default;
+
+      public: /* Public factory methods. */
+        /* Create context using most capable instruction set supported by host CPU. Thread
+         * count equal to 0 means one thread per hardware thread. */
+        static std::shared_ptr<ComputeContext> create(uint32_t thread_count = 0);
+
+        /* Create context using given instruction set, raises std::runtime_error if it is
+         * not supported, see isInstructionSetSupported(). */
+        static std::shared_ptr<ComputeContext>
+        create(uint32_t thread_count, InstructionSet instruction_set);
+
+      public: /* Public methods. */
+        template <typename FP>
+        std::shared_ptr<TaskConfigurator<FP>> getTaskConfigurator() {
+            return std::make_shared<TaskConfigurator<FP>>();
+        }
+
+        template <typename FP>
+        // Namespaces specified explicitly to avoid confusion.
+        std::shared_ptr<epseon::cpu::cpp::TaskHandle<FP>>
+        submitTask(std::shared_ptr<TaskConfigurator<FP>> task_config) {
+            if (!task_config->isConfigured()) {
+                throw std::runtime_error("TaskConfigurator wasn't fully configured before "
+                                         "submitting for execution.");
+            }
+            return std::make_shared<TaskHandle<FP>>(this->shared_from_this(), task_config);
+        }
+
+      public: /* Public getters. */
+        [[nodiscard]] uint32_t getThreadCount() const {
+            return this->thread_count;
+        }
+
+        [[nodiscard]] InstructionSet getInstructionSet() const {
+            return this->instruction_set;
+        }
+    };
+} // namespace epseon::cpu::cpp
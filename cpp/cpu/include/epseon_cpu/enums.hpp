@@ -0,0 +1,54 @@
+#pragma once
+
+#include "epseon/libepseon.hpp"
+
+#include "epseon_cpu/predecl.hpp"
+
+#include "epseon/enums.hpp"
+
+#include <cassert>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#define InstructionSetAssertValueCount(count)                           \
+    static_assert(                                                      \
+        static_cast<int>(epseon::cpu::cpp::InstructionSet::_Last) == 3, \
+        "The number of InstructionSets has changed."                    \
+    );
+
+namespace epseon::cpu::cpp {
+
+    // Brought in next to toString(InstructionSet), it would hide shared overloads
+    // otherwise.
+    using epseon::cpp::toString;
+
+    /* SIMD instruction sets VIBWA kernels are available for, ordered from the least to the
+     * most capable one. */
+    enum class InstructionSet {
+        Scalar,
+        AVX2,
+        AVX512,
+        // If it is necessary to add new value, add it here, before _Last.
+        _Last // Marker for last enum value.
+    };
+
+    class InvalidInstructionSetString : public std::exception {
+      private:
+        std::string message;
+
+      public:
+        InvalidInstructionSetString(std::string_view);
+        const char* what() const noexcept override;
+    };
+
+    std::string    toString(InstructionSet);
+    InstructionSet toInstructionSet(std::string_view isa);
+
+    /* Check if kernel for instruction set was compiled into library and host CPU supports
+     * that instruction set. */
+    bool           isInstructionSetSupported(InstructionSet);
+    /* Most capable instruction set which is supported, see isInstructionSetSupported(). */
+    InstructionSet getBestInstructionSet();
+} // namespace epseon::cpu::cpp
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "epseon/predecl.hpp"
+
+namespace epseon::cpu {
+    namespace cpp {
+
+        // Task configuration and potential sources are shared with GPU backend.
+        using namespace epseon::cpp;
+
+        template <typename FP>
+        class Algorithm;
+
+        template <typename FP>
+        class VibwaAlgorithm;
+
+        template <typename FP>
+        class TaskHandle;
+
+        class ComputeContext;
+
+    } // namespace cpp
+
+    namespace python {
+        template <typename FP>
+        class TaskHandle;
+
+        class MorsePotentialConfig;
+
+        template <typename FP>
+        class TaskConfigurator;
+
+        class EpseonComputeContext;
+    } // namespace python
+} // namespace epseon::cpu
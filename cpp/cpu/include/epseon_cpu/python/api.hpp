@@ -0,0 +1,276 @@
+#pragma once
+
+#include "epseon_cpu/predecl.hpp"
+
+#include "epseon/task_configurator/algorithm_config.hpp"
+#include "epseon/task_configurator/hardware_config.hpp"
+#include "epseon/task_configurator/potential_source.hpp"
+#include "epseon/task_configurator/task_configurator.hpp"
+#include "epseon_cpu/compute_context.hpp"
+#include "epseon_cpu/enums.hpp"
+#include "epseon_cpu/task_handle.hpp"
+#include "fmt/format.h"
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace epseon {
+    namespace cpu {
+        namespace python {
+
+            template <typename FP>
+            class TaskHandle {
+              private: /* Private members. */
+                std::shared_ptr<cpp::TaskHandle<FP>> handle = {};
+
+              public: /* Public constructors. */
+                TaskHandle(std::shared_ptr<cpp::TaskHandle<FP>> handle_) :
+                    handle(handle_) {
+                    if (!this->handle->isRunning())
+                        this->handle->startWorker();
+                }
+
+              public: /* Public methods. */
+                /* Python API - Check if underlying worker thread finished its work. */
+                bool is_done() {
+                    return handle->isDone();
+                }
+
+                /* Python API - Check if task is still running. */
+                bool is_running() {
+                    return handle->isRunning();
+                }
+
+                /* Python API - Cancel running task - will not result in immediate
+                 * interrupt, worker threads finish batches they are processing first.
+                 */
+                bool cancel() {
+                    return handle->cancel();
+                };
+
+                /* Python API - Wait for worker thread to finish.
+                 */
+                void wait() {
+                    handle->wait();
+                }
+
+                /* Python API - Get energies of vibrational levels, one list per potential.
+                 * Levels which were not found are NaN. Raises if task has not finished
+                 * yet or if it failed.
+                 */
+                std::vector<std::vector<FP>> get_results() {
+                    const auto& level_energies = handle->getLevelEnergies();
+                    const auto  level_count    = handle->getLevelCount();
+
+                    std::vector<std::vector<FP>> results{};
+                    results.reserve(handle->getPotentialCount());
+
+                    for (auto begin = level_energies.begin(); begin != level_energies.end();
+                         begin += level_count) {
+                        results.emplace_back(begin, begin + level_count);
+                    }
+                    return results;
+                }
+            };
+
+            template class TaskHandle<float>;
+            template class TaskHandle<double>;
+
+            typedef TaskHandle<float>  TaskHandleFloat32;
+            typedef TaskHandle<double> TaskHandleFloat64;
+
+            typedef std::variant<TaskHandleFloat32, TaskHandleFloat64> TaskHandleVariant;
+
+            class MorsePotentialConfig {
+              private:
+                cpp::MorsePotentialConfig<double> configuration;
+
+              public: /* Public constructors. */
+                // Member-wise constructor.
+                MorsePotentialConfig(cpp::MorsePotentialConfig<double>&& configuration) :
+                    configuration(configuration) {}
+
+                // Default constructor.
+                MorsePotentialConfig() = default;
+
+                // Copy constructor.
+                MorsePotentialConfig(const MorsePotentialConfig&) = default;
+
+                // Copy assignment operator.
+                MorsePotentialConfig& operator=(const MorsePotentialConfig&) = default;
+
+                // Move constructor.
+                MorsePotentialConfig(MorsePotentialConfig&&) noexcept = default;
+
+                // Move assignment operator.
+                MorsePotentialConfig& operator=(MorsePotentialConfig&&) noexcept = default;
+
+              public: /* Public methods. */
+                static MorsePotentialConfig create(
+                    double   dissociation_energy_,
+                    double   equilibrium_bond_distance_,
+                    double   well_width_,
+                    double   min_r_,
+                    double   max_r_,
+                    uint32_t point_count_
+                );
+
+              public: /* Public methods. */
+                const cpp::MorsePotentialConfig<double>& getConfiguration() const;
+            };
+
+            /* Python API - Wrapper class around TaskConfigurator class. */
+            template <typename FP>
+            class TaskConfigurator {
+              private:
+                std::shared_ptr<cpp::TaskConfigurator<FP>> configurator = {};
+
+              public:
+                TaskConfigurator(std::shared_ptr<cpp::TaskConfigurator<FP>> configurator_) :
+                    configurator(configurator_) {}
+
+              public: /* Public methods. */
+                /* Python API - Set hardware configuration for a CPU compute task. */
+                TaskConfigurator& set_hardware_config(
+                    uint32_t potential_buffer_size,
+                    uint32_t group_size,
+                    uint32_t allocation_block_size
+                ) {
+                    this->configurator->setHardwareConfig(std::make_shared<cpp::HardwareConfig<FP>>(
+                        potential_buffer_size, group_size, allocation_block_size
+                    ));
+                    return *this;
+                };
+
+                /* Python API - Set potential data source configuration for CPU
+                 * compute task. */
+                TaskConfigurator&
+                set_morse_potential(const std::vector<MorsePotentialConfig>& configurations) {
+                    // Track used point count, all configs should have the same for now.
+                    std::optional<uint32_t>                    point_count = std::nullopt;
+                    std::vector<cpp::MorsePotentialConfig<FP>> configurations_cpp{};
+                    configurations_cpp.reserve(configurations.size());
+
+                    for (const auto& element : configurations) {
+                        const auto& configuration = element.getConfiguration();
+                        auto current_element_point_count = configuration.getPointCount();
+
+                        if (point_count.has_value() &&
+                            point_count.value() != current_element_point_count) {
+                            throw std::runtime_error(fmt::format(
+                                "All Morse potentials must have same point "
+                                "count, but previous ones had {} and current one "
+                                "has {}.",
+                                point_count.value(),
+                                current_element_point_count
+                            ));
+                        } else {
+                            point_count = {current_element_point_count};
+                        }
+                        configurations_cpp.emplace_back(
+                            static_cast<FP>(configuration.getDissociationEnergy()),
+                            static_cast<FP>(configuration.getEquilibriumBondDistance()),
+                            static_cast<FP>(configuration.getWellWidth()),
+                            static_cast<FP>(configuration.getMinR()),
+                            static_cast<FP>(configuration.getMaxR()),
+                            current_element_point_count
+                        );
+                    }
+                    this->configurator->setPotentialSource(
+                        std::make_shared<cpp::MorsePotentialGenerator<FP>>(
+                            std::move(configurations_cpp)
+                        )
+                    );
+                    return *this;
+                }
+
+                /* Python API - Set algorithm configuration for a CPU compute task.
+                 */
+                TaskConfigurator& set_vibwa_algorithm(
+                    double   mass_atom_0,
+                    double   mass_atom_1,
+                    double   integration_step,
+                    double   min_distance_to_asymptote,
+                    uint32_t min_level,
+                    uint32_t max_level
+                ) {
+                    this->configurator->setAlgorithmConfig(
+                        std::make_shared<cpp::VibwaAlgorithmConfig<FP>>(
+                            static_cast<FP>(mass_atom_0),
+                            static_cast<FP>(mass_atom_1),
+                            static_cast<FP>(integration_step),
+                            static_cast<FP>(min_distance_to_asymptote),
+                            min_level,
+                            max_level
+                        )
+                    );
+                    return *this;
+                }
+
+                /* Python API - Check if this instance is fully configured, i.e. it
+                 * has been assigned a valid hardware configuration, potential
+                 * source and algorithm config.
+                 */
+                bool is_configured() const {
+                    return this->configurator->isConfigured();
+                }
+
+                std::shared_ptr<cpp::TaskConfigurator<FP>> getTaskConfigurator() const {
+                    return this->configurator;
+                }
+            };
+
+            template class TaskConfigurator<float>;
+            template class TaskConfigurator<double>;
+
+            typedef TaskConfigurator<float>  TaskConfiguratorFloat32;
+            typedef TaskConfigurator<double> TaskConfiguratorFloat64;
+
+            typedef std::variant<TaskConfiguratorFloat32, TaskConfiguratorFloat64>
+                TaskConfiguratorVariant;
+
+            class EpseonComputeContext {
+              private:
+                std::shared_ptr<cpp::ComputeContext> context = {};
+
+              public:
+                EpseonComputeContext(std::shared_ptr<cpp::ComputeContext>);
+
+                /* Python API - Create context, thread count equal to 0 means one thread
+                 * per hardware thread, instruction set defaults to best supported one. */
+                static EpseonComputeContext
+                create(uint32_t thread_count, std::optional<std::string> instruction_set);
+
+                /* Python API - Name of instruction set used by VIBWA kernels. */
+                std::string get_instruction_set() const;
+                /* Python API - Number of worker threads used by tasks. */
+                uint32_t    get_thread_count() const;
+
+                /* Python API - Get builder instance for configuring CPU compute task.
+                 */
+                TaskConfiguratorVariant get_task_configurator(std::string);
+
+                /* Python API - Submit task for execution. Will raise RuntimeError upon
+                 * receiving not fully configured TaskConfigurator. */
+                template <typename FP>
+                TaskHandleVariant submit_task(const TaskConfigurator<FP>& task_config) {
+                    if (!task_config.is_configured()) {
+                        throw std::runtime_error("TaskConfigurator submitted for execution "
+                                                 "before fully configured.");
+                    }
+                    auto config      = task_config.getTaskConfigurator();
+                    auto task_handle = this->context->submitTask(config);
+
+                    return TaskHandleVariant{// Namespaces specified explicitly to avoid confusion.
+                                             epseon::cpu::python::TaskHandle<FP>{task_handle}
+                    };
+                }
+            };
+        } // namespace python
+    }     // namespace cpu
+} // namespace epseon
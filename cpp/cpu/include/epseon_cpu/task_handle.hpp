@@ -0,0 +1,218 @@
+#pragma once
+
+#include "epseon/libepseon.hpp"
+
+#include "epseon_cpu/predecl.hpp"
+
+#include "epseon/task_configurator/task_configurator.hpp"
+#include "epseon_cpu/algorithms/algorithm.hpp"
+#include "epseon_cpu/algorithms/vibwa.hpp"
+#include "epseon_cpu/compute_context.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace epseon::cpu::cpp {
+
+    template <typename FP>
+    class TaskHandle : public std::enable_shared_from_this<TaskHandle<FP>> {
+      private:
+        std::shared_ptr<ComputeContext>       context           = {};
+        std::shared_ptr<TaskConfigurator<FP>> config            = {};
+        std::atomic<bool>                     is_worker_done    = false;
+        std::atomic<bool>                     is_worker_started = false;
+        std::atomic<bool>                     stop_requested    = false;
+        std::thread                           worker            = {};
+        // Written only by worker threads, read only after is_worker_done is set.
+        std::vector<FP>                       level_energies    = {};
+        uint32_t                              level_count       = {};
+        std::exception_ptr                    worker_error      = {};
+
+      public: /* Public constructors. */
+        TaskHandle(
+            std::shared_ptr<ComputeContext> context_, std::shared_ptr<TaskConfigurator<FP>> config_
+        ) :
+            context(context_),
+            config(config_),
+            is_worker_done(false),
+            is_worker_started(false),
+            stop_requested(false),
+            worker() {
+            /* We can't start worker in constructor as it takes a pointer to this handle
+             * object, which must stay alive for the whole time worker is running.
+             * Therefore startWorker() must be called afterwards.
+             */
+        }
+
+        // Copy constructor.
+        TaskHandle(const TaskHandle&) = delete;
+
+        // Copy assignment operator.
+        TaskHandle& operator=(const TaskHandle&) = delete;
+
+        // Move constructor.
+        TaskHandle(TaskHandle&&) noexcept = delete;
+
+        // Move assignment operator.
+        TaskHandle& operator=(TaskHandle&&) noexcept = delete;
+
+      public: /* Public destructor. */
+        ~TaskHandle() {
+            // Unlike std::jthread used by GPU backend, std::thread must be joined
+            // explicitly before destruction.
+            this->cancel();
+            if (this->worker.joinable()) {
+                this->worker.join();
+            }
+        }
+
+      protected: /* Protected methods. */
+        void setDoneFlag() {
+            // See GPU TaskHandle for explanation why std::memory_order_release is
+            // used here.
+            this->is_worker_done.store(true, std::memory_order_release);
+        }
+
+        void setStartedFlag() {
+            this->is_worker_started.store(true, std::memory_order_release);
+        }
+
+        void setNotDoneFlag() {
+            this->is_worker_done.store(false, std::memory_order_release);
+        }
+
+        void setNotStartedFlag() {
+            this->is_worker_started.store(false, std::memory_order_release);
+        }
+
+        /* Allocate space for results, level energies are initialized with NaN. */
+        void allocateResults(size_t potential_count, uint32_t level_count_) {
+            this->level_count = level_count_;
+            this->level_energies.assign(
+                potential_count * level_count_, std::numeric_limits<FP>::quiet_NaN()
+            );
+        }
+
+        /* Get pointer to getLevelCount() results belonging to single potential. */
+        FP* getPotentialLevelEnergies(size_t potential_index) {
+            LIB_EPSEON_ASSERT_TRUE((potential_index + 1) * level_count <= level_energies.size());
+            return level_energies.data() + (potential_index * level_count);
+        }
+
+        void checkResultsAvailable() const {
+            if (!this->isDone()) {
+                throw std::runtime_error("Task results are not available until task finishes.");
+            }
+            if (this->worker_error) {
+                std::rethrow_exception(this->worker_error);
+            }
+        }
+
+        friend VibwaAlgorithm<FP>;
+
+      public: /* Public methods. */
+        /* Create and start underlying worker thread.*/
+        void startWorker() {
+            if (this->isRunning()) {
+                throw std::runtime_error("One worker is already running, can't start another one.");
+            }
+            if (this->worker.joinable()) {
+                this->worker.join();
+            }
+            this->setNotDoneFlag();
+            this->setStartedFlag();
+            this->stop_requested.store(false, std::memory_order_relaxed);
+            this->worker = std::thread(this->run, this);
+        }
+
+        /* Code run withing worker thread. */
+        void static run(TaskHandle<FP>* this_ptr) {
+            // Exception escaping std::thread would terminate whole process, it is stored
+            // and rethrown when results are requested instead.
+            try {
+                const auto config         = this_ptr->config->getAlgorithmConfig();
+                const auto implementation = Algorithm<FP>::create(*config);
+                implementation->run(this_ptr->stop_requested, this_ptr);
+            } catch (...) {
+                this_ptr->worker_error = std::current_exception();
+            }
+            this_ptr->setDoneFlag();
+            this_ptr->setNotStartedFlag();
+        }
+
+        /* Check if underlying worker thread finished its work.
+         * This doesn't check if thread even started, it will be false both if
+         * it is currently running and if it was never started. Use is_running()
+         * to clarify which of those is the case.
+         */
+        [[nodiscard]] bool isDone() const {
+            return is_worker_done.load(std::memory_order_acquire);
+        }
+
+        /* Check if underlying worker thread was ever started. */
+        [[nodiscard]] bool isStarted() const {
+            return is_worker_started.load(std::memory_order_acquire);
+        }
+
+        /* Check if underlying worker thread is currently running. */
+        [[nodiscard]] bool isRunning() const {
+            return isStarted() && !isDone();
+        }
+
+        /* Request worker to stop, it will finish batches it is currently processing.
+         * Levels of potentials which weren't processed stay NaN.
+         */
+        bool cancel() {
+            if (this->isRunning()) {
+                return !this->stop_requested.exchange(true, std::memory_order_relaxed);
+            }
+            return false;
+        }
+
+        void wait() {
+            if (this->worker.joinable()) {
+                this->worker.join();
+            }
+        }
+
+      public: /* Public getters. */
+        const TaskConfigurator<FP>& getTaskConfigurator() const {
+            return *this->config;
+        }
+
+        const ComputeContext& getComputeContext() const {
+            return *this->context;
+        }
+
+        /* Energies of vibrational levels, getLevelCount() consecutive values for each
+         * potential, in order of potentials from potential source. Levels which were not
+         * found are NaN. Rethrows exception raised by worker thread, if any.
+         */
+        [[nodiscard]] const std::vector<FP>& getLevelEnergies() const {
+            this->checkResultsAvailable();
+            return this->level_energies;
+        }
+
+        /* Number of levels computed for each potential. */
+        [[nodiscard]] uint32_t getLevelCount() const {
+            this->checkResultsAvailable();
+            return this->level_count;
+        }
+
+        /* Number of potentials for which levels were computed. */
+        [[nodiscard]] size_t getPotentialCount() const {
+            this->checkResultsAvailable();
+            return this->level_count == 0 ? 0 : this->level_energies.size() / this->level_count;
+        }
+    };
+
+    template class TaskHandle<float>;
+    template class TaskHandle<double>;
+
+} // namespace epseon::cpu::cpp
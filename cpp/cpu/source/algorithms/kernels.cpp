@@ -0,0 +1,63 @@
+#include "epseon_cpu/algorithms/kernels.hpp"
+#include "epseon_cpu/enums.hpp"
+#include "fmt/format.h"
+#include <stdexcept>
+
+namespace epseon {
+    namespace cpu {
+        namespace cpp {
+
+            namespace {
+                void checkInstructionSetSupported(InstructionSet isa) {
+                    if (!isInstructionSetSupported(isa)) {
+                        throw std::runtime_error(fmt::format(
+                            "VIBWA kernel for instruction set {} is not available.", toString(isa)
+                        ));
+                    }
+                }
+            } // namespace
+
+            template <>
+            VibwaKernel<float> getVibwaKernel<float>(InstructionSet isa) {
+                checkInstructionSetSupported(isa);
+
+                InstructionSetAssertValueCount(3);
+                switch (isa) {
+#if EPSEON_CPU_AVX512_KERNEL
+                    case InstructionSet::AVX512:
+                        return kernels::getAvx512VibwaKernelFloat32();
+#endif
+#if EPSEON_CPU_AVX2_KERNEL
+                    case InstructionSet::AVX2:
+                        return kernels::getAvx2VibwaKernelFloat32();
+#endif
+                    case InstructionSet::Scalar:
+                        return kernels::getScalarVibwaKernelFloat32();
+                    default:
+                        throw std::runtime_error("Unreachable");
+                }
+            }
+
+            template <>
+            VibwaKernel<double> getVibwaKernel<double>(InstructionSet isa) {
+                checkInstructionSetSupported(isa);
+
+                InstructionSetAssertValueCount(3);
+                switch (isa) {
+#if EPSEON_CPU_AVX512_KERNEL
+                    case InstructionSet::AVX512:
+                        return kernels::getAvx512VibwaKernelFloat64();
+#endif
+#if EPSEON_CPU_AVX2_KERNEL
+                    case InstructionSet::AVX2:
+                        return kernels::getAvx2VibwaKernelFloat64();
+#endif
+                    case InstructionSet::Scalar:
+                        return kernels::getScalarVibwaKernelFloat64();
+                    default:
+                        throw std::runtime_error("Unreachable");
+                }
+            }
+        } // namespace cpp
+    }     // namespace cpu
+} // namespace epseon
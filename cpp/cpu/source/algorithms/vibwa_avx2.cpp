@@ -0,0 +1,173 @@
+#include "vibwa_kernel.hpp"
+
+#include "epseon_cpu/algorithms/kernels.hpp"
+
+#if EPSEON_CPU_AVX2_KERNEL
+
+    // This translation unit is compiled with AVX2 and FMA enabled (see CMakeLists.txt),
+    // kernels are called only after runtime check of host CPU capabilities.
+    #include <immintrin.h>
+
+namespace epseon {
+    namespace cpu {
+        namespace cpp {
+            namespace kernels {
+                namespace {
+                    struct Avx2Float32Traits {
+                        using FP = float;
+                        using V  = __m256;
+                        using M  = __m256;
+
+                        static constexpr uint32_t width = 8;
+
+                        static V set1(FP value) {
+                            return _mm256_set1_ps(value);
+                        }
+
+                        static V load(const FP* source) {
+                            return _mm256_loadu_ps(source);
+                        }
+
+                        static void store(FP* destination, V value) {
+                            _mm256_storeu_ps(destination, value);
+                        }
+
+                        static V add(V a, V b) {
+                            return _mm256_add_ps(a, b);
+                        }
+
+                        static V sub(V a, V b) {
+                            return _mm256_sub_ps(a, b);
+                        }
+
+                        static V mul(V a, V b) {
+                            return _mm256_mul_ps(a, b);
+                        }
+
+                        static V div(V a, V b) {
+                            return _mm256_div_ps(a, b);
+                        }
+
+                        static V abs(V a) {
+                            return _mm256_andnot_ps(_mm256_set1_ps(-0.0F), a);
+                        }
+
+                        static M lt(V a, V b) {
+                            return _mm256_cmp_ps(a, b, _CMP_LT_OQ);
+                        }
+
+                        static M le(V a, V b) {
+                            return _mm256_cmp_ps(a, b, _CMP_LE_OQ);
+                        }
+
+                        static M gt(V a, V b) {
+                            return _mm256_cmp_ps(a, b, _CMP_GT_OQ);
+                        }
+
+                        static M ge(V a, V b) {
+                            return _mm256_cmp_ps(a, b, _CMP_GE_OQ);
+                        }
+
+                        static M maskAnd(M a, M b) {
+                            return _mm256_and_ps(a, b);
+                        }
+
+                        static M maskAndNot(M a, M b) {
+                            return _mm256_andnot_ps(b, a);
+                        }
+
+                        static V select(M mask, V a, V b) {
+                            return _mm256_blendv_ps(b, a, mask);
+                        }
+
+                        static bool any(M mask) {
+                            return _mm256_movemask_ps(mask) != 0;
+                        }
+                    };
+
+                    struct Avx2Float64Traits {
+                        using FP = double;
+                        using V  = __m256d;
+                        using M  = __m256d;
+
+                        static constexpr uint32_t width = 4;
+
+                        static V set1(FP value) {
+                            return _mm256_set1_pd(value);
+                        }
+
+                        static V load(const FP* source) {
+                            return _mm256_loadu_pd(source);
+                        }
+
+                        static void store(FP* destination, V value) {
+                            _mm256_storeu_pd(destination, value);
+                        }
+
+                        static V add(V a, V b) {
+                            return _mm256_add_pd(a, b);
+                        }
+
+                        static V sub(V a, V b) {
+                            return _mm256_sub_pd(a, b);
+                        }
+
+                        static V mul(V a, V b) {
+                            return _mm256_mul_pd(a, b);
+                        }
+
+                        static V div(V a, V b) {
+                            return _mm256_div_pd(a, b);
+                        }
+
+                        static V abs(V a) {
+                            return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a);
+                        }
+
+                        static M lt(V a, V b) {
+                            return _mm256_cmp_pd(a, b, _CMP_LT_OQ);
+                        }
+
+                        static M le(V a, V b) {
+                            return _mm256_cmp_pd(a, b, _CMP_LE_OQ);
+                        }
+
+                        static M gt(V a, V b) {
+                            return _mm256_cmp_pd(a, b, _CMP_GT_OQ);
+                        }
+
+                        static M ge(V a, V b) {
+                            return _mm256_cmp_pd(a, b, _CMP_GE_OQ);
+                        }
+
+                        static M maskAnd(M a, M b) {
+                            return _mm256_and_pd(a, b);
+                        }
+
+                        static M maskAndNot(M a, M b) {
+                            return _mm256_andnot_pd(b, a);
+                        }
+
+                        static V select(M mask, V a, V b) {
+                            return _mm256_blendv_pd(b, a, mask);
+                        }
+
+                        static bool any(M mask) {
+                            return _mm256_movemask_pd(mask) != 0;
+                        }
+                    };
+                } // namespace
+
+                VibwaKernel<float> getAvx2VibwaKernelFloat32() {
+                    return makeVibwaKernel<Avx2Float32Traits>(InstructionSet::AVX2);
+                }
+
+                VibwaKernel<double> getAvx2VibwaKernelFloat64() {
+                    return makeVibwaKernel<Avx2Float64Traits>(InstructionSet::AVX2);
+                }
+            } // namespace kernels
+        }     // namespace cpp
+    }         // namespace cpu
+} // namespace epseon
+
+#endif
@@ -0,0 +1,173 @@
+#include "vibwa_kernel.hpp"
+
+#include "epseon_cpu/algorithms/kernels.hpp"
+
+#if EPSEON_CPU_AVX512_KERNEL
+
+    // This translation unit is compiled with AVX-512F enabled (see CMakeLists.txt),
+    // kernels are called only after runtime check of host CPU capabilities.
+    #include <immintrin.h>
+
+namespace epseon {
+    namespace cpu {
+        namespace cpp {
+            namespace kernels {
+                namespace {
+                    struct Avx512Float32Traits {
+                        using FP = float;
+                        using V  = __m512;
+                        using M  = __mmask16;
+
+                        static constexpr uint32_t width = 16;
+
+                        static V set1(FP value) {
+                            return _mm512_set1_ps(value);
+                        }
+
+                        static V load(const FP* source) {
+                            return _mm512_loadu_ps(source);
+                        }
+
+                        static void store(FP* destination, V value) {
+                            _mm512_storeu_ps(destination, value);
+                        }
+
+                        static V add(V a, V b) {
+                            return _mm512_add_ps(a, b);
+                        }
+
+                        static V sub(V a, V b) {
+                            return _mm512_sub_ps(a, b);
+                        }
+
+                        static V mul(V a, V b) {
+                            return _mm512_mul_ps(a, b);
+                        }
+
+                        static V div(V a, V b) {
+                            return _mm512_div_ps(a, b);
+                        }
+
+                        static V abs(V a) {
+                            return _mm512_abs_ps(a);
+                        }
+
+                        static M lt(V a, V b) {
+                            return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ);
+                        }
+
+                        static M le(V a, V b) {
+                            return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ);
+                        }
+
+                        static M gt(V a, V b) {
+                            return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ);
+                        }
+
+                        static M ge(V a, V b) {
+                            return _mm512_cmp_ps_mask(a, b, _CMP_GE_OQ);
+                        }
+
+                        static M maskAnd(M a, M b) {
+                            return static_cast<M>(a & b);
+                        }
+
+                        static M maskAndNot(M a, M b) {
+                            return static_cast<M>(a & ~b);
+                        }
+
+                        static V select(M mask, V a, V b) {
+                            return _mm512_mask_blend_ps(mask, b, a);
+                        }
+
+                        static bool any(M mask) {
+                            return mask != 0;
+                        }
+                    };
+
+                    struct Avx512Float64Traits {
+                        using FP = double;
+                        using V  = __m512d;
+                        using M  = __mmask8;
+
+                        static constexpr uint32_t width = 8;
+
+                        static V set1(FP value) {
+                            return _mm512_set1_pd(value);
+                        }
+
+                        static V load(const FP* source) {
+                            return _mm512_loadu_pd(source);
+                        }
+
+                        static void store(FP* destination, V value) {
+                            _mm512_storeu_pd(destination, value);
+                        }
+
+                        static V add(V a, V b) {
+                            return _mm512_add_pd(a, b);
+                        }
+
+                        static V sub(V a, V b) {
+                            return _mm512_sub_pd(a, b);
+                        }
+
+                        static V mul(V a, V b) {
+                            return _mm512_mul_pd(a, b);
+                        }
+
+                        static V div(V a, V b) {
+                            return _mm512_div_pd(a, b);
+                        }
+
+                        static V abs(V a) {
+                            return _mm512_abs_pd(a);
+                        }
+
+                        static M lt(V a, V b) {
+                            return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ);
+                        }
+
+                        static M le(V a, V b) {
+                            return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ);
+                        }
+
+                        static M gt(V a, V b) {
+                            return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ);
+                        }
+
+                        static M ge(V a, V b) {
+                            return _mm512_cmp_pd_mask(a, b, _CMP_GE_OQ);
+                        }
+
+                        static M maskAnd(M a, M b) {
+                            return static_cast<M>(a & b);
+                        }
+
+                        static M maskAndNot(M a, M b) {
+                            return static_cast<M>(a & ~b);
+                        }
+
+                        static V select(M mask, V a, V b) {
+                            return _mm512_mask_blend_pd(mask, b, a);
+                        }
+
+                        static bool any(M mask) {
+                            return mask != 0;
+                        }
+                    };
+                } // namespace
+
+                VibwaKernel<float> getAvx512VibwaKernelFloat32() {
+                    return makeVibwaKernel<Avx512Float32Traits>(InstructionSet::AVX512);
+                }
+
+                VibwaKernel<double> getAvx512VibwaKernelFloat64() {
+                    return makeVibwaKernel<Avx512Float64Traits>(InstructionSet::AVX512);
+                }
+            } // namespace kernels
+        }     // namespace cpp
+    }         // namespace cpu
+} // namespace epseon
+
+#endif
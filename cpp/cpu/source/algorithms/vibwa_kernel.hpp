@@ -0,0 +1,237 @@
+#pragma once
+
+#include "epseon/libepseon.hpp"
+
+#include "epseon_cpu/algorithms/kernels.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+/* VIBWA kernel shared by all instruction sets - CPU port of cpp/gpu/shaders/vibwa.comp,
+ * see there for description of the method. Here potentials are spread over SIMD lanes
+ * instead of workgroups and lanes of one block search for the same level at once.
+ *
+ * Instruction set is abstracted by traits class S, which provides:
+ *  - FP, V (vector of FP), M (lane mask) types and width (lane count),
+ *  - set1, load, store, add, sub, mul, div, abs,
+ *  - lt, le, gt, ge comparisons returning M,
+ *  - maskAnd, maskAndNot (a & ~b), select (mask ? a : b) and any.
+ *
+ * This header is included only by kernel translation units, which are compiled with
+ * different instruction set flags. Everything is kept in anonymous namespace and calls
+ * to non-constexpr functions from other headers are avoided, so that linker can't pick
+ * e.g. AVX-512 version of inline function for scalar kernel.
+ */
+
+namespace epseon::cpu::cpp::kernels {
+    namespace {
+
+        template <typename FP>
+        constexpr uint32_t bisectionIterations = std::is_same<FP, double>::value ? 20 : 16;
+
+        constexpr uint32_t cooleyIterations = 8;
+
+        template <typename S>
+        class VibwaLaneSolver {
+            using FP = typename S::FP;
+            using V  = typename S::V;
+            using M  = typename S::M;
+
+            static constexpr uint32_t width = S::width;
+            static constexpr FP       nan   = std::numeric_limits<FP>::quiet_NaN();
+            // Relative tolerance at which Cooley iterations stop.
+            static constexpr FP       epsilon = std::numeric_limits<FP>::epsilon();
+
+          private: /* Private members. */
+            const VibwaLaneBlock<FP>& block;
+            const V                   scale;
+
+          public: /* Public constructors. */
+            explicit VibwaLaneSolver(const VibwaLaneBlock<FP>& block_) :
+                block(block_),
+                scale(S::set1(block_.scale)) {}
+
+          public: /* Public methods. */
+            void solve() const {
+                const V lowerBound = S::load(this->block.lowerBounds);
+                const V upperBound = S::load(this->block.upperBounds);
+
+                for (uint32_t level = 0; level < this->block.levelCount; ++level) {
+                    alignas(64) FP result[width];
+                    S::store(result, this->solveLevel(lowerBound, upperBound, level));
+
+                    for (uint32_t lane = 0; lane < width; ++lane) {
+                        if (this->block.levels[lane] != nullptr) {
+                            this->block.levels[lane][level] = result[lane];
+                        }
+                    }
+                }
+            }
+
+          private: /* Private methods. */
+            V factor(uint32_t i) const {
+                return S::load(this->block.factors + static_cast<size_t>(i) * width);
+            }
+
+            FP factor(uint32_t i, uint32_t lane) const {
+                return this->block.factors[static_cast<size_t>(i) * width + lane];
+            }
+
+            V solveLevel(V lower, V upper, uint32_t level) const {
+                const V target = S::set1(static_cast<FP>(this->block.minLevel + level));
+                const V half   = S::set1(FP(0.5));
+
+                // Level is not bound within requested distance to asymptote.
+                const M bound = S::maskAnd(
+                    S::lt(lower, upper), S::gt(this->countNodes(S::mul(this->scale, upper)), target)
+                );
+
+                for (uint32_t iteration = 0; iteration < bisectionIterations<FP>; ++iteration) {
+                    const V middle = S::mul(S::add(lower, upper), half);
+                    const M above  = S::gt(this->countNodes(S::mul(this->scale, middle)), target);
+                    upper          = S::select(above, middle, upper);
+                    lower          = S::select(above, lower, middle);
+                }
+
+                V energy = S::mul(S::add(lower, upper), half);
+                M active = bound;
+                for (uint32_t iteration = 0; iteration < cooleyIterations && S::any(active);
+                     ++iteration) {
+                    const V correction = this->cooleyCorrection(energy);
+                    const V next       = S::add(energy, correction);
+                    // Safeguard - Cooley step must not leave bracket found with bisection.
+                    const M accepted =
+                        S::maskAnd(active, S::maskAnd(S::gt(next, lower), S::lt(next, upper)));
+                    energy = S::select(accepted, next, energy);
+
+                    const M converged =
+                        S::le(S::abs(correction), S::mul(S::set1(epsilon), S::abs(energy)));
+                    active = S::maskAndNot(accepted, converged);
+                }
+                return S::select(bound, energy, S::set1(nan));
+            }
+
+            /* Number of sign changes of outward Numerov solution for given energy in each
+             * lane, renormalized recurrence in Q form, see shader. */
+            V countNodes(V scaledEnergy) const {
+                const V zero      = S::set1(FP(0));
+                const V one       = S::set1(FP(1));
+                const V minusOne  = S::set1(FP(-1));
+                const V twelve    = S::set1(FP(12));
+                const V threshold = S::set1(FP(0.5));
+
+                V nodes = zero;
+                V q     = one;
+
+                for (uint32_t i = 1; i + 1 < this->block.pointCount; ++i) {
+                    const V t         = S::sub(this->factor(i), scaledEnergy);
+                    const M forbidden = S::ge(t, threshold);
+                    const V d         = S::add(S::div(S::mul(twelve, t), S::sub(one, t)), q);
+
+                    // R_i = 1 + D_i changed sign.
+                    const M node = S::maskAndNot(S::lt(d, minusOne), forbidden);
+
+                    nodes = S::add(nodes, S::select(node, one, zero));
+                    q     = S::select(forbidden, one, S::div(d, S::add(one, d)));
+                }
+                return nodes;
+            }
+
+            /* Cooley's energy correction for trial energies. Matching point differs between
+             * lanes, so both integrations run over union of lane ranges and lanes outside of
+             * their own range are masked. */
+            V cooleyCorrection(V energy) const {
+                const uint32_t n = this->block.pointCount;
+
+                const V zero      = S::set1(FP(0));
+                const V one       = S::set1(FP(1));
+                const V twelve    = S::set1(FP(12));
+                const V threshold = S::set1(FP(0.5));
+
+                const V scaledEnergy = S::mul(this->scale, energy);
+
+                alignas(64) FP scaledEnergyLanes[width];
+                alignas(64) FP matchingPointLanes[width];
+                alignas(64) FP matchingFactorLanes[width];
+                S::store(scaledEnergyLanes, scaledEnergy);
+
+                uint32_t minMatchingPoint = n;
+                uint32_t maxMatchingPoint = 0;
+
+                for (uint32_t lane = 0; lane < width; ++lane) {
+                    uint32_t m = n - 2;
+                    while (m > 2 && this->factor(m, lane) > scaledEnergyLanes[lane]) {
+                        m--;
+                    }
+                    m = m > n - 3 ? n - 3 : (m < 2 ? 2 : m);
+
+                    matchingPointLanes[lane]  = static_cast<FP>(m);
+                    matchingFactorLanes[lane] = this->factor(m, lane);
+                    minMatchingPoint          = m < minMatchingPoint ? m : minMatchingPoint;
+                    maxMatchingPoint          = m > maxMatchingPoint ? m : maxMatchingPoint;
+                }
+                const V matchingPoint = S::load(matchingPointLanes);
+
+                auto step = [&](uint32_t i, M inRange, V& q, V& norm) {
+                    const V t            = S::sub(this->factor(i), scaledEnergy);
+                    const M forbidden    = S::ge(t, threshold);
+                    const V psi          = S::div(one, S::sub(one, t));
+                    const V inverseRatio = S::sub(one, q);
+                    const V d            = S::add(S::mul(S::mul(twelve, t), psi), q);
+
+                    const V nextNorm =
+                        S::add(S::mul(S::mul(norm, inverseRatio), inverseRatio), S::mul(psi, psi));
+                    const V nextQ = S::div(d, S::add(one, d));
+
+                    q    = S::select(inRange, S::select(forbidden, one, nextQ), q);
+                    norm = S::select(inRange, S::select(forbidden, zero, nextNorm), norm);
+                };
+
+                V q    = one;
+                V norm = zero;
+                for (uint32_t i = 1; i < maxMatchingPoint; ++i) {
+                    step(i, S::lt(S::set1(static_cast<FP>(i)), matchingPoint), q, norm);
+                }
+                // Normalized to Y_m = 1, so Y_{m-1} = 1 - Q_{m-1}.
+                const V outwardQ    = q;
+                const V outwardNorm = S::mul(S::mul(norm, S::sub(one, q)), S::sub(one, q));
+
+                q    = one;
+                norm = zero;
+                for (uint32_t i = n - 2; i > minMatchingPoint; --i) {
+                    step(i, S::gt(S::set1(static_cast<FP>(i)), matchingPoint), q, norm);
+                }
+                const V inwardQ    = q;
+                const V inwardNorm = S::mul(S::mul(norm, S::sub(one, q)), S::sub(one, q));
+
+                const V tm   = S::sub(S::load(matchingFactorLanes), scaledEnergy);
+                const V psim = S::div(one, S::sub(one, tm));
+                // Y_{m+1} - 2 Y_m + Y_{m-1} = 12 T_m psi_m holds only for eigenvalue.
+                const V residual = S::sub(
+                    S::sub(zero, S::add(outwardQ, inwardQ)), S::mul(S::mul(twelve, tm), psim)
+                );
+                const V denominator = S::mul(
+                    S::mul(S::add(S::add(outwardNorm, S::mul(psim, psim)), inwardNorm), twelve),
+                    this->scale
+                );
+                return S::div(S::mul(S::sub(zero, residual), psim), denominator);
+            }
+        };
+
+        template <typename S>
+        void solveVibwaLanes(const VibwaLaneBlock<typename S::FP>& block) {
+            LIB_EPSEON_ASSERT_TRUE(block.pointCount >= 6);
+            // Matching point indices are compared as FP values.
+            LIB_EPSEON_ASSERT_TRUE(
+                block.pointCount < (uint64_t{1} << std::numeric_limits<typename S::FP>::digits)
+            );
+            VibwaLaneSolver<S>(block).solve();
+        }
+
+        template <typename S>
+        VibwaKernel<typename S::FP> makeVibwaKernel(InstructionSet isa) {
+            return VibwaKernel<typename S::FP>{isa, S::width, &solveVibwaLanes<S>};
+        }
+    } // namespace
+} // namespace epseon::cpu::cpp::kernels
@@ -0,0 +1,96 @@
+#include "vibwa_kernel.hpp"
+
+#include "epseon_cpu/algorithms/kernels.hpp"
+#include <cmath>
+
+namespace epseon {
+    namespace cpu {
+        namespace cpp {
+            namespace kernels {
+                namespace {
+                    /* Single lane traits, used on CPUs without supported SIMD extensions. */
+                    template <typename FP_>
+                    struct ScalarTraits {
+                        using FP = FP_;
+                        using V  = FP_;
+                        using M  = bool;
+
+                        static constexpr uint32_t width = 1;
+
+                        static V set1(FP value) {
+                            return value;
+                        }
+
+                        static V load(const FP* source) {
+                            return *source;
+                        }
+
+                        static void store(FP* destination, V value) {
+                            *destination = value;
+                        }
+
+                        static V add(V a, V b) {
+                            return a + b;
+                        }
+
+                        static V sub(V a, V b) {
+                            return a - b;
+                        }
+
+                        static V mul(V a, V b) {
+                            return a * b;
+                        }
+
+                        static V div(V a, V b) {
+                            return a / b;
+                        }
+
+                        static V abs(V a) {
+                            return a < 0 ? -a : a;
+                        }
+
+                        static M lt(V a, V b) {
+                            return a < b;
+                        }
+
+                        static M le(V a, V b) {
+                            return a <= b;
+                        }
+
+                        static M gt(V a, V b) {
+                            return a > b;
+                        }
+
+                        static M ge(V a, V b) {
+                            return a >= b;
+                        }
+
+                        static M maskAnd(M a, M b) {
+                            return a && b;
+                        }
+
+                        static M maskAndNot(M a, M b) {
+                            return a && !b;
+                        }
+
+                        static V select(M mask, V a, V b) {
+                            return mask ? a : b;
+                        }
+
+                        static bool any(M mask) {
+                            return mask;
+                        }
+                    };
+                } // namespace
+
+                VibwaKernel<float> getScalarVibwaKernelFloat32() {
+                    return makeVibwaKernel<ScalarTraits<float>>(InstructionSet::Scalar);
+                }
+
+                VibwaKernel<double> getScalarVibwaKernelFloat64() {
+                    return makeVibwaKernel<ScalarTraits<double>>(InstructionSet::Scalar);
+                }
+            } // namespace kernels
+        }     // namespace cpp
+    }         // namespace cpu
+} // namespace epseon
@@ -0,0 +1,39 @@
+#include "epseon_cpu/compute_context.hpp"
+#include "epseon_cpu/enums.hpp"
+#include "fmt/format.h"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+namespace epseon {
+    namespace cpu {
+        namespace cpp {
+            ComputeContext::ComputeContext(
+                uint32_t thread_count_, InstructionSet instruction_set_
+            ) :
+                thread_count(thread_count_),
+                instruction_set(instruction_set_) {}
+
+            std::shared_ptr<ComputeContext> ComputeContext::create(uint32_t thread_count) {
+                return ComputeContext::create(thread_count, getBestInstructionSet());
+            }
+
+            std::shared_ptr<ComputeContext>
+            ComputeContext::create(uint32_t thread_count, InstructionSet instruction_set) {
+                if (!isInstructionSetSupported(instruction_set)) {
+                    throw std::runtime_error(fmt::format(
+                        "Instruction set {} is not supported by this CPU or library build.",
+                        toString(instruction_set)
+                    ));
+                }
+                if (thread_count == 0) {
+                    // hardware_concurrency() is allowed to return 0 when it can't tell.
+                    thread_count = std::max(std::thread::hardware_concurrency(), 1U);
+                }
+                return std::make_shared<ComputeContext>(thread_count, instruction_set);
+            }
+        } // namespace cpp
+    }     // namespace cpu
+} // namespace epseon
@@ -0,0 +1,137 @@
+#include "epseon_cpu/enums.hpp"
+#include "fmt/format.h"
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+    #include <immintrin.h>
+#endif
+
+namespace epseon {
+    namespace cpu {
+        namespace cpp {
+
+            namespace {
+                std::string toLowerCase(std::string_view value) {
+                    std::string value_lower_case(value.begin(), value.end());
+                    std::transform(
+                        value.begin(),
+                        value.end(),
+                        value_lower_case.begin(),
+                        [](unsigned char c) {
+                            return std::tolower(c);
+                        }
+                    );
+                    return value_lower_case;
+                }
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+                /* MSVC has no __builtin_cpu_supports(), CPUID and XGETBV are queried directly,
+                 * the latter to check if OS saves AVX registers on context switch. */
+                bool hasCpuFeatures(bool avx512) {
+                    int info[4] = {};
+                    __cpuid(info, 0);
+                    if (info[0] < 7) {
+                        return false;
+                    }
+                    __cpuid(info, 1);
+                    const bool osxsave = (info[2] & (1 << 27)) != 0;
+                    const bool fma     = (info[2] & (1 << 12)) != 0;
+                    if (!osxsave || !fma) {
+                        return false;
+                    }
+                    const unsigned long long xcr0 = _xgetbv(0);
+                    __cpuidex(info, 7, 0);
+                    const bool avx2 = (info[1] & (1 << 5)) != 0;
+                    if (!avx2 || (xcr0 & 0x06) != 0x06) {
+                        return false;
+                    }
+                    if (!avx512) {
+                        return true;
+                    }
+                    const bool avx512f = (info[1] & (1 << 16)) != 0;
+                    return avx512f && (xcr0 & 0xE6) == 0xE6;
+                }
+#endif
+            } // namespace
+
+            InvalidInstructionSetString::InvalidInstructionSetString(std::string_view sv) :
+                message(fmt::format("Invalid InstructionSet literal in string: \"{}\"", sv)) {}
+
+            const char* InvalidInstructionSetString::what() const noexcept {
+                return this->message.c_str();
+            };
+
+            std::string toString(InstructionSet isa) {
+
+                InstructionSetAssertValueCount(3);
+                switch (isa) {
+                    case InstructionSet::Scalar:
+                        return "scalar";
+                    case InstructionSet::AVX2:
+                        return "avx2";
+                    case InstructionSet::AVX512:
+                        return "avx512";
+                    default:
+                        throw std::runtime_error("Unreachable");
+                }
+            }
+
+            InstructionSet toInstructionSet(std::string_view isa) {
+                const auto isa_lower_case = toLowerCase(isa);
+
+                InstructionSetAssertValueCount(3);
+                if (isa_lower_case == "scalar") {
+                    return InstructionSet::Scalar;
+                } else if (isa_lower_case == "avx2") {
+                    return InstructionSet::AVX2;
+                } else if (isa_lower_case == "avx512") {
+                    return InstructionSet::AVX512;
+                } else {
+                    throw InvalidInstructionSetString(isa_lower_case);
+                }
+            }
+
+            bool isInstructionSetSupported(InstructionSet isa) {
+                InstructionSetAssertValueCount(3);
+                switch (isa) {
+                    case InstructionSet::Scalar:
+                        return true;
+                    case InstructionSet::AVX2:
+#if !EPSEON_CPU_AVX2_KERNEL
+                        return false;
+#elif defined(_MSC_VER)
+                        return hasCpuFeatures(false);
+#else
+                        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+                    case InstructionSet::AVX512:
+#if !EPSEON_CPU_AVX512_KERNEL
+                        return false;
+#elif defined(_MSC_VER)
+                        return hasCpuFeatures(true);
+#else
+                        return __builtin_cpu_supports("avx512f");
+#endif
+                    default:
+                        throw std::runtime_error("Unreachable");
+                }
+            }
+
+            InstructionSet getBestInstructionSet() {
+                InstructionSetAssertValueCount(3);
+                for (auto isa : {InstructionSet::AVX512, InstructionSet::AVX2}) {
+                    if (isInstructionSetSupported(isa)) {
+                        return isa;
+                    }
+                }
+                return InstructionSet::Scalar;
+            }
+        } // namespace cpp
+    }     // namespace cpu
+} // namespace epseon
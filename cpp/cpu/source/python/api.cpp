@@ -0,0 +1,258 @@
+#include "epseon/task_configurator/task_configurator.hpp"
+#include "epseon_cpu/compute_context.hpp"
+#include "epseon_cpu/enums.hpp"
+#include "fmt/format.h"
+#include "pybind11/detail/common.h"
+#include "pybind11/pytypes.h"
+#include "pybind11/stl.h"
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "epseon_cpu/python/api.hpp"
+
+namespace py = pybind11;
+
+namespace epseon {
+    namespace cpu {
+        namespace python {
+
+            MorsePotentialConfig MorsePotentialConfig::create(
+                double   dissociation_energy_,
+                double   equilibrium_bond_distance_,
+                double   well_width_,
+                double   min_r_,
+                double   max_r_,
+                uint32_t point_count_
+            ) {
+                return {cpp::MorsePotentialConfig<double>(
+                    dissociation_energy_,
+                    equilibrium_bond_distance_,
+                    well_width_,
+                    min_r_,
+                    max_r_,
+                    point_count_
+                )};
+            }
+
+            const cpp::MorsePotentialConfig<double>&
+            MorsePotentialConfig::getConfiguration() const {
+                return this->configuration;
+            }
+
+            // =========================================================================
+
+            EpseonComputeContext::EpseonComputeContext(
+                std::shared_ptr<cpp::ComputeContext> context_
+            ) :
+                context(context_) {}
+
+            EpseonComputeContext EpseonComputeContext::create(
+                uint32_t thread_count, std::optional<std::string> instruction_set
+            ) {
+                if (!instruction_set.has_value()) {
+                    return {cpp::ComputeContext::create(thread_count)};
+                }
+                auto instruction_set_enum_value = [&instruction_set]() {
+                    try {
+                        return cpp::toInstructionSet(instruction_set.value());
+                    } catch (const cpp::InvalidInstructionSetString& e) {
+                        throw py::value_error(e.what());
+                    }
+                }();
+                return {cpp::ComputeContext::create(thread_count, instruction_set_enum_value)};
+            }
+
+            std::string EpseonComputeContext::get_instruction_set() const {
+                return cpp::toString(this->context->getInstructionSet());
+            }
+
+            uint32_t EpseonComputeContext::get_thread_count() const {
+                return this->context->getThreadCount();
+            }
+
+            TaskConfiguratorVariant
+            EpseonComputeContext::get_task_configurator(const std::string precision) {
+                auto precision_enum_value = [&precision]() {
+                    try {
+                        return cpp::toPrecisionType(precision);
+                    } catch (const cpp::InvalidPrecisionTypeString& e) {
+                        throw py::value_error(e.what());
+                    }
+                }();
+
+                PrecisionTypeAssertValueCount(4);
+                switch (precision_enum_value) {
+                    case cpp::PrecisionType::Float32:
+                        return TaskConfigurator<float>{context->getTaskConfigurator<float>()};
+                    case cpp::PrecisionType::Float64:
+                        return TaskConfigurator<double>{context->getTaskConfigurator<double>()};
+                    case cpp::PrecisionType::Float16:
+                    case cpp::PrecisionType::Float64Emulated:
+                        throw py::value_error(fmt::format(
+                            "{} precision is not supported by CPU backend.",
+                            cpp::toString(precision_enum_value)
+                        ));
+                    default:
+                        throw std::runtime_error("Unreachable.");
+                }
+                assert(false);
+            }
+
+            /* Bind methods shared by TaskHandleFloat32 and TaskHandleFloat64. */
+            template <typename FP>
+            void bindTaskHandle(py::module_& m, const char* name, const char* doc) {
+                py::class_<TaskHandle<FP>>(m, name)
+                    .def(
+                        "is_done",
+                        &TaskHandle<FP>::is_done,
+                        "Check if task already finished execution."
+                    )
+                    .def("is_running", &TaskHandle<FP>::is_running, "Check if task is running.")
+                    .def(
+                        "cancel",
+                        &TaskHandle<FP>::cancel,
+                        "Request task to stop, levels which were not computed stay NaN."
+                    )
+                    .def(
+                        "wait",
+                        &TaskHandle<FP>::wait,
+                        "Block and wait for task to finish.",
+                        py::call_guard<py::gil_scoped_release>()
+                    )
+                    .def(
+                        "get_results",
+                        &TaskHandle<FP>::get_results,
+                        "Get energies of vibrational levels, one list per potential."
+                    )
+                    .doc() = doc;
+            }
+
+            /* Bind methods shared by TaskConfiguratorFloat32 and TaskConfiguratorFloat64. */
+            template <typename FP>
+            void bindTaskConfigurator(py::module_& m, const char* name) {
+                py::class_<TaskConfigurator<FP>>(m, name)
+                    .def(
+                        "set_hardware_config",
+                        &TaskConfigurator<FP>::set_hardware_config,
+                        py::arg("potential_buffer_size"),
+                        py::arg("group_size"),
+                        py::arg("allocation_block_size"),
+                        "Set hardware configuration for a CPU compute task."
+                    )
+                    .def(
+                        "set_morse_potential",
+                        &TaskConfigurator<FP>::set_morse_potential,
+                        py::arg("configurations"),
+                        "Set potential data source configuration for CPU compute task."
+                    )
+                    .def(
+                        "set_vibwa_algorithm",
+                        &TaskConfigurator<FP>::set_vibwa_algorithm,
+                        py::arg("mass_atom_0"),
+                        py::arg("mass_atom_1"),
+                        py::arg("integration_step"),
+                        py::arg("min_distance_to_asymptote"),
+                        py::arg("min_level"),
+                        py::arg("max_level"),
+                        "Set algorithm configuration for a CPU compute task."
+                    )
+                    .def(
+                        "is_configured",
+                        &TaskConfigurator<FP>::is_configured,
+                        "Check if this instance is fully configured, i.e. it has been "
+                        "assigned a valid hardware configuration, potential source and "
+                        "algorithm config."
+                    )
+                    .doc() = "Builder for configuring CPU compute task.";
+            }
+
+            PYBIND11_MODULE(_libepseon_cpu, m) {
+                m.doc() = "Sub package for interacting with CPU compute capabilities.";
+
+                m.def(
+                    "greet",
+                    []() {
+                        return std::string("Hello, World from C++!");
+                    },
+                    "Greet the world."
+                );
+
+                bindTaskHandle<float>(
+                    m,
+                    "TaskHandleFloat32",
+                    "Handle object for referencing single precision CPU compute task."
+                );
+                bindTaskHandle<double>(
+                    m,
+                    "TaskHandleFloat64",
+                    "Handle object for referencing double precision CPU compute task."
+                );
+
+                py::class_<MorsePotentialConfig>(m, "MorsePotentialConfig")
+                    .def(
+                        py::init(&MorsePotentialConfig::create),
+                        py::arg("dissociation_energy"),
+                        py::arg("equilibrium_bond_distance"),
+                        py::arg("well_width"),
+                        py::arg("min_r"),
+                        py::arg("max_r"),
+                        py::arg("point_count"),
+                        "Create instance of MorsePotentialConfig class."
+                    )
+                    .doc() = "Configuration of single Morse potential curve.";
+
+                bindTaskConfigurator<float>(m, "TaskConfiguratorFloat32");
+                bindTaskConfigurator<double>(m, "TaskConfiguratorFloat64");
+
+                // Python API - Wrapper class for ComputeContext class.
+                py::class_<EpseonComputeContext>(m, "EpseonComputeContext")
+                    .def_static(
+                        "create",
+                        &EpseonComputeContext::create,
+                        py::arg("thread_count")    = 0,
+                        py::arg("instruction_set") = std::nullopt,
+                        "Create instance of EpseonComputeContext object."
+                    )
+                    .def(
+                        "get_instruction_set",
+                        &EpseonComputeContext::get_instruction_set,
+                        "Get name of instruction set used by VIBWA kernels."
+                    )
+                    .def(
+                        "get_thread_count",
+                        &EpseonComputeContext::get_thread_count,
+                        "Get number of worker threads used by tasks."
+                    )
+                    .def(
+                        "get_task_configurator",
+                        &EpseonComputeContext::get_task_configurator,
+                        "Get builder instance for configuring CPU compute task."
+                    )
+                    .def(
+                        "submit_task",
+                        &EpseonComputeContext::submit_task<float>,
+                        "Submit task for execution. Will raise RuntimeError upon "
+                        "receiving not fully configured TaskConfigurator."
+                    )
+                    .def(
+                        "submit_task",
+                        &EpseonComputeContext::submit_task<double>,
+                        "Submit task for execution. Will raise RuntimeError upon "
+                        "receiving not fully configured TaskConfigurator."
+                    )
+                    .doc() = "Interface to computations on CPU.";
+            }
+
+        } // namespace python
+    }     // namespace cpu
+} // namespace epseon
@@ -1,5 +1,10 @@
 #include "epseon_cpu/libcpu.hpp"
+#include <cmath>
 #include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
 
 namespace LibCPU {
 
@@ -10,3 +15,110 @@ namespace LibCPU {
     }
 
 } // namespace LibCPU
+
+namespace epseon {
+    namespace cpu {
+        namespace cpp {
+
+            template <typename FP>
+            class VibwaTest : public ::testing::Test {
+              public:
+                static constexpr double dissociation_energy = 5500.0;
+                static constexpr double well_width          = 1.0;
+                static constexpr double mass                = 87.62;
+                static constexpr double tolerance = std::is_same<FP, float>::value ? 0.05 : 1e-4;
+
+                /* Run VIBWA task for Morse potentials with given well widths. */
+                static std::shared_ptr<TaskHandle<FP>> run(
+                    std::shared_ptr<ComputeContext> context,
+                    const std::vector<double>&      well_widths,
+                    uint32_t                        max_level
+                ) {
+                    std::vector<MorsePotentialConfig<FP>> configs{};
+                    for (double width : well_widths) {
+                        configs.emplace_back(dissociation_energy, 2.0, width, 1.0, 10.0, 9001);
+                    }
+                    auto cfg = context->getTaskConfigurator<FP>();
+                    cfg->setHardwareConfig(
+                           std::make_shared<HardwareConfig<FP>>(9001, 16, 16 * 1024 * 1024)
+                    )
+                        .setAlgorithmConfig(std::make_shared<VibwaAlgorithmConfig<FP>>(
+                            mass, mass, 0.001, 0.1, 0, max_level
+                        ))
+                        .setPotentialSource(
+                            std::make_shared<MorsePotentialGenerator<FP>>(std::move(configs))
+                        );
+
+                    auto handle = context->submitTask(cfg);
+                    handle->startWorker();
+                    handle->wait();
+                    return handle;
+                }
+
+                /* E(v) = we (v + 1/2) - wexe (v + 1/2)^2, with B = hbar^2 / (2 mu). */
+                static double analyticLevel(double width, uint32_t v) {
+                    const double rotational_constant = 16.857629206 / (mass / 2);
+                    const double we =
+                        2 * width * std::sqrt(rotational_constant * dissociation_energy);
+                    const double wexe = width * width * rotational_constant;
+                    return we * (v + 0.5) - wexe * (v + 0.5) * (v + 0.5);
+                }
+            };
+
+            using FloatingPointTypes = ::testing::Types<float, double>;
+            TYPED_TEST_SUITE(VibwaTest, FloatingPointTypes);
+
+            TYPED_TEST(VibwaTest, MorseLevelsMatchAnalyticSolution) {
+                const uint32_t max_level = 4;
+                // More potentials than lanes of widest kernel and not a multiple of it.
+                std::vector<double> well_widths{};
+                for (uint32_t i = 0; i < 19; i++) {
+                    well_widths.push_back(0.8 + 0.02 * i);
+                }
+
+                for (auto isa :
+                     {InstructionSet::Scalar, InstructionSet::AVX2, InstructionSet::AVX512}) {
+                    if (!isInstructionSetSupported(isa)) {
+                        continue;
+                    }
+                    auto context = ComputeContext::create(3, isa);
+                    auto handle  = TestFixture::run(context, well_widths, max_level);
+
+                    ASSERT_EQ(handle->getPotentialCount(), well_widths.size());
+                    ASSERT_EQ(handle->getLevelCount(), max_level + 1);
+
+                    const auto& levels = handle->getLevelEnergies();
+                    for (size_t p = 0; p < well_widths.size(); p++) {
+                        for (uint32_t v = 0; v <= max_level; v++) {
+                            EXPECT_NEAR(
+                                levels[p * (max_level + 1) + v],
+                                TestFixture::analyticLevel(well_widths[p], v),
+                                TestFixture::tolerance
+                            ) << toString(isa)
+                              << " potential " << p << " level " << v;
+                        }
+                    }
+                }
+            }
+
+            TYPED_TEST(VibwaTest, UnboundLevelsAreNaN) {
+                auto context = ComputeContext::create();
+                // Morse potential with these parameters has 120 bound levels.
+                auto handle = TestFixture::run(context, {1.0}, 150);
+
+                const auto& levels = handle->getLevelEnergies();
+                EXPECT_FALSE(std::isnan(levels[0]));
+                EXPECT_TRUE(std::isnan(levels[150]));
+            }
+
+            TYPED_TEST(VibwaTest, UnsupportedInstructionSetThrows) {
+                for (auto isa : {InstructionSet::AVX2, InstructionSet::AVX512}) {
+                    if (!isInstructionSetSupported(isa)) {
+                        EXPECT_THROW(ComputeContext::create(1, isa), std::runtime_error);
+                    }
+                }
+                EXPECT_NO_THROW(ComputeContext::create(1, InstructionSet::Scalar));
+            }
+        } // namespace cpp
+    }     // namespace cpu
+} // namespace epseon
@@ -3,10 +3,48 @@
 #include "epseon/gpu/predecl.hpp"
 
 #include "epseon/gpu/device_interface.hpp"
+#include "epseon/gpu/enums.hpp"
+#include <cstdint>
 #include <memory>
+#include <stdexcept>
 
 namespace epseon::gpu::cpp {
 
+    /* Buffers needed by single shader (potential). Sizes in bytes are 64 bit, as large
+     * groups of Float64 potentials easily exceed 4 GiB. Staging and GPU only buffers
+     * hold values of storagePrecision, output buffers always hold FP. */
+    template <typename FP>
+    struct ShaderBuffersRequirements {
+        uint32_t stagingBuffersCount        = {};
+        uint32_t stagingBuffersElementCount = {};
+
+        [[nodiscard]] uint64_t getStagingBuffersSizeBytes() const {
+            return uint64_t{stagingBuffersCount} * stagingBuffersElementCount *
+                   getStorageElementSizeBytes();
+        }
+
+        uint32_t gpuOnlyStorageBuffersCount        = {};
+        uint32_t gpuOnlyStorageBuffersElementCount = {};
+
+        [[nodiscard]] uint64_t getGpuOnlyStorageBufferSizeBytes() const {
+            return uint64_t{gpuOnlyStorageBuffersCount} * gpuOnlyStorageBuffersElementCount *
+                   getStorageElementSizeBytes();
+        }
+
+        uint32_t outputBuffersCount        = {};
+        uint32_t outputBuffersElementCount = {};
+
+        [[nodiscard]] uint64_t getOutputBufferSizeBytes() const {
+            return uint64_t{outputBuffersCount} * outputBuffersElementCount * sizeof(FP);
+        }
+
+        PrecisionType storagePrecision = getPrecisionType<FP>();
+
+        [[nodiscard]] uint64_t getStorageElementSizeBytes() const {
+            return getSizeBytes(storagePrecision);
+        }
+    };
+
     template <typename FP>
     class Algorithm : public std::enable_shared_from_this<Algorithm<FP>> {
         static_assert(std::is_floating_point<FP>::value, "FP must be an floating-point type.");
@@ -30,6 +68,16 @@ namespace epseon::gpu::cpp {
       public: /* Public destructor. */
         virtual ~Algorithm() = default;
 
+      public: /* Public factory methods. */
+        /* GPU implementation of algorithm configured by config, raises
+         * std::runtime_error if there is none. */
+        static std::shared_ptr<Algorithm<FP>> create(const AlgorithmConfig<FP>& config) {
+            if (dynamic_cast<const VibwaAlgorithmConfig<FP>*>(&config) != nullptr) {
+                return std::make_shared<VibwaAlgorithm<FP>>();
+            }
+            throw std::runtime_error("Algorithm configuration has no GPU implementation.");
+        }
+
       public: /* Public methods. */
         virtual void run(const std::stop_token&, TaskHandle<FP>*) = 0;
     };
@@ -5,23 +5,38 @@
 
 #include "epseon/gpu/predecl.hpp"
 
-#include "epseon/gpu/task_configurator/algorithm_config.hpp"
+#include "epseon/task_configurator/algorithm_config.hpp"
+#include "epseon/task_configurator/potential_source.hpp"
 
 #include "epseon/gpu/algorithms/algorithm.hpp"
+#include "epseon/gpu/common.hpp"
+#include "epseon/gpu/device_context.hpp"
+#include "epseon/gpu/enums.hpp"
+#include "epseon/gpu/shaders.hpp"
 #include "epseon/gpu/task_handle.hpp"
 #include "vk_mem_alloc_handles.hpp"
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <deque>
 #include <exception>
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <optional>
+#include <span>
 #include <stdexcept>
+#include <type_traits>
 #include <sys/types.h>
 #include <unistd.h>
+#include <tuple>
 #include <utility>
 #include <vector>
 #include <vulkan/vulkan.hpp>
@@ -30,33 +45,143 @@
 #include <vulkan/vulkan_raii.hpp>
 #include <vulkan/vulkan_structs.hpp>
 
-namespace vma::raii {
-    class Allocator : public vma::Allocator { // NOLINT: hicpp-special-member-functions
-      public:
-        using vma::Allocator::Allocator;
+namespace epseon::gpu::cpp {
 
-        ~Allocator() {
-            this->destroy();
-        }
+    class Interrupted : public std::exception {};
+
+    /* Layout must match push constant block in shaders/vibwa.comp. */
+    template <typename FP>
+    struct VibwaPushConstants {
+        uint32_t          pointCount             = {};
+        uint32_t          minLevel               = {};
+        uint32_t          levelCount             = {};
+        uint32_t          potentialCount         = {};
+        uint32_t          potentialStride        = {};
+        FP                integrationStep        = {};
+        FP                reducedMassFactor      = {};
+        FP                minDistanceToAsymptote = {};
+        // Address of VibwaBufferAddresses table and VibwaProgressCounters of batch, used
+        // only with buffer device address.
+        vk::DeviceAddress bufferTable            = {};
+        vk::DeviceAddress progressBuffer         = {};
     };
-} // namespace vma::raii
 
-namespace epseon::gpu::cpp {
+    /* Device addresses of single buffer set, layout must match BufferSet in
+     * shaders/vibwa.comp. */
+    struct VibwaBufferAddresses {
+        vk::DeviceAddress potentials = {};
+        vk::DeviceAddress factors    = {};
+        vk::DeviceAddress levels     = {};
+    };
 
-    class Interrupted : public std::exception {};
+    /* Counters incremented by shader as it solves potentials of batch, layout must match
+     * ProgressBuffer in shaders/vibwa.comp. */
+    struct VibwaProgressCounters {
+        uint32_t potentials = {};
+        uint32_t levels     = {};
+    };
+
+    /* Layout must match specialization constants in shaders/vibwa.comp. */
+    struct VibwaSpecializationConstants {
+        uint32_t workgroupSize       = {};
+        uint32_t bufferCount         = {};
+        uint32_t potentialsPerBuffer = {};
+    };
+
+    /* Device limits constraining size of batches, see VibwaAlgorithm::planBatches(). */
+    struct VibwaDeviceLimits {
+        vk::DeviceSize maxStorageBufferRange   = {};
+        vk::DeviceSize maxMemoryAllocationSize = {};
+        // Memory which can still be allocated from largest heap with device local memory,
+        // holding GPU only buffers, and from largest heap with host visible memory,
+        // holding staging and output buffers, see DeviceContext::getHeapBudgets().
+        vk::DeviceSize deviceLocalBudget       = {};
+        vk::DeviceSize hostVisibleBudget       = {};
+        // Both kinds of buffers come from the same heap (e.g. integrated GPU).
+        bool           sharedHeap              = {};
+        uint32_t       maxWorkGroupCount       = {};
+        // Limit of descriptor arrays, UINT32_MAX with buffer device address.
+        uint32_t       maxBufferSetCount       = {};
+    };
+
+    /* Split of task into batches processed back-to-back, each batch is single dispatch
+     * of potentialsPerBatch workgroups. */
+    struct VibwaBatchPlan {
+        uint32_t       potentialsPerBatch  = {};
+        uint32_t       potentialsPerBuffer = {};
+        uint32_t       bufferSetCount      = {};
+        // Batches in flight, each with its own buffers.
+        uint32_t       slotCount           = {};
+        size_t         batchCount          = {};
+        // Memory allocated for buffers of all slots.
+        vk::DeviceSize deviceLocalBytes    = {};
+        vk::DeviceSize hostVisibleBytes    = {};
+    };
 
     template <typename FP>
     class VibwaAlgorithm : public Algorithm<FP> {
         static_assert(std::is_floating_point<FP>::value, "FP must be an floating-point type.");
 
+      public: /* Public constants. */
+        // hbar^2 / (2 u Angstrom^2) expressed in cm^-1, divided by reduced mass in atomic mass
+        // units gives kinetic energy factor used by shader.
+        static constexpr double kineticEnergyFactor = 16.857629206;
+
+        // Workgroup size used when device limits allow it, each workgroup solves one
+        // potential curve.
+        static constexpr uint32_t defaultWorkgroupSize = 64;
+
+        // Indices of GPU only buffers of single shader, must match bindings in
+        // shaders/vibwa.comp.
+        static constexpr uint32_t potentialBufferIndex     = 0;
+        static constexpr uint32_t numerovFactorBufferIndex = 1;
+        static constexpr uint32_t gpuOnlyBufferCount       = 2;
+
+        // Values uploaded per potential when Morse potentials are generated by shader -
+        // dissociation energy, equilibrium bond distance, well width, min r and max r,
+        // must match MORSE_PARAMETER_COUNT in shaders/vibwa.comp.
+        static constexpr uint32_t morseParameterCount = 5;
+
+        // Number of batches with separate resources kept in flight, so that upload and
+        // read back of one batch overlap with computation of another.
+        static constexpr uint32_t batchesInFlight = 2;
+
+        // Compute of each batch is split into dispatches (chunks) of about this duration.
+        // Host checks for cancellation between them, so cancelled task frees device within
+        // few chunk durations.
+        static constexpr std::chrono::milliseconds targetChunkDuration{10};
+
+        // Chunks queued on compute queue at once, one executes while the next one waits,
+        // so that device doesn't idle while host handles finished chunk.
+        static constexpr uint32_t chunksInFlight = 2;
+
+        // Size of first chunk of task, following ones are scaled by measured durations.
+        static constexpr uint32_t initialChunkSize = 64;
+
+        // Interval of progress updates published while host waits for chunk.
+        static constexpr std::chrono::milliseconds progressPollInterval{2};
+
+        // Fraction of remaining memory budget single task may allocate, the rest is left
+        // for other tasks and applications sharing the device.
+        static constexpr double maxBudgetUsage = 0.8;
+
       public: /* Public constructors. */
         VibwaAlgorithm() :
             Algorithm<FP>() {}
 
       public: /* Public methods. */
+        /* Buffers bound to single element of descriptor arrays. Each buffer holds data of
+         * potentialsPerBuffer potentials (slots), placed potentialStride (outputStride for
+         * output buffers) elements apart. Staging and GPU only buffers hold values of
+         * storagePrecision, output buffers hold FP. */
         struct ShaderResources {
             std::shared_ptr<vma::raii::Allocator> allocator = {};
 
+            uint32_t      potentialsPerBuffer = {};
+            uint32_t      potentialStride     = {};
+            uint32_t      outputStride        = {};
+            PrecisionType storagePrecision    = getPrecisionType<FP>();
+
             std::vector<vk::Buffer>          stagingBuffers                 = {};
             std::vector<vma::Allocation>     stagingBuffersAllocations      = {};
             std::vector<vma::AllocationInfo> stagingBuffersAllocationsInfos = {};
@@ -85,6 +210,10 @@ namespace epseon::gpu::cpp {
 
             ShaderResources(ShaderResources&& other) noexcept :
                 allocator(std::move(other.allocator)),
+                potentialsPerBuffer(other.potentialsPerBuffer),
+                potentialStride(other.potentialStride),
+                outputStride(other.outputStride),
+                storagePrecision(other.storagePrecision),
 
                 stagingBuffers(std::move(other.stagingBuffers)),
                 stagingBuffersAllocations(std::move(other.stagingBuffersAllocations)),
@@ -101,7 +230,11 @@ namespace epseon::gpu::cpp {
             ShaderResources& operator=(ShaderResources&& other) noexcept {
                 if (this != &other) {
                     // Move resources
-                    allocator = std::move(other.allocator);
+                    allocator           = std::move(other.allocator);
+                    potentialsPerBuffer = other.potentialsPerBuffer;
+                    potentialStride     = other.potentialStride;
+                    outputStride        = other.outputStride;
+                    storagePrecision    = other.storagePrecision;
 
                     stagingBuffers            = std::move(other.stagingBuffers);
                     stagingBuffersAllocations = std::move(other.stagingBuffersAllocations);
@@ -131,15 +264,172 @@ namespace epseon::gpu::cpp {
                 return this->outputBuffers.size();
             }
 
+            /* Copy potential curves into consecutive slots of mapped staging buffer
+             * starting from firstSlot, converting them to storage precision if needed.
+             * Curves laid out like slots are copied at once, padding included. */
+            void uploadPotentials(uint32_t firstSlot, const PotentialView<FP>& potentials) {
+                if (potentials.empty()) {
+                    return;
+                }
+                const vk::DeviceSize elementSize = getSizeBytes(storagePrecision);
+                const vk::DeviceSize offset      = elementSize * firstSlot * potentialStride;
+                const vk::DeviceSize sizeBytes =
+                    elementSize * ((potentials.size() - 1) * potentialStride +
+                                   potentials.getPointCount());
+
+                LIB_EPSEON_ASSERT_TRUE(!stagingBuffers.empty());
+                LIB_EPSEON_ASSERT_TRUE(firstSlot + potentials.size() <= potentialsPerBuffer);
+                LIB_EPSEON_ASSERT_TRUE(
+                    offset + sizeBytes <= stagingBuffersAllocationsInfos[0].size
+                );
+
+                std::byte* destination =
+                    static_cast<std::byte*>(stagingBuffersAllocationsInfos[0].pMappedData) +
+                    offset;
+                if (canCopyPotentialsAtOnce(potentials, potentialStride, storagePrecision)) {
+                    std::memcpy(destination, potentials.getData(), sizeBytes);
+                } else {
+                    for (size_t i = 0; i < potentials.size(); i++) {
+                        writePotential(
+                            destination + i * potentialStride * elementSize, potentials[i]
+                        );
+                    }
+                }
+                allocator->flushAllocation(stagingBuffersAllocations[0], offset, sizeBytes);
+            }
+
+            /* Write potential curve to staging memory at destination, converting it to
+             * storage precision if needed. */
+            void writePotential(std::byte* destination, std::span<const FP> potential) const {
+                if (storagePrecision == getPrecisionType<FP>()) {
+                    std::memcpy(destination, potential.data(), potential.size_bytes());
+                } else if (storagePrecision == PrecisionType::Float64Emulated) {
+                    auto* values = reinterpret_cast<std::array<float, 2>*>(destination);
+                    for (size_t i = 0; i < potential.size(); i++) {
+                        values[i] =
+                            common::double_to_float_pair(static_cast<double>(potential[i]));
+                    }
+                } else {
+                    LIB_EPSEON_ASSERT_TRUE(storagePrecision == PrecisionType::Float16);
+                    // Staging memory is written sequentially, never read.
+                    auto* values = reinterpret_cast<uint16_t*>(destination);
+                    for (size_t i = 0; i < potential.size(); i++) {
+                        values[i] =
+                            common::float_to_float16_bits(static_cast<float>(potential[i]));
+                    }
+                }
+            }
+
+            /* Record copy of first valueCount values of first slotCount potentials from
+             * staging buffer to GPU only buffer. */
+            void recordPotentialUpload(
+                const vk::raii::CommandBuffer& commandBuffer,
+                uint32_t                       slotCount,
+                uint32_t                       valueCount
+            ) const {
+                LIB_EPSEON_ASSERT_TRUE(slotCount > 0 && slotCount <= potentialsPerBuffer);
+                const vk::DeviceSize elementSize = getSizeBytes(storagePrecision);
+
+                // Gaps between whole curves are copied too, so that single region suffices.
+                // Only values at start of each slot are copied when they are few, e.g.
+                // parameters of Morse potentials.
+                if (2 * valueCount >= potentialStride) {
+                    const vk::DeviceSize sizeBytes =
+                        (vk::DeviceSize{slotCount - 1} * potentialStride + valueCount) *
+                        elementSize;
+                    commandBuffer.copyBuffer(
+                        stagingBuffers[0],
+                        gpuOnlyStorageBuffers[potentialBufferIndex],
+                        vk::BufferCopy().setSrcOffset(0).setDstOffset(0).setSize(sizeBytes)
+                    );
+                    return;
+                }
+                std::vector<vk::BufferCopy> regions{};
+                regions.reserve(slotCount);
+                for (uint32_t slot = 0; slot < slotCount; slot++) {
+                    const vk::DeviceSize offset =
+                        vk::DeviceSize{slot} * potentialStride * elementSize;
+                    regions.push_back(vk::BufferCopy()
+                                          .setSrcOffset(offset)
+                                          .setDstOffset(offset)
+                                          .setSize(valueCount * elementSize));
+                }
+                commandBuffer.copyBuffer(
+                    stagingBuffers[0], gpuOnlyStorageBuffers[potentialBufferIndex], regions
+                );
+            }
+
+            /* Barrier transferring ownership of GPU only potential buffer between queue
+             * families, it has to be recorded on both releasing and acquiring queue. */
+            [[nodiscard]] vk::BufferMemoryBarrier getPotentialOwnershipTransfer(
+                uint32_t srcQueueFamilyIndex, uint32_t dstQueueFamilyIndex
+            ) const {
+                return vk::BufferMemoryBarrier()
+                    .setSrcQueueFamilyIndex(srcQueueFamilyIndex)
+                    .setDstQueueFamilyIndex(dstQueueFamilyIndex)
+                    .setBuffer(gpuOnlyStorageBuffers[potentialBufferIndex])
+                    .setOffset(0)
+                    .setSize(vk::WholeSize);
+            }
+
+            /* Device addresses of buffers, they must have been created with
+             * bufferDeviceAddress set. */
+            [[nodiscard]] VibwaBufferAddresses
+            getBufferAddresses(const vk::raii::Device& logicalDevice) const {
+                auto getAddress = [&logicalDevice](vk::Buffer buffer) {
+                    return logicalDevice.getBufferAddress(
+                        vk::BufferDeviceAddressInfo().setBuffer(buffer)
+                    );
+                };
+                return VibwaBufferAddresses{
+                    .potentials = getAddress(gpuOnlyStorageBuffers[potentialBufferIndex]),
+                    .factors    = getAddress(gpuOnlyStorageBuffers[numerovFactorBufferIndex]),
+                    .levels     = getAddress(outputBuffers[0])
+                };
+            }
+
+            /* Copy level energies from slot of mapped output buffer. */
+            void readLevelEnergies(uint32_t slot, std::span<FP> levelEnergies) const {
+                const vk::DeviceSize offset = vk::DeviceSize{slot} * outputStride * sizeof(FP);
+
+                LIB_EPSEON_ASSERT_TRUE(!outputBuffers.empty());
+                LIB_EPSEON_ASSERT_TRUE(slot < potentialsPerBuffer);
+                LIB_EPSEON_ASSERT_TRUE(
+                    offset + levelEnergies.size_bytes() <= outputBuffersAllocationsInfos[0].size
+                );
+
+                allocator->invalidateAllocation(
+                    outputBuffersAllocations[0], offset, levelEnergies.size_bytes()
+                );
+                std::memcpy(
+                    levelEnergies.data(),
+                    static_cast<const std::byte*>(outputBuffersAllocationsInfos[0].pMappedData) +
+                        offset,
+                    levelEnergies.size_bytes()
+                );
+                // Emulated Float64 shaders write pairs of floats in place of doubles.
+                if constexpr (std::is_same_v<FP, double>) {
+                    if (storagePrecision == PrecisionType::Float64Emulated) {
+                        for (auto& energy : levelEnergies) {
+                            energy = common::float_pair_to_double(
+                                std::bit_cast<std::array<float, 2>>(energy)
+                            );
+                        }
+                    }
+                }
+            }
+
           private:
             void destroy() {
-                destroy(stagingBuffers, stagingBuffersAllocations);
-                destroy(gpuOnlyStorageBuffers, gpuOnlyStorageBuffersAllocations);
-                destroy(outputBuffers, outputBuffersAllocations);
+                if (allocator) {
+                    destroy(stagingBuffers, stagingBuffersAllocations);
+                    destroy(gpuOnlyStorageBuffers, gpuOnlyStorageBuffersAllocations);
+                    destroy(outputBuffers, outputBuffersAllocations);
+                }
             }
 
             template <typename BufferT, typename AllocationT>
-            void destroy(std::vector<BufferT> buffers, std::vector<AllocationT> allocations) {
+            void destroy(std::vector<BufferT>& buffers, std::vector<AllocationT>& allocations) {
                 LIB_EPSEON_ASSERT_TRUE(buffers.size() == allocations.size());
 
                 for (uint32_t i = 0; i < buffers.size(); i++) {
@@ -149,12 +439,63 @@ namespace epseon::gpu::cpp {
                 allocations.clear();
             }
 
+            /* Create buffer, suballocated from custom pool with blocks of blockSize
+             * bytes if it fits into one. Larger buffers are left to default VMA pools. */
+            static std::pair<vk::Buffer, vma::Allocation> createBuffer(
+                vma::raii::Allocator&       allocator,
+                DeviceContext&              deviceContext,
+                vk::DeviceSize              blockSize,
+                const vk::BufferCreateInfo& bufferCreateInfo,
+                vma::AllocationCreateInfo   allocationCreateInfo,
+                vma::AllocationInfo*        allocationInfo = nullptr
+            ) {
+                if (blockSize != 0 && bufferCreateInfo.size <= blockSize) {
+                    const uint32_t memoryTypeIndex = allocator.findMemoryTypeIndexForBufferInfo(
+                        bufferCreateInfo, allocationCreateInfo
+                    );
+                    allocationCreateInfo.setPool(
+                        deviceContext.getMemoryPool(memoryTypeIndex, blockSize)
+                    );
+                }
+                return allocator.createBuffer(
+                    bufferCreateInfo, allocationCreateInfo, allocationInfo
+                );
+            }
+
           public:
             static ShaderResources create(
                 std::shared_ptr<vma::raii::Allocator> allocator,
-                const ShaderBuffersRequirements<FP>&  requirements
+                DeviceContext&                        deviceContext,
+                vk::DeviceSize                        blockSize,
+                const ShaderBuffersRequirements<FP>&  requirements,
+                uint32_t                              potentialsPerBuffer,
+                bool                                  bufferDeviceAddress
             ) {
+                // Staging buffer is copied 1:1 into potential buffer.
+                LIB_EPSEON_ASSERT_TRUE(
+                    requirements.stagingBuffersElementCount ==
+                    requirements.gpuOnlyStorageBuffersElementCount
+                );
                 ShaderResources resources{allocator};
+                resources.potentialsPerBuffer = potentialsPerBuffer;
+                resources.potentialStride     = requirements.gpuOnlyStorageBuffersElementCount;
+                resources.outputStride        = requirements.outputBuffersElementCount;
+                resources.storagePrecision    = requirements.storagePrecision;
+
+                // Buffers accessed by shader need to be addressable in device address mode.
+                const vk::BufferUsageFlags addressUsage =
+                    bufferDeviceAddress ? vk::BufferUsageFlagBits::eShaderDeviceAddress
+                                        : vk::BufferUsageFlags{};
+
+                const vk::DeviceSize stagingBufferSize =
+                    vk::DeviceSize{requirements.stagingBuffersElementCount} * potentialsPerBuffer *
+                    requirements.getStorageElementSizeBytes();
+                const vk::DeviceSize gpuOnlyBufferSize =
+                    vk::DeviceSize{requirements.gpuOnlyStorageBuffersElementCount} *
+                    potentialsPerBuffer * requirements.getStorageElementSizeBytes();
+                const vk::DeviceSize outputBufferSize =
+                    vk::DeviceSize{requirements.outputBuffersElementCount} * potentialsPerBuffer *
+                    sizeof(FP);
 
                 resources.stagingBuffers.reserve(requirements.stagingBuffersCount);
                 resources.stagingBuffersAllocations.reserve(requirements.stagingBuffersCount);
@@ -173,9 +514,12 @@ namespace epseon::gpu::cpp {
                 for (uint32_t i = 0; i < requirements.stagingBuffersCount; i++) {
                     vma::AllocationInfo info{};
 
-                    auto [buffer, allocation] = allocator->createBuffer(
+                    auto [buffer, allocation] = createBuffer(
+                        *allocator,
+                        deviceContext,
+                        blockSize,
                         vk::BufferCreateInfo()
-                            .setSize(requirements.getStagingBuffersSizeBytes())
+                            .setSize(stagingBufferSize)
                             .setUsage(vk::BufferUsageFlagBits::eTransferSrc),
                         vma::AllocationCreateInfo()
                             .setUsage(vma::MemoryUsage::eAuto)
@@ -192,16 +536,17 @@ namespace epseon::gpu::cpp {
                 }
                 /* Allocate GPU only buffers. */
                 for (uint32_t i = 0; i < requirements.gpuOnlyStorageBuffersCount; i++) {
-                    auto [buffer, allocation] = allocator->createBuffer(
+                    auto [buffer, allocation] = createBuffer(
+                        *allocator,
+                        deviceContext,
+                        blockSize,
                         vk::BufferCreateInfo()
-                            .setSize(requirements.getGpuOnlyStorageBufferSizeBytes())
+                            .setSize(gpuOnlyBufferSize)
                             .setUsage(
                                 vk::BufferUsageFlagBits::eTransferDst |
-                                vk::BufferUsageFlagBits::eStorageBuffer
+                                vk::BufferUsageFlagBits::eStorageBuffer | addressUsage
                             ),
-                        vma::AllocationCreateInfo()
-                            .setUsage(vma::MemoryUsage::eAuto)
-                            .setFlags(vma::AllocationCreateFlagBits::eDedicatedMemory)
+                        vma::AllocationCreateInfo().setUsage(vma::MemoryUsage::eAuto)
                     );
 
                     resources.gpuOnlyStorageBuffers.push_back(std::move(buffer));
@@ -211,10 +556,13 @@ namespace epseon::gpu::cpp {
                 for (uint32_t i = 0; i < requirements.outputBuffersCount; i++) {
                     vma::AllocationInfo info{};
 
-                    auto [buffer, allocation] = allocator->createBuffer(
+                    auto [buffer, allocation] = createBuffer(
+                        *allocator,
+                        deviceContext,
+                        blockSize,
                         vk::BufferCreateInfo()
-                            .setSize(requirements.getOutputBufferSizeBytes())
-                            .setUsage(vk::BufferUsageFlagBits::eStorageBuffer),
+                            .setSize(outputBufferSize)
+                            .setUsage(vk::BufferUsageFlagBits::eStorageBuffer | addressUsage),
                         vma::AllocationCreateInfo()
                             .setUsage(vma::MemoryUsage::eAuto)
                             .setFlags(
@@ -236,16 +584,27 @@ namespace epseon::gpu::cpp {
         struct ComputeBatchResources {
           private:
             uint32_t                                   shaderCount            = {};
+            uint32_t                                   potentialsPerBuffer    = {};
             std::shared_ptr<vma::raii::Allocator>      allocator              = {};
             std::vector<ShaderResources>               shaderResources        = {};
             std::vector<vk::raii::DescriptorSetLayout> descriptorSetLayouts   = {};
             std::vector<vk::DescriptorSetLayout>       descriptorVkSetLayouts = {};
             std::shared_ptr<vk::raii::DescriptorPool>  descriptorPool         = {};
             std::vector<vk::raii::DescriptorSet>       descriptorSets         = {};
+            // Used instead of descriptor sets when buffer device address is enabled.
+            bool                                       bufferDeviceAddress    = false;
+            vk::Buffer                                 bufferTable            = {};
+            vma::Allocation                            bufferTableAllocation  = {};
+            vk::DeviceAddress                          bufferTableAddress     = {};
+            // Host visible counters of batch, see VibwaProgressCounters.
+            vk::Buffer                                 progressBuffer         = {};
+            vma::Allocation                            progressAllocation     = {};
+            VibwaProgressCounters*                     progressCounters       = {};
+            vk::DeviceAddress                          progressAddress        = {};
 
           private:
-            explicit ComputeBatchResources(vma::raii::Allocator&& allocator) :
-                allocator(std::make_shared<vma::raii::Allocator>(allocator)){};
+            explicit ComputeBatchResources(std::shared_ptr<vma::raii::Allocator> allocator) :
+                allocator(std::move(allocator)){};
 
           public:
             // Copy constructor
@@ -259,68 +618,93 @@ namespace epseon::gpu::cpp {
 
             ComputeBatchResources(ComputeBatchResources&& other) noexcept :
                 shaderCount(std::move(other.shaderCount)),
+                potentialsPerBuffer(std::move(other.potentialsPerBuffer)),
                 allocator(std::move(other.allocator)),
                 shaderResources(std::move(other.shaderResources)),
                 descriptorSetLayouts(std::move(other.descriptorSetLayouts)),
                 descriptorVkSetLayouts(std::move(other.descriptorVkSetLayouts)),
-                descriptorPool(std::move(other.descriptorPool)) {}
+                descriptorPool(std::move(other.descriptorPool)),
+                descriptorSets(std::move(other.descriptorSets)),
+                bufferDeviceAddress(other.bufferDeviceAddress),
+                bufferTable(std::exchange(other.bufferTable, {})),
+                bufferTableAllocation(std::exchange(other.bufferTableAllocation, {})),
+                bufferTableAddress(std::exchange(other.bufferTableAddress, {})),
+                progressBuffer(std::exchange(other.progressBuffer, {})),
+                progressAllocation(std::exchange(other.progressAllocation, {})),
+                progressCounters(std::exchange(other.progressCounters, {})),
+                progressAddress(std::exchange(other.progressAddress, {})) {}
 
             // Move assignment operator
             ComputeBatchResources& operator=(ComputeBatchResources&& other) noexcept {
                 if (this != &other) {
+                    destroyBufferTable();
+                    destroyProgressBuffer();
                     // Move resources
                     shaderCount            = std::move(other.shaderCount);
+                    potentialsPerBuffer    = std::move(other.potentialsPerBuffer);
                     allocator              = std::move(other.allocator);
                     shaderResources        = std::move(other.shaderResources);
                     descriptorSetLayouts   = std::move(other.descriptorSetLayouts);
                     descriptorVkSetLayouts = std::move(other.descriptorVkSetLayouts);
                     descriptorPool         = std::move(other.descriptorPool);
+                    descriptorSets         = std::move(other.descriptorSets);
+                    bufferDeviceAddress    = other.bufferDeviceAddress;
+                    bufferTable            = std::exchange(other.bufferTable, {});
+                    bufferTableAllocation  = std::exchange(other.bufferTableAllocation, {});
+                    bufferTableAddress     = std::exchange(other.bufferTableAddress, {});
+                    progressBuffer         = std::exchange(other.progressBuffer, {});
+                    progressAllocation     = std::exchange(other.progressAllocation, {});
+                    progressCounters       = std::exchange(other.progressCounters, {});
+                    progressAddress        = std::exchange(other.progressAddress, {});
                 }
                 return *this;
             }
 
-            ~ComputeBatchResources() = default;
-
-            static ComputeBatchResources create(
-                uint32_t                        vulkanApiVersion,
-                const vk::raii::Instance&       instance,
-                const vk::raii::PhysicalDevice& physicalDevice,
-                const vk::raii::Device&         logicalDevice
-            ) {
-                auto functions = vma::VulkanFunctions();
-
-                functions.setVkGetInstanceProcAddr(instance.getDispatcher()->vkGetInstanceProcAddr)
-                    .setVkGetDeviceProcAddr(instance.getDispatcher()->vkGetDeviceProcAddr);
-
-                LIB_EPSEON_ASSERT_TRUE(functions.vkGetInstanceProcAddr != nullptr);
-                LIB_EPSEON_ASSERT_TRUE(functions.vkGetDeviceProcAddr != nullptr);
-
-                vma::Allocator allocator =
-                    vma::createAllocator(vma::AllocatorCreateInfo()
-                                             .setVulkanApiVersion(vulkanApiVersion)
-                                             .setInstance(*instance)
-                                             .setPhysicalDevice(*physicalDevice)
-                                             .setDevice(*logicalDevice)
-                                             .setPVulkanFunctions(&functions));
-                ComputeBatchResources resources{
-                    // Trust me I know what I am doing - vma::raii::Allocator is a transparent
-                    // wrapper.
-                    static_cast< // NOLINT: cppcoreguidelines-pro-type-static-cast-downcast
-                        vma::raii::Allocator&&>(allocator)
-                };
+            ~ComputeBatchResources() {
+                destroyBufferTable();
+                destroyProgressBuffer();
+            }
 
-                return resources;
+            /* Resources are allocated with allocator shared by all tasks running on
+             * device, see DeviceContext. */
+            static ComputeBatchResources create(std::shared_ptr<vma::raii::Allocator> allocator) {
+                return ComputeBatchResources{std::move(allocator)};
             }
 
-            void allocateResources(const std::vector<ShaderBuffersRequirements<FP>>& requirements) {
-                setShaderCount(requirements.size());
-                shaderResources.reserve(getShaderCount());
+            /* Allocate buffers for requirements.size() shaders (potentials), packed
+             * potentialsPerBuffer per buffer. Memory is suballocated from custom pools with
+             * blocks of blockSize bytes, 0 means default VMA pools. Buffers are addressable
+             * by device if device context has buffer device address enabled. */
+            void allocateResources(
+                const std::vector<ShaderBuffersRequirements<FP>>& requirements,
+                uint32_t                                          potentialsPerBuffer_,
+                DeviceContext&                                    deviceContext,
+                vk::DeviceSize                                    blockSize
+            ) {
+                LIB_EPSEON_ASSERT_TRUE(!requirements.empty());
+                LIB_EPSEON_ASSERT_TRUE(potentialsPerBuffer_ > 0);
 
-                for (const auto& requirementStruct : requirements) {
-                    shaderResources.emplace_back(
-                        ShaderResources::create(allocator, requirementStruct)
-                    );
+                setShaderCount(requirements.size());
+                this->potentialsPerBuffer = potentialsPerBuffer_;
+                this->bufferDeviceAddress = deviceContext.isBufferDeviceAddressEnabled();
+
+                const uint32_t bufferSetCount =
+                    (getShaderCount() + potentialsPerBuffer_ - 1) / potentialsPerBuffer_;
+                shaderResources.reserve(bufferSetCount);
+
+                for (uint32_t i = 0; i < bufferSetCount; i++) {
+                    // All shaders have same requirements, see
+                    // VibwaAlgorithm::getShaderBufferRequirements().
+                    shaderResources.emplace_back(ShaderResources::create(
+                        allocator,
+                        deviceContext,
+                        blockSize,
+                        requirements[0],
+                        potentialsPerBuffer_,
+                        this->bufferDeviceAddress
+                    ));
                 }
+                createProgressBuffer(deviceContext.getDevice());
             }
 
             void setShaderCount(uint32_t shaderCount) {
@@ -331,6 +715,200 @@ namespace epseon::gpu::cpp {
                 return this->shaderCount;
             }
 
+            [[nodiscard]] uint32_t getPotentialsPerBuffer() const {
+                return this->potentialsPerBuffer;
+            }
+
+            /* Number of buffers of each role, i.e. size of descriptor arrays. */
+            [[nodiscard]] uint32_t getBufferSetCount() const {
+                return this->shaderResources.size();
+            }
+
+            [[nodiscard]] bool usesBufferDeviceAddress() const {
+                return this->bufferDeviceAddress;
+            }
+
+            /* Device address of table with addresses of all buffer sets, passed to shader
+             * in push constants, see createBufferTable(). */
+            [[nodiscard]] vk::DeviceAddress getBufferTableAddress() const {
+                return this->bufferTableAddress;
+            }
+
+            /* Write addresses of all buffer sets into table read by shader. With buffer
+             * device address this replaces descriptor sets, buffers are written once and
+             * there is no limit on number of buffer sets. */
+            void createBufferTable(const vk::raii::Device& logicalDevice) {
+                LIB_EPSEON_ASSERT_TRUE(this->bufferDeviceAddress);
+                LIB_EPSEON_ASSERT_FALSE(this->bufferTable);
+
+                std::vector<VibwaBufferAddresses> addresses{};
+                addresses.reserve(this->shaderResources.size());
+                for (const auto& resources : this->shaderResources) {
+                    addresses.push_back(resources.getBufferAddresses(logicalDevice));
+                }
+                const vk::DeviceSize sizeBytes = std::span{addresses}.size_bytes();
+
+                vma::AllocationInfo info{};
+                std::tie(this->bufferTable, this->bufferTableAllocation) = allocator->createBuffer(
+                    vk::BufferCreateInfo().setSize(sizeBytes).setUsage(
+                        vk::BufferUsageFlagBits::eStorageBuffer |
+                        vk::BufferUsageFlagBits::eShaderDeviceAddress
+                    ),
+                    vma::AllocationCreateInfo()
+                        .setUsage(vma::MemoryUsage::eAuto)
+                        .setFlags(
+                            vma::AllocationCreateFlagBits::eHostAccessSequentialWrite |
+                            vma::AllocationCreateFlagBits::eMapped
+                        ),
+                    &info
+                );
+                // Host writes are made visible to device by queue submission.
+                std::memcpy(info.pMappedData, addresses.data(), sizeBytes);
+                allocator->flushAllocation(this->bufferTableAllocation, 0, sizeBytes);
+
+                this->bufferTableAddress = logicalDevice.getBufferAddress(
+                    vk::BufferDeviceAddressInfo().setBuffer(this->bufferTable)
+                );
+            }
+
+            /* Device address of progress counters, passed to shader in push constants with
+             * buffer device address. */
+            [[nodiscard]] vk::DeviceAddress getProgressBufferAddress() const {
+                return this->progressAddress;
+            }
+
+            /* Zero progress counters before first chunk of new batch is submitted. */
+            void resetProgress() {
+                LIB_EPSEON_ASSERT_TRUE(this->progressCounters);
+                *this->progressCounters = VibwaProgressCounters{};
+                allocator->flushAllocation(this->progressAllocation, 0, vk::WholeSize);
+            }
+
+            /* Current values of progress counters. While chunks of batch run, values are
+             * only a lower bound of work done, they are exact once computed semaphore
+             * reaches value of last chunk. */
+            [[nodiscard]] VibwaProgressCounters readProgress() const {
+                LIB_EPSEON_ASSERT_TRUE(this->progressCounters);
+                allocator->invalidateAllocation(this->progressAllocation, 0, vk::WholeSize);
+                // Device writes counters concurrently, atomic loads avoid torn reads.
+                return VibwaProgressCounters{
+                    .potentials = std::atomic_ref<uint32_t>(this->progressCounters->potentials)
+                                      .load(std::memory_order_relaxed),
+                    .levels = std::atomic_ref<uint32_t>(this->progressCounters->levels)
+                                  .load(std::memory_order_relaxed)
+                };
+            }
+
+            [[nodiscard]] std::vector<ShaderResources>& getShaderResources() {
+                return this->shaderResources;
+            }
+
+            /* Copy potential curves of batch into staging buffers, index-th curve goes to
+             * index-th shader. */
+            void uploadPotentials(const PotentialView<FP>& potentials) {
+                for (size_t first = 0; first < potentials.size(); first += potentialsPerBuffer) {
+                    const size_t count =
+                        std::min<size_t>(this->potentialsPerBuffer, potentials.size() - first);
+                    this->shaderResources[first / this->potentialsPerBuffer].uploadPotentials(
+                        0, potentials.subview(first, count)
+                    );
+                }
+            }
+
+            /* Record copies of first valueCount values of first potentialCount potentials
+             * to GPU only buffers. */
+            void recordPotentialUploads(
+                const vk::raii::CommandBuffer& commandBuffer,
+                uint32_t                       potentialCount,
+                uint32_t                       valueCount
+            ) const {
+                for (uint32_t first = 0; first < potentialCount; first += potentialsPerBuffer) {
+                    this->shaderResources[first / this->potentialsPerBuffer].recordPotentialUpload(
+                        commandBuffer,
+                        std::min(this->potentialsPerBuffer, potentialCount - first),
+                        valueCount
+                    );
+                }
+            }
+
+            /* Ownership transfers of GPU only potential buffers of all buffer sets. */
+            [[nodiscard]] std::vector<vk::BufferMemoryBarrier> getPotentialOwnershipTransfers(
+                uint32_t srcQueueFamilyIndex, uint32_t dstQueueFamilyIndex
+            ) const {
+                std::vector<vk::BufferMemoryBarrier> barriers{};
+                barriers.reserve(this->shaderResources.size());
+                for (const auto& resources : this->shaderResources) {
+                    barriers.push_back(resources.getPotentialOwnershipTransfer(
+                        srcQueueFamilyIndex, dstQueueFamilyIndex
+                    ));
+                }
+                return barriers;
+            }
+
+            /* Copy level energies computed by index-th shader of batch. */
+            void readLevelEnergies(uint32_t index, std::span<FP> levelEnergies) const {
+                this->shaderResources[index / this->potentialsPerBuffer].readLevelEnergies(
+                    index % this->potentialsPerBuffer, levelEnergies
+                );
+            }
+
+          private:
+            void destroyBufferTable() {
+                if (this->allocator && this->bufferTable) {
+                    this->allocator->destroyBuffer(this->bufferTable, this->bufferTableAllocation);
+                }
+                this->bufferTable           = vk::Buffer{};
+                this->bufferTableAllocation = vma::Allocation{};
+                this->bufferTableAddress    = {};
+            }
+
+            void createProgressBuffer(const vk::raii::Device& logicalDevice) {
+                LIB_EPSEON_ASSERT_FALSE(this->progressBuffer);
+
+                const vk::BufferUsageFlags addressUsage =
+                    this->bufferDeviceAddress ? vk::BufferUsageFlagBits::eShaderDeviceAddress
+                                              : vk::BufferUsageFlags{};
+                vma::AllocationInfo info{};
+                std::tie(this->progressBuffer, this->progressAllocation) = allocator->createBuffer(
+                    vk::BufferCreateInfo()
+                        .setSize(sizeof(VibwaProgressCounters))
+                        .setUsage(vk::BufferUsageFlagBits::eStorageBuffer | addressUsage),
+                    vma::AllocationCreateInfo()
+                        .setUsage(vma::MemoryUsage::eAuto)
+                        .setFlags(
+                            vma::AllocationCreateFlagBits::eHostAccessRandom |
+                            vma::AllocationCreateFlagBits::eMapped
+                        ),
+                    &info
+                );
+                this->progressCounters = static_cast<VibwaProgressCounters*>(info.pMappedData);
+                if (this->bufferDeviceAddress) {
+                    this->progressAddress = logicalDevice.getBufferAddress(
+                        vk::BufferDeviceAddressInfo().setBuffer(this->progressBuffer)
+                    );
+                }
+            }
+
+            void destroyProgressBuffer() {
+                if (this->allocator && this->progressBuffer) {
+                    this->allocator->destroyBuffer(this->progressBuffer, this->progressAllocation);
+                }
+                this->progressBuffer     = vk::Buffer{};
+                this->progressAllocation = vma::Allocation{};
+                this->progressCounters   = nullptr;
+                this->progressAddress    = {};
+            }
+
+          public:
+            [[nodiscard]] std::vector<vk::DescriptorSet> getVkDescriptorSets() const {
+                std::vector<vk::DescriptorSet> sets;
+                sets.reserve(this->descriptorSets.size());
+                for (const auto& descriptorSet : this->descriptorSets) {
+                    sets.push_back(*descriptorSet);
+                }
+                return sets;
+            }
+
             [[nodiscard]] uint32_t getDescriptorSetLayoutCount() const {
                 return 1;
             }
@@ -432,14 +1010,14 @@ namespace epseon::gpu::cpp {
                     // compile time. Reserving memory for exact number of elements before
                     // push_back() will allow us to avoid resource reallocation.
                     descriptorSetLayoutBindings.reserve(
-                        expectedGpuOnlyBufferCount + expectedOutputBufferCount
+                        expectedGpuOnlyBufferCount + expectedOutputBufferCount + 1
                     );
 
                     for (uint32_t binding = 0; binding < expectedGpuOnlyBufferCount; binding++) {
                         descriptorSetLayoutBindings.push_back(
                             vk::DescriptorSetLayoutBinding()
                                 .setBinding(binding)
-                                .setDescriptorCount(getShaderCount())
+                                .setDescriptorCount(getBufferSetCount())
                                 .setDescriptorType(getGpuOnlyBufferDescriptorType())
                                 .setStageFlags({vk::ShaderStageFlagBits::eCompute})
                         );
@@ -452,13 +1030,22 @@ namespace epseon::gpu::cpp {
                         descriptorSetLayoutBindings.push_back(
                             vk::DescriptorSetLayoutBinding()
                                 .setBinding(binding)
-                                .setDescriptorCount(getShaderCount())
+                                .setDescriptorCount(getBufferSetCount())
                                 .setDescriptorType(getOutputBufferDescriptorType())
                                 .setStageFlags({vk::ShaderStageFlagBits::eCompute})
                         );
                     }
                     LIB_EPSEON_ASSERT_TRUE(!descriptorSetLayoutBindings.empty());
 
+                    // Progress counters are shared by whole batch, so they are not an array.
+                    descriptorSetLayoutBindings.push_back(
+                        vk::DescriptorSetLayoutBinding()
+                            .setBinding(getProgressBufferBinding())
+                            .setDescriptorCount(1)
+                            .setDescriptorType(vk::DescriptorType::eStorageBuffer)
+                            .setStageFlags({vk::ShaderStageFlagBits::eCompute})
+                    );
+
                     if (!descriptorSetLayoutBindings.empty()) {
                         // We need exactly one for now, so avoid allocation of space for multiple
                         // elements.
@@ -486,14 +1073,19 @@ namespace epseon::gpu::cpp {
 
                 for (uint32_t binding = 0; binding < getPerShaderGpuOnlyBufferCount(); binding++) {
                     descriptorPoolSizes.push_back(vk::DescriptorPoolSize()
-                                                      .setDescriptorCount(getShaderCount())
+                                                      .setDescriptorCount(getBufferSetCount())
                                                       .setType(vk::DescriptorType::eStorageBuffer));
                 }
-                for (uint32_t binding = 0; binding < getPerShaderGpuOnlyBufferCount(); binding++) {
+                for (uint32_t binding = 0; binding < getShaderOutputBufferCount(); binding++) {
                     descriptorPoolSizes.push_back(vk::DescriptorPoolSize()
-                                                      .setDescriptorCount(getShaderCount())
+                                                      .setDescriptorCount(getBufferSetCount())
                                                       .setType(vk::DescriptorType::eStorageBuffer));
                 }
+                descriptorPoolSizes.push_back(
+                    vk::DescriptorPoolSize().setDescriptorCount(1).setType(
+                        vk::DescriptorType::eStorageBuffer
+                    )
+                );
                 if (!descriptorPoolSizes.empty()) {
                     descriptorPool = std::make_shared<vk::raii::DescriptorPool>(
                         std::move(logicalDevice.createDescriptorPool(
@@ -506,6 +1098,11 @@ namespace epseon::gpu::cpp {
                 }
             }
 
+            /* Binding of progress counters, placed after GPU only and output buffers. */
+            [[nodiscard]] uint32_t getProgressBufferBinding() const {
+                return getPerShaderGpuOnlyBufferCount() + getShaderOutputBufferCount();
+            }
+
             [[nodiscard]] vk::DescriptorPool getDescriptorPool() {
                 LIB_EPSEON_ASSERT_TRUE(this->descriptorPool);
                 return *(*this->descriptorPool);
@@ -547,7 +1144,9 @@ namespace epseon::gpu::cpp {
                 uint32_t outputBufferBindingOffset  = expectedGpuOnlyBufferCount;
                 uint32_t expectedOutputBufferCount  = getShaderOutputBufferCount();
 
-                descriptorSetWrites.reserve(expectedGpuOnlyBufferCount + expectedOutputBufferCount);
+                descriptorSetWrites.reserve(
+                    expectedGpuOnlyBufferCount + expectedOutputBufferCount + 1
+                );
                 descriptorSetWrites.resize(expectedGpuOnlyBufferCount + expectedOutputBufferCount);
 
                 for (uint32_t binding = 0; binding < expectedGpuOnlyBufferCount; binding++) {
@@ -565,7 +1164,7 @@ namespace epseon::gpu::cpp {
                     write.writeDescriptorSet.setDstSet(*descriptorSet)
                         .setDstBinding(binding)
                         .setBufferInfo(write.bufferInfo)
-                        .setDescriptorCount(getShaderCount())
+                        .setDescriptorCount(getBufferSetCount())
                         .setDescriptorType(getGpuOnlyBufferDescriptorType());
                 }
 
@@ -584,10 +1183,21 @@ namespace epseon::gpu::cpp {
                     write.writeDescriptorSet.setDstSet(*descriptorSet)
                         .setDstBinding(binding)
                         .setBufferInfo(write.bufferInfo)
-                        .setDescriptorCount(getShaderCount())
+                        .setDescriptorCount(getBufferSetCount())
                         .setDescriptorType(getOutputBufferDescriptorType());
                 }
 
+                WriteDescriptorSet& progressWrite = descriptorSetWrites.emplace_back();
+                progressWrite.bufferInfo.push_back(vk::DescriptorBufferInfo()
+                                                       .setBuffer(this->progressBuffer)
+                                                       .setOffset(0)
+                                                       .setRange(vk::WholeSize));
+                progressWrite.writeDescriptorSet.setDstSet(*descriptorSet)
+                    .setDstBinding(getProgressBufferBinding())
+                    .setBufferInfo(progressWrite.bufferInfo)
+                    .setDescriptorCount(1)
+                    .setDescriptorType(vk::DescriptorType::eStorageBuffer);
+
                 return descriptorSetWrites;
             }
 
@@ -602,75 +1212,1219 @@ namespace epseon::gpu::cpp {
             }
         };
 
+        struct ComputePipeline {
+            vk::raii::ShaderModule   shaderModule   = nullptr;
+            vk::raii::PipelineLayout pipelineLayout = nullptr;
+            vk::raii::Pipeline       pipeline       = nullptr;
+
+            static ComputePipeline create(
+                const vk::raii::Device&                     logicalDevice,
+                const vk::raii::PipelineCache&              pipelineCache,
+                const std::vector<vk::DescriptorSetLayout>& descriptorSetLayouts,
+                VibwaSpecializationConstants                specializationConstants,
+                PrecisionType                               storagePrecision,
+                bool                                        bufferDeviceAddress,
+                bool                                        morseGeneration
+            ) {
+                ComputePipeline computePipeline{};
+
+                // Buffer device address variant of shader has no descriptor sets.
+                LIB_EPSEON_ASSERT_TRUE(bufferDeviceAddress == descriptorSetLayouts.empty());
+                const auto shaderCode = shaders::getVibwaShaderCode(
+                    storagePrecision, bufferDeviceAddress, morseGeneration
+                );
+                computePipeline.shaderModule = logicalDevice.createShaderModule(
+                    vk::ShaderModuleCreateInfo()
+                        .setCodeSize(shaderCode.size_bytes())
+                        .setPCode(shaderCode.data())
+                );
+
+                const auto pushConstantRange = vk::PushConstantRange()
+                                                   .setStageFlags(vk::ShaderStageFlagBits::eCompute)
+                                                   .setOffset(0)
+                                                   .setSize(sizeof(VibwaPushConstants<FP>));
+
+                computePipeline.pipelineLayout =
+                    logicalDevice.createPipelineLayout(vk::PipelineLayoutCreateInfo()
+                                                           .setSetLayouts(descriptorSetLayouts)
+                                                           .setPushConstantRanges(pushConstantRange));
+
+                const std::array<vk::SpecializationMapEntry, 3> specializationMapEntries{
+                    vk::SpecializationMapEntry()
+                        .setConstantID(0)
+                        .setOffset(offsetof(VibwaSpecializationConstants, workgroupSize))
+                        .setSize(sizeof(uint32_t)),
+                    vk::SpecializationMapEntry()
+                        .setConstantID(1)
+                        .setOffset(offsetof(VibwaSpecializationConstants, bufferCount))
+                        .setSize(sizeof(uint32_t)),
+                    vk::SpecializationMapEntry()
+                        .setConstantID(2)
+                        .setOffset(offsetof(VibwaSpecializationConstants, potentialsPerBuffer))
+                        .setSize(sizeof(uint32_t))
+                };
+                const auto specializationInfo = vk::SpecializationInfo()
+                                                    .setMapEntries(specializationMapEntries)
+                                                    .setDataSize(sizeof(specializationConstants))
+                                                    .setPData(&specializationConstants);
+
+                // Chunks of batch are dispatched with base workgroup index of their first
+                // potential.
+                computePipeline.pipeline = logicalDevice.createComputePipeline(
+                    pipelineCache,
+                    vk::ComputePipelineCreateInfo()
+                        .setFlags(vk::PipelineCreateFlagBits::eDispatchBase)
+                        .setStage(vk::PipelineShaderStageCreateInfo()
+                                      .setStage(vk::ShaderStageFlagBits::eCompute)
+                                      .setModule(*computePipeline.shaderModule)
+                                      .setPName("main")
+                                      .setPSpecializationInfo(&specializationInfo))
+                        .setLayout(*computePipeline.pipelineLayout)
+                );
+                return computePipeline;
+            }
+        };
+
+        /* Timestamp queries written at beginning and end of command buffers - one pair per
+         * slot for uploads and one pair per chunk in flight for compute. Queries are reset
+         * on host when device supports it, otherwise in command buffers. Transfer only
+         * queues can't reset queries, so uploads on dedicated transfer queue are timed only
+         * with host reset.
+         */
+        struct TimestampQueries {
+            enum class Phase { Upload, Compute };
+
+            vk::raii::QueryPool queryPool       = nullptr;
+            uint32_t            uploadPairCount = {};
+            bool                hostReset       = false;
+            bool                timeUpload      = false;
+            bool                timeCompute     = false;
+            uint64_t            uploadMask      = {};
+            uint64_t            computeMask     = {};
+            // Nanoseconds per timestamp tick.
+            double              period          = {};
+
+            static TimestampQueries create(
+                const vk::raii::PhysicalDevice& physicalDevice,
+                const DeviceContext&            deviceContext,
+                uint32_t                        uploadPairCount,
+                uint32_t                        computePairCount
+            ) {
+                TimestampQueries queries{};
+
+                // Zero valid bits means queue family doesn't support timestamps.
+                const auto     families = physicalDevice.getQueueFamilyProperties();
+                const uint32_t computeBits =
+                    families[deviceContext.getQueueFamilyIndex()].timestampValidBits;
+                const uint32_t uploadBits =
+                    families[deviceContext.getTransferQueueFamilyIndex()].timestampValidBits;
+                const bool uploadResettable =
+                    deviceContext.isHostQueryResetEnabled() ||
+                    !deviceContext.hasDedicatedTransferQueue();
+
+                queries.uploadPairCount = uploadPairCount;
+                queries.hostReset       = deviceContext.isHostQueryResetEnabled();
+                queries.timeCompute     = computeBits > 0;
+                queries.timeUpload      = uploadBits > 0 && uploadResettable;
+                queries.computeMask     = getTimestampMask(computeBits);
+                queries.uploadMask      = getTimestampMask(uploadBits);
+                queries.period          = physicalDevice.getProperties().limits.timestampPeriod;
+                if (!queries.timeUpload && !queries.timeCompute) {
+                    return queries;
+                }
+
+                const uint32_t queryCount = 2 * (uploadPairCount + computePairCount);
+                queries.queryPool         = deviceContext.getDevice().createQueryPool(
+                    vk::QueryPoolCreateInfo()
+                        .setQueryType(vk::QueryType::eTimestamp)
+                        .setQueryCount(queryCount)
+                );
+                if (queries.hostReset) {
+                    queries.queryPool.resetEXT(0, queryCount);
+                }
+                return queries;
+            }
+
+            static uint64_t getTimestampMask(uint32_t validBits) {
+                return validBits >= 64 ? ~uint64_t{0} : (uint64_t{1} << validBits) - 1;
+            }
+
+            [[nodiscard]] bool isEnabled(Phase phase) const {
+                return phase == Phase::Upload ? this->timeUpload : this->timeCompute;
+            }
+
+            /* Index of first query of pair, index is slot for uploads and chunk command
+             * buffer for compute. */
+            [[nodiscard]] uint32_t getFirstQuery(Phase phase, uint32_t index) const {
+                return 2 * (phase == Phase::Upload ? index : this->uploadPairCount + index);
+            }
+
+            /* Record timestamp before commands of command buffer. */
+            void recordBegin(
+                const vk::raii::CommandBuffer& commandBuffer, Phase phase, uint32_t index
+            ) const {
+                if (!this->isEnabled(phase)) {
+                    return;
+                }
+                const uint32_t first = this->getFirstQuery(phase, index);
+                if (!this->hostReset) {
+                    commandBuffer.resetQueryPool(*this->queryPool, first, 2);
+                }
+                commandBuffer.writeTimestamp(
+                    vk::PipelineStageFlagBits::eTopOfPipe, *this->queryPool, first
+                );
+            }
+
+            /* Record timestamp after all commands of command buffer complete. */
+            void recordEnd(
+                const vk::raii::CommandBuffer& commandBuffer, Phase phase, uint32_t index
+            ) const {
+                if (!this->isEnabled(phase)) {
+                    return;
+                }
+                commandBuffer.writeTimestamp(
+                    vk::PipelineStageFlagBits::eBottomOfPipe,
+                    *this->queryPool,
+                    this->getFirstQuery(phase, index) + 1
+                );
+            }
+
+            /* Add device time of command buffer to timings, once it is known to be
+             * finished. Compute waits for upload, so both are finished once computed
+             * semaphore reaches value of chunk. */
+            void accumulate(Phase phase, uint32_t index, TaskTimings& timings) const {
+                if (!this->isEnabled(phase)) {
+                    return;
+                }
+                const uint32_t first = this->getFirstQuery(phase, index);
+                if (phase == Phase::Upload) {
+                    addDuration(timings.deviceUpload, first, this->uploadMask);
+                } else {
+                    addDuration(timings.deviceCompute, first, this->computeMask);
+                }
+                if (this->hostReset) {
+                    this->queryPool.resetEXT(first, 2);
+                }
+            }
+
+          private:
+            void addDuration(
+                std::optional<TaskTimings::Duration>& total, uint32_t first, uint64_t mask
+            ) const {
+                const auto [result, timestamps] = this->queryPool.getResults<uint64_t>(
+                    first, 2, 2 * sizeof(uint64_t), sizeof(uint64_t), vk::QueryResultFlagBits::e64
+                );
+                if (result != vk::Result::eSuccess) {
+                    return;
+                }
+                // Timestamps wrap around after valid bits.
+                const uint64_t ticks = (timestamps[1] - timestamps[0]) & mask;
+                total = total.value_or(TaskTimings::Duration{}) +
+                        TaskTimings::Duration{static_cast<double>(ticks) * this->period * 1e-9};
+            }
+        };
+
+        /* Size of chunk expected to take about targetChunkDuration, given that chunk of
+         * chunkSize potentials took duration. Single measurement is noisy, so size changes
+         * at most four times per chunk. */
+        static uint32_t getNextChunkSize(
+            uint32_t chunkSize, std::chrono::duration<double> duration, uint32_t maxChunkSize
+        ) {
+            const double scale = std::clamp(
+                std::chrono::duration<double>(targetChunkDuration).count() /
+                    std::max(duration.count(), 1e-6),
+                0.25,
+                4.0
+            );
+            const double size = std::clamp(
+                chunkSize * scale, 1.0, static_cast<double>(std::max<uint32_t>(maxChunkSize, 1))
+            );
+            return static_cast<uint32_t>(size);
+        }
+
         virtual void run(const std::stop_token& stop_token, TaskHandle<FP>* handle) {
             if (stop_token.stop_requested()) {
                 return;
             }
 
-            const auto& physicalDevice = handle->getDeviceInterface().getPhysicalDevice();
-            auto        logicalDevice  = createLogicalDevice(physicalDevice);
-            const auto& compute_context_state =
-                handle->getDeviceInterface().getComputeContextState();
+            const auto& deviceInterface = handle->getDeviceInterface();
+            const auto& physicalDevice  = deviceInterface.getPhysicalDevice();
 
-            auto configurator = handle->getTaskConfigurator();
+            const auto& configurator = handle->getTaskConfigurator();
+            const auto  algorithmConfig =
+                std::dynamic_pointer_cast<VibwaAlgorithmConfig<FP>>(configurator.getAlgorithmConfig()
+                );
+            LIB_EPSEON_ASSERT_TRUE(algorithmConfig);
+
+            using Clock    = std::chrono::steady_clock;
+            auto& timings  = handle->getWorkerTimings();
+            auto& progress = handle->getWorkerProgress();
+            auto  start    = Clock::now();
+
+            progress.setPhase(TaskPhase::GeneratingPotentials);
+            // Morse potentials are evaluated by shader when device can store them in FP,
+            // only their parameters are uploaded then. Other curves are uploaded from
+            // contiguous buffer of source, either memory it keeps them in (e.g. mapped
+            // potential file) or memory it fills in place.
+            const auto& potentialSource = configurator.getPotentialSource();
+            const auto  morse =
+                std::dynamic_pointer_cast<MorsePotentialGenerator<FP>>(potentialSource);
+            const bool morseGeneration =
+                morse && canGenerateMorsePotentials(
+                             *morse, configurator.getStoragePrecision(), physicalDevice
+                         );
+
+            std::vector<FP>                      morseParameters{};
+            std::shared_ptr<PotentialBuffer<FP>> hostBuffer{};
+            if (morseGeneration) {
+                morseParameters = getMorseParameters(*morse);
+            } else {
+                hostBuffer = potentialSource->get_potential_buffer();
+            }
+            const PotentialView<FP> potentials =
+                morseGeneration ? PotentialView<FP>{morseParameters.data(),
+                                                    morse->configurations.size(),
+                                                    morseParameterCount,
+                                                    morseParameterCount}
+                                : hostBuffer->getView();
+            timings.potentialGeneration = Clock::now() - start;
+            progress.setPotentialCount(potentials.size());
+            progress.setPhase(TaskPhase::Preparing);
+            const uint32_t pointCount =
+                morseGeneration ? validatePointCount(
+                                      morse->configurations.front().getPointCount(),
+                                      *configurator.getHardwareConfig()
+                                  )
+                                : validatePotentials(potentials, *configurator.getHardwareConfig());
+            // Values of each potential uploaded to device.
+            const uint32_t uploadedValueCount = morseGeneration ? morseParameterCount : pointCount;
+            const uint32_t levelCount         = algorithmConfig->getLevelCount();
+
+            handle->allocateResults(potentials.size(), levelCount);
+            if (potentials.empty()) {
+                return;
+            }
+
+            // Logical device is created by first task and shared with following ones.
+            start                     = Clock::now();
+            const auto  deviceContext = deviceInterface.getDeviceContext();
+            const auto& logicalDevice = deviceContext->getDevice();
+            timings.deviceSetup       = Clock::now() - start;
 
+            const PrecisionType storagePrecision =
+                selectStoragePrecision(configurator.getStoragePrecision(), *deviceContext);
+            LIB_EPSEON_ASSERT_TRUE(!morseGeneration || storagePrecision == getPrecisionType<FP>());
             if (stop_token.stop_requested()) {
                 return;
             }
 
-            ComputeBatchResources resources = ComputeBatchResources::create(
-                handle->getDeviceInterface().getComputeContextState().getVulkanApiVersion(),
-                compute_context_state.getVkInstance(),
-                physicalDevice,
-                logicalDevice
+            // All shaders have same requirements, see getShaderBufferRequirements().
+            auto requirements = getShaderBufferRequirements(configurator);
+            if (requirements.empty()) {
+                throw std::runtime_error("Group size must be greater than zero.");
+            }
+            // Generated Morse curves are written by shader, only their parameters are
+            // uploaded, so slots keep stride of potential buffer size for them.
+            const uint32_t potentialStride =
+                morseGeneration
+                    ? requirements.front().gpuOnlyStorageBuffersElementCount
+                    : getPotentialSlotStride(
+                          potentials,
+                          requirements.front().gpuOnlyStorageBuffersElementCount,
+                          storagePrecision
+                      );
+            for (auto& shaderRequirements : requirements) {
+                shaderRequirements.storagePrecision                  = storagePrecision;
+                shaderRequirements.stagingBuffersElementCount        = potentialStride;
+                shaderRequirements.gpuOnlyStorageBuffersElementCount = potentialStride;
+            }
+            const size_t groupSize = requirements.size();
+
+            start = Clock::now();
+            VibwaBatchPlan                     plan{};
+            std::vector<ComputeBatchResources> slots{};
+            // Every batch in flight has its own buffers, descriptor sets (or buffer address
+            // table) and command buffer. Other processes may allocate memory after budgets
+            // were queried, then batches are halved and planned again with new budgets.
+            for (size_t maxBatchSize = groupSize;; maxBatchSize = plan.potentialsPerBatch / 2) {
+                plan = planBatches(
+                    getDeviceLimits(physicalDevice, *deviceContext),
+                    requirements.front(),
+                    maxBatchSize,
+                    potentials.size()
+                );
+                requirements.resize(plan.potentialsPerBatch);
+                try {
+                    slots = allocateSlots(
+                        plan,
+                        requirements,
+                        *deviceContext,
+                        configurator.getHardwareConfig()->getAllocationBlockSize()
+                    );
+                    break;
+                } catch (const vk::OutOfDeviceMemoryError&) {
+                    if (plan.potentialsPerBatch == 1) {
+                        throw;
+                    }
+                }
+            }
+
+            const size_t   shaderCount = plan.potentialsPerBatch;
+            const size_t   batchCount  = plan.batchCount;
+            const uint32_t slotCount   = plan.slotCount;
+            timings.resourceSetup      = Clock::now() - start;
+
+            // Pipeline cache makes pipeline creation cheap for every but the first task
+            // with given shader, it is written back to disk once pipeline is created.
+            // Descriptor set layouts of all slots are identical, so any of them will do.
+            start                     = Clock::now();
+            const auto& pipelineCache = deviceContext->getPipelineCache();
+            auto        pipeline      = ComputePipeline::create(
+                logicalDevice,
+                pipelineCache,
+                slots.front().getVkDescriptorSetLayouts(),
+                VibwaSpecializationConstants{
+                    .workgroupSize       = getWorkgroupSize(
+                        physicalDevice, configurator.getHardwareConfig()->getWorkgroupSize()
+                    ),
+                    .bufferCount         = slots.front().getBufferSetCount(),
+                    .potentialsPerBuffer = slots.front().getPotentialsPerBuffer()
+                },
+                requirements.front().storagePrecision,
+                slots.front().usesBufferDeviceAddress(),
+                morseGeneration
+            );
+            deviceInterface.getPipelineCache().store(pipelineCache);
+            timings.pipelineSetup = Clock::now() - start;
+
+            start = Clock::now();
+            // Potentials are copied on transfer queue, which may belong to other family than
+            // compute queue. Command buffers have to be destroyed before pools are returned
+            // to device context.
+            const auto transferCommandPool =
+                deviceContext->acquireCommandPool(deviceContext->getTransferQueueFamilyIndex());
+            const auto computeCommandPool =
+                deviceContext->acquireCommandPool(deviceContext->getQueueFamilyIndex());
+            auto transferCommandBuffers = logicalDevice.allocateCommandBuffers(
+                vk::CommandBufferAllocateInfo()
+                    .setCommandPool(**transferCommandPool)
+                    .setLevel(vk::CommandBufferLevel::ePrimary)
+                    .setCommandBufferCount(slotCount)
+            );
+            auto computeCommandBuffers = logicalDevice.allocateCommandBuffers(
+                vk::CommandBufferAllocateInfo()
+                    .setCommandPool(**computeCommandPool)
+                    .setLevel(vk::CommandBufferLevel::ePrimary)
+                    .setCommandBufferCount(chunksInFlight)
             );
-            auto requirements = configurator.getShaderBufferRequirements();
-            resources.allocateResources(requirements);
-            resources.createDescriptorSets(logicalDevice);
-            resources.updateDescriptorSets(logicalDevice);
+            // Batch k signals value k + 1 of uploaded once its potentials are copied, chunk
+            // c signals value c + 1 of computed once its level energies are written.
+            const auto uploaded = deviceContext->createTimelineSemaphore();
+            const auto computed = deviceContext->createTimelineSemaphore();
+            const auto timestamps =
+                TimestampQueries::create(physicalDevice, *deviceContext, slotCount, chunksInFlight);
+            timings.resourceSetup += Clock::now() - start;
+
+            VibwaPushConstants<FP> pushConstants{
+                .pointCount             = pointCount,
+                .minLevel               = algorithmConfig->getMinLevel(),
+                .levelCount             = levelCount,
+                .potentialCount         = 0,
+                .potentialStride        = requirements.front().gpuOnlyStorageBuffersElementCount,
+                .integrationStep =
+                    toShaderValue(algorithmConfig->getIntegrationStep(), storagePrecision),
+                .reducedMassFactor =
+                    toShaderValue(getReducedMassFactor(*algorithmConfig), storagePrecision),
+                .minDistanceToAsymptote =
+                    toShaderValue(algorithmConfig->getMinDistanceToAsymptote(), storagePrecision)
+            };
+            const vk::DeviceSize potentialSizeBytes =
+                vk::DeviceSize{uploadedValueCount} * getSizeBytes(storagePrecision);
 
-            if (stop_token.stop_requested()) {
-                return;
+            auto getBatchSize = [&](uint64_t batch) {
+                return static_cast<uint32_t>(
+                    std::min(shaderCount, potentials.size() - batch * shaderCount)
+                );
+            };
+
+            // Potentials [first, first + count) of batch dispatched with single submission.
+            struct Chunk {
+                uint64_t          batch          = {};
+                uint32_t          first          = {};
+                uint32_t          count          = {};
+                uint32_t          commandBuffer  = {};
+                uint64_t          signalValue    = {};
+                Clock::time_point submissionTime = {};
+            };
+
+            uint64_t uploadsSubmitted = 0;
+            uint64_t chunksSubmitted  = 0;
+            // Batch being dispatched and number of its potentials already dispatched.
+            uint64_t computing        = 0;
+            uint32_t dispatched       = 0;
+            uint64_t completed        = 0;
+            uint32_t chunkSize        = std::min<uint32_t>(initialChunkSize, shaderCount);
+            // Value of computed after which slot can be reused by next upload.
+            std::vector<uint64_t> slotReleaseValues(slotCount, 0);
+            std::deque<Chunk>     chunks{};
+            auto                  lastCompletion = Clock::now();
+            // Counters of batches already read completely, slots of batches in flight add
+            // their live counters on top of them.
+            uint64_t              potentialsCompleted = 0;
+            uint64_t              levelsFound         = 0;
+            // Streamed results of batches in flight, one per slot, passed to handle once
+            // batch completes.
+            const bool                   streaming = handle->isStreaming();
+            std::vector<BatchResult<FP>> streamed(streaming ? slotCount : 0);
+
+            // Where results of index-th potential of batch are read back to.
+            auto getLevelEnergies = [&](uint64_t batch, uint32_t index) {
+                if (!streaming) {
+                    return handle->getPotentialLevelEnergies(batch * shaderCount + index);
+                }
+                return std::span<FP>{streamed[batch % slotCount].levelEnergies}.subspan(
+                    size_t{index} * levelCount, levelCount
+                );
+            };
+
+            auto publishProgress = [&]() {
+                uint64_t potentialsTotal = potentialsCompleted;
+                uint64_t levelsTotal     = levelsFound;
+                for (uint64_t batch = completed; batch < uploadsSubmitted; batch++) {
+                    const auto counters = slots[batch % slotCount].readProgress();
+                    potentialsTotal += counters.potentials;
+                    levelsTotal += counters.levels;
+                }
+                progress.setPotentialsCompleted(potentialsTotal);
+                progress.setLevelsFound(levelsTotal);
+            };
+
+            // Copy potentials of next batch to free slot and submit their upload. Host
+            // already read results of previous batch using the slot, semaphore wait only
+            // orders device side.
+            auto submitUpload = [&]() {
+                const uint32_t slot      = uploadsSubmitted % slotCount;
+                const size_t   first     = uploadsSubmitted * shaderCount;
+                const uint32_t batchSize = getBatchSize(uploadsSubmitted);
+
+                const auto writeStart = Clock::now();
+                slots[slot].uploadPotentials(potentials.subview(first, batchSize));
+                timings.stagingWrite += Clock::now() - writeStart;
+
+                // Previous batch of slot was read completely, so its counters are no longer
+                // needed.
+                slots[slot].resetProgress();
+                pushConstants.potentialCount = batchSize;
+                recordUpload(
+                    transferCommandBuffers[slot],
+                    slots[slot],
+                    pushConstants,
+                    uploadedValueCount,
+                    *deviceContext,
+                    timestamps,
+                    slot
+                );
+
+                const vk::PipelineStageFlags uploadWaitStage = vk::PipelineStageFlagBits::eTransfer;
+                const auto uploadSubmitInfo = vk::TimelineSemaphoreSubmitInfo()
+                                                  .setWaitSemaphoreValues(slotReleaseValues[slot])
+                                                  .setSignalSemaphoreValues(uploadsSubmitted + 1);
+                deviceContext->submitTransfer(
+                    vk::SubmitInfo()
+                        .setPNext(&uploadSubmitInfo)
+                        .setWaitSemaphores(*computed)
+                        .setWaitDstStageMask(uploadWaitStage)
+                        .setCommandBuffers(*transferCommandBuffers[slot])
+                        .setSignalSemaphores(*uploaded),
+                    {}
+                );
+                uploadsSubmitted++;
+                progress.addBytesUploaded(batchSize * potentialSizeBytes);
+            };
+
+            // Dispatch next chunk of oldest uploaded batch which was not fully dispatched.
+            // Every chunk waits for upload of its batch, it is signaled already for all but
+            // the first one.
+            auto submitChunk = [&]() {
+                const uint32_t slot          = computing % slotCount;
+                const uint32_t batchSize     = getBatchSize(computing);
+                const uint32_t commandBuffer = chunksSubmitted % chunksInFlight;
+
+                const Chunk chunk{
+                    .batch          = computing,
+                    .first          = dispatched,
+                    .count          = std::min(chunkSize, batchSize - dispatched),
+                    .commandBuffer  = commandBuffer,
+                    .signalValue    = chunksSubmitted + 1,
+                    .submissionTime = Clock::now()
+                };
+                pushConstants.potentialCount = batchSize;
+                pushConstants.bufferTable    = slots[slot].getBufferTableAddress();
+                pushConstants.progressBuffer = slots[slot].getProgressBufferAddress();
+                recordCompute(
+                    computeCommandBuffers[commandBuffer],
+                    slots[slot],
+                    pipeline,
+                    pushConstants,
+                    *deviceContext,
+                    timestamps,
+                    commandBuffer,
+                    chunk.first,
+                    chunk.count
+                );
+
+                const vk::PipelineStageFlags computeWaitStage =
+                    vk::PipelineStageFlagBits::eComputeShader;
+                const auto computeSubmitInfo = vk::TimelineSemaphoreSubmitInfo()
+                                                   .setWaitSemaphoreValues(computing + 1)
+                                                   .setSignalSemaphoreValues(chunk.signalValue);
+                deviceContext->submit(
+                    vk::SubmitInfo()
+                        .setPNext(&computeSubmitInfo)
+                        .setWaitSemaphores(*uploaded)
+                        .setWaitDstStageMask(computeWaitStage)
+                        .setCommandBuffers(*computeCommandBuffers[commandBuffer])
+                        .setSignalSemaphores(*computed),
+                    {}
+                );
+                chunks.push_back(chunk);
+                chunksSubmitted++;
+                timings.dispatchCount++;
+
+                dispatched += chunk.count;
+                if (dispatched == batchSize) {
+                    slotReleaseValues[slot] = chunk.signalValue;
+                    computing++;
+                    dispatched = 0;
+                }
+            };
+
+            // Wait for oldest chunk in flight and copy its results, batch frees its slot
+            // once results of its last chunk are copied. Progress counters are published
+            // every progressPollInterval while waiting.
+            auto readBackChunk = [&]() {
+                const Chunk chunk = chunks.front();
+                chunks.pop_front();
+
+                const auto waitStart = Clock::now();
+                while (!deviceContext->waitForTimelineSemaphore(
+                    computed, chunk.signalValue, progressPollInterval
+                )) {
+                    publishProgress();
+                }
+                const auto readStart = Clock::now();
+                timings.deviceWait += readStart - waitStart;
+
+                // Device starts chunk once previous one finishes, or once it is submitted
+                // if device was idle. Tail chunks of batches are smaller, they would only
+                // skew measurement.
+                if (chunk.count == chunkSize) {
+                    chunkSize = getNextChunkSize(
+                        chunkSize,
+                        readStart - std::max(chunk.submissionTime, lastCompletion),
+                        shaderCount
+                    );
+                }
+                lastCompletion = readStart;
+
+                const uint32_t slot      = chunk.batch % slotCount;
+                const auto&    resources = slots[slot];
+                if (streaming && chunk.first == 0) {
+                    streamed[slot] = BatchResult<FP>{
+                        .firstPotential = chunk.batch * shaderCount,
+                        .levelCount     = levelCount,
+                        .levelEnergies  = std::vector<FP>(
+                            size_t{getBatchSize(chunk.batch)} * levelCount,
+                            std::numeric_limits<FP>::quiet_NaN()
+                        )
+                    };
+                }
+                for (uint32_t i = chunk.first; i < chunk.first + chunk.count; i++) {
+                    resources.readLevelEnergies(i, getLevelEnergies(chunk.batch, i));
+                }
+                timestamps.accumulate(
+                    TimestampQueries::Phase::Compute, chunk.commandBuffer, timings
+                );
+                if (chunk.first == 0) {
+                    timestamps.accumulate(TimestampQueries::Phase::Upload, slot, timings);
+                }
+                progress.addBytesReadBack(vk::DeviceSize{chunk.count} * levelCount * sizeof(FP));
+                if (chunk.first + chunk.count == getBatchSize(chunk.batch)) {
+                    // Counters of slot are exact once its last chunk finished.
+                    const auto counters = resources.readProgress();
+                    potentialsCompleted += counters.potentials;
+                    levelsFound += counters.levels;
+                    timings.batchCount++;
+                    completed++;
+                    if (streaming) {
+                        handle->pushBatchResult(std::move(streamed[slot]), stop_token);
+                        streamed[slot] = {};
+                    }
+                }
+                publishProgress();
+                timings.readBack += Clock::now() - readStart;
+            };
+
+            // Host uploads batch k + 1 while device computes chunks of batch k, GPU
+            // transfers of one batch overlap compute of another. Stop is checked before
+            // every submission, after cancellation only chunks already in flight finish
+            // and results of all finished chunks are kept.
+            try {
+                progress.setPhase(TaskPhase::Computing);
+                while (completed < batchCount) {
+                    const bool stopRequested = stop_token.stop_requested();
+                    if (!stopRequested && computing < uploadsSubmitted &&
+                        chunks.size() < chunksInFlight) {
+                        submitChunk();
+                    } else if (!stopRequested && uploadsSubmitted < batchCount &&
+                               uploadsSubmitted - completed < slotCount) {
+                        submitUpload();
+                    } else if (!chunks.empty()) {
+                        readBackChunk();
+                    } else {
+                        LIB_EPSEON_ASSERT_TRUE(stopRequested);
+                        break;
+                    }
+                }
+                // Cancelled batch keeps results of its finished chunks, like whole task
+                // results do, if consumer has room for them.
+                if (streaming && completed < batchCount &&
+                    !streamed[completed % slotCount].levelEnergies.empty()) {
+                    handle->pushBatchResult(
+                        std::move(streamed[completed % slotCount]), stop_token
+                    );
+                }
+                // Buffers must outlive uploads of batches which were never dispatched.
+                deviceContext->waitForTimelineSemaphore(uploaded, uploadsSubmitted);
+            } catch (...) {
+                // Buffers must outlive work already submitted to the queues.
+                const std::array<vk::Semaphore, 2> semaphores{*uploaded, *computed};
+                const std::array<uint64_t, 2>      values{uploadsSubmitted, chunksSubmitted};
+                static_cast<void>(logicalDevice.waitSemaphores(
+                    vk::SemaphoreWaitInfo().setSemaphores(semaphores).setValues(values), UINT64_MAX
+                ));
+                throw;
             }
+        }
 
-            std::cout << "Thread finished" << std::endl;
+        /* Record copy of valueCount values of each potential to GPU only buffers on
+         * transfer queue. With dedicated transfer queue, buffers are released to compute
+         * queue family afterwards. */
+        void recordUpload(
+            const vk::raii::CommandBuffer& commandBuffer,
+            const ComputeBatchResources&   resources,
+            const VibwaPushConstants<FP>&  pushConstants,
+            uint32_t                       valueCount,
+            const DeviceContext&           deviceContext,
+            const TimestampQueries&        timestamps,
+            uint32_t                       slot
+        ) {
+            commandBuffer.reset();
+            commandBuffer.begin(
+                vk::CommandBufferBeginInfo().setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit)
+            );
+            timestamps.recordBegin(commandBuffer, TimestampQueries::Phase::Upload, slot);
+            // No barrier against previous batches - they use other slots and previous use of
+            // this one is ordered with timeline semaphore wait. Previous contents of buffers
+            // are overwritten, so they are not transferred back from compute queue family.
+            resources.recordPotentialUploads(
+                commandBuffer, pushConstants.potentialCount, valueCount
+            );
+            if (deviceContext.hasDedicatedTransferQueue()) {
+                auto barriers = resources.getPotentialOwnershipTransfers(
+                    deviceContext.getTransferQueueFamilyIndex(), deviceContext.getQueueFamilyIndex()
+                );
+                for (auto& barrier : barriers) {
+                    barrier.setSrcAccessMask(vk::AccessFlagBits::eTransferWrite);
+                }
+                commandBuffer.pipelineBarrier(
+                    vk::PipelineStageFlagBits::eTransfer,
+                    vk::PipelineStageFlagBits::eBottomOfPipe,
+                    {},
+                    {},
+                    barriers,
+                    {}
+                );
+            }
+            timestamps.recordEnd(commandBuffer, TimestampQueries::Phase::Upload, slot);
+            commandBuffer.end();
         }
 
-        uint32_t selectQueueFamilyIndex(const vk::raii::PhysicalDevice& physicalDevice) {
-            uint32_t queue_family_index = -1;
+        /* Record dispatch of potentialCount potentials of batch starting at firstPotential
+         * on compute queue. First chunk of batch acquires potential buffers from transfer
+         * queue family if needed, the acquire also covers chunks submitted after it.
+         * Otherwise semaphore wait alone makes copied potentials visible to shader. */
+        void recordCompute(
+            const vk::raii::CommandBuffer& commandBuffer,
+            ComputeBatchResources&         resources,
+            const ComputePipeline&         pipeline,
+            const VibwaPushConstants<FP>&  pushConstants,
+            const DeviceContext&           deviceContext,
+            const TimestampQueries&        timestamps,
+            uint32_t                       commandBufferIndex,
+            uint32_t                       firstPotential,
+            uint32_t                       potentialCount
+        ) {
+            commandBuffer.reset();
+            commandBuffer.begin(
+                vk::CommandBufferBeginInfo().setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit)
+            );
+            timestamps.recordBegin(
+                commandBuffer, TimestampQueries::Phase::Compute, commandBufferIndex
+            );
+            if (deviceContext.hasDedicatedTransferQueue() && firstPotential == 0) {
+                auto barriers = resources.getPotentialOwnershipTransfers(
+                    deviceContext.getTransferQueueFamilyIndex(), deviceContext.getQueueFamilyIndex()
+                );
+                for (auto& barrier : barriers) {
+                    barrier.setDstAccessMask(vk::AccessFlagBits::eShaderRead);
+                }
+                commandBuffer.pipelineBarrier(
+                    vk::PipelineStageFlagBits::eTopOfPipe,
+                    vk::PipelineStageFlagBits::eComputeShader,
+                    {},
+                    {},
+                    barriers,
+                    {}
+                );
+            }
+            commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, *pipeline.pipeline);
+            if (!resources.usesBufferDeviceAddress()) {
+                commandBuffer.bindDescriptorSets(
+                    vk::PipelineBindPoint::eCompute,
+                    *pipeline.pipelineLayout,
+                    0,
+                    resources.getVkDescriptorSets(),
+                    {}
+                );
+            }
+            commandBuffer.pushConstants<VibwaPushConstants<FP>>(
+                *pipeline.pipelineLayout, vk::ShaderStageFlagBits::eCompute, 0, pushConstants
+            );
+            // Workgroup index is index of potential within batch.
+            commandBuffer.dispatchBase(firstPotential, 0, 0, potentialCount, 1, 1);
+            // Make level energies visible to host reads after semaphore is signaled.
+            commandBuffer.pipelineBarrier(
+                vk::PipelineStageFlagBits::eComputeShader,
+                vk::PipelineStageFlagBits::eHost,
+                {},
+                vk::MemoryBarrier()
+                    .setSrcAccessMask(vk::AccessFlagBits::eShaderWrite)
+                    .setDstAccessMask(vk::AccessFlagBits::eHostRead),
+                {},
+                {}
+            );
+            timestamps.recordEnd(
+                commandBuffer, TimestampQueries::Phase::Compute, commandBufferIndex
+            );
+            commandBuffer.end();
+        }
 
-            for (auto i = 0; const auto& queue : physicalDevice.getQueueFamilyProperties()) {
-                if ((queue.queueFlags & vk::QueueFlagBits::eCompute) &&
-                    (queue.queueFlags & vk::QueueFlagBits::eTransfer)) {
-                    queue_family_index = i;
-                    break;
+        /* Allocate buffers and bind them to shader of plan.slotCount batches in flight. */
+        static std::vector<ComputeBatchResources> allocateSlots(
+            const VibwaBatchPlan&                             plan,
+            const std::vector<ShaderBuffersRequirements<FP>>& requirements,
+            DeviceContext&                                    deviceContext,
+            vk::DeviceSize                                    blockSize
+        ) {
+            const auto& logicalDevice = deviceContext.getDevice();
+
+            std::vector<ComputeBatchResources> slots{};
+            slots.reserve(plan.slotCount);
+            for (uint32_t slot = 0; slot < plan.slotCount; slot++) {
+                auto& resources = slots.emplace_back(
+                    ComputeBatchResources::create(deviceContext.getAllocator())
+                );
+                resources.allocateResources(
+                    requirements, plan.potentialsPerBuffer, deviceContext, blockSize
+                );
+                if (resources.usesBufferDeviceAddress()) {
+                    resources.createBufferTable(logicalDevice);
+                } else {
+                    resources.createDescriptorSets(logicalDevice);
+                    resources.updateDescriptorSets(logicalDevice);
+                }
+            }
+            return slots;
+        }
+
+        /* Check that potential curves can be processed within single task and return
+         * their point count. */
+        static uint32_t validatePotentials(
+            const PotentialView<FP>& potentials, const HardwareConfig<FP>& hardwareConfig
+        ) {
+            if (potentials.empty()) {
+                return 0;
+            }
+            return validatePointCount(potentials.getPointCount(), hardwareConfig);
+        }
+
+        /* Check that potentials of pointCount points fit into potential buffers and can
+         * be solved. */
+        static uint32_t
+        validatePointCount(size_t pointCount, const HardwareConfig<FP>& hardwareConfig) {
+            if (pointCount > hardwareConfig.getPotentialBufferSize()) {
+                throw std::runtime_error(fmt::format(
+                    "Potential point count {} exceeds potential buffer size {}.",
+                    pointCount,
+                    hardwareConfig.getPotentialBufferSize()
+                ));
+            }
+            // Matching point of Cooley's correction needs at least two points on both
+            // sides, see shaders/vibwa.comp.
+            if (pointCount < 6) {
+                throw std::runtime_error(
+                    fmt::format("Potential must have at least 6 points, got {}.", pointCount)
+                );
+            }
+            return static_cast<uint32_t>(pointCount);
+        }
+
+        static FP getReducedMassFactor(const VibwaAlgorithmConfig<FP>& config) {
+            const double massAtom0   = config.getMassAtom0();
+            const double massAtom1   = config.getMassAtom1();
+            const double reducedMass = (massAtom0 * massAtom1) / (massAtom0 + massAtom1);
+            return static_cast<FP>(kineticEnergyFactor / reducedMass);
+        }
+
+        /* Precision of shader used by task on given device, Float64 falls back to
+         * Float64Emulated on devices without shaderFloat64. */
+        static PrecisionType
+        selectStoragePrecision(PrecisionType requested, const DeviceContext& deviceContext) {
+            if (requested == PrecisionType::Float64 &&
+                !deviceContext.getEnabledFeatures().shaderFloat64) {
+                return PrecisionType::Float64Emulated;
+            }
+            if (requested == PrecisionType::Float16 && !deviceContext.isFloat16StorageEnabled()) {
+                throw std::runtime_error("Device doesn't support Float16 storage buffers.");
+            }
+            return requested;
+        }
+
+        /* Morse potentials can be evaluated by shader only when they share point count
+         * and are stored in FP, see selectStoragePrecision(). */
+        static bool canGenerateMorsePotentials(
+            const MorsePotentialGenerator<FP>& generator,
+            PrecisionType                      requested,
+            const vk::raii::PhysicalDevice&    physicalDevice
+        ) {
+            if (generator.configurations.empty() || requested != getPrecisionType<FP>() ||
+                !generator.hasUniformPointCount()) {
+                return false;
+            }
+            // Logical device enables shaderFloat64 whenever it is supported.
+            return std::is_same_v<FP, float> || physicalDevice.getFeatures().shaderFloat64;
+        }
+
+        /* Parameters of Morse potentials in order read by shader, morseParameterCount
+         * values for each potential. */
+        static std::vector<FP> getMorseParameters(const MorsePotentialGenerator<FP>& generator) {
+            std::vector<FP> parameters{};
+            parameters.reserve(generator.configurations.size() * morseParameterCount);
+            for (const auto& configuration : generator.configurations) {
+                parameters.insert(
+                    parameters.end(),
+                    {configuration.getDissociationEnergy(),
+                     configuration.getEquilibriumBondDistance(),
+                     configuration.getWellWidth(),
+                     configuration.getMinR(),
+                     configuration.getMaxR()}
+                );
+            }
+            return parameters;
+        }
+
+        /* Push constant value in representation expected by shader of given precision,
+         * emulated Float64 shaders read doubles as pairs of floats. */
+        static FP toShaderValue(FP value, PrecisionType storagePrecision) {
+            if constexpr (std::is_same_v<FP, double>) {
+                if (storagePrecision == PrecisionType::Float64Emulated) {
+                    return std::bit_cast<double>(common::double_to_float_pair(value));
                 }
-                i++;
             }
-            LIB_EPSEON_ASSERT_TRUE(queue_family_index != -1);
-            return queue_family_index;
+            return value;
+        }
+
+        /* Number of buffer sets (elements of descriptor arrays) which can be bound to
+         * single descriptor set. */
+        static uint32_t getMaxBufferSetCount(const vk::raii::PhysicalDevice& physicalDevice) {
+            const auto     limits                  = physicalDevice.getProperties().limits;
+            const uint32_t storageBuffersPerShader = gpuOnlyBufferCount + 1;
+
+            // One descriptor is taken by progress counters.
+            return std::min(
+                (limits.maxPerStageDescriptorStorageBuffers - 1) / storageBuffersPerShader,
+                (limits.maxDescriptorSetStorageBuffers - 1) / storageBuffersPerShader
+            );
+        }
+
+        /* Limits of physical device relevant to planBatches(), memory budgets are queried
+         * anew on every call. */
+        static VibwaDeviceLimits getDeviceLimits(
+            const vk::raii::PhysicalDevice& physicalDevice, const DeviceContext& deviceContext
+        ) {
+            const auto properties = physicalDevice.getProperties2<
+                vk::PhysicalDeviceProperties2,
+                vk::PhysicalDeviceMaintenance3Properties>();
+            const auto& limits = properties.get<vk::PhysicalDeviceProperties2>().properties.limits;
+            const auto  memoryProperties = physicalDevice.getMemoryProperties();
+
+            // Largest heap backing memory type with given property.
+            auto findLargestHeap = [&memoryProperties](vk::MemoryPropertyFlagBits property) {
+                std::optional<uint32_t> largest{};
+                for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+                    const auto& memoryType = memoryProperties.memoryTypes[i];
+                    if (!(memoryType.propertyFlags & property)) {
+                        continue;
+                    }
+                    if (!largest || memoryProperties.memoryHeaps[memoryType.heapIndex].size >
+                                        memoryProperties.memoryHeaps[*largest].size) {
+                        largest = memoryType.heapIndex;
+                    }
+                }
+                return largest;
+            };
+            const auto deviceLocalHeap = findLargestHeap(vk::MemoryPropertyFlagBits::eDeviceLocal);
+            const auto hostVisibleHeap = findLargestHeap(vk::MemoryPropertyFlagBits::eHostVisible);
+            if (!deviceLocalHeap || !hostVisibleHeap) {
+                throw std::runtime_error(
+                    "Device doesn't have device local or host visible memory."
+                );
+            }
+
+            const auto budgets   = deviceContext.getHeapBudgets();
+            auto       available = [&budgets](uint32_t heapIndex) {
+                const auto& budget = budgets[heapIndex];
+                return budget.budget > budget.usage ? budget.budget - budget.usage : 0;
+            };
+
+            return VibwaDeviceLimits{
+                .maxStorageBufferRange = limits.maxStorageBufferRange,
+                .maxMemoryAllocationSize =
+                    properties.get<vk::PhysicalDeviceMaintenance3Properties>()
+                        .maxMemoryAllocationSize,
+                .deviceLocalBudget = available(*deviceLocalHeap),
+                .hostVisibleBudget = available(*hostVisibleHeap),
+                .sharedHeap        = *deviceLocalHeap == *hostVisibleHeap,
+                .maxWorkGroupCount = limits.maxComputeWorkGroupCount[0],
+                .maxBufferSetCount = deviceContext.isBufferDeviceAddressEnabled()
+                                         ? UINT32_MAX
+                                         : getMaxBufferSetCount(physicalDevice)
+            };
+        }
+
+        /* Split potentialCount potentials into batches of at most groupSize potentials,
+         * such that no buffer exceeds maxStorageBufferRange nor maxMemoryAllocationSize,
+         * buffers of all batches in flight take at most maxBudgetUsage of memory budgets and
+         * batch doesn't need more buffer sets than descriptor arrays can hold. Buffers of
+         * each role are packed - all potentials of batch share single buffer, unless it
+         * would exceed limits. */
+        static VibwaBatchPlan planBatches(
+            const VibwaDeviceLimits&             limits,
+            const ShaderBuffersRequirements<FP>& requirements,
+            size_t                               groupSize,
+            size_t                               potentialCount
+        ) {
+            if (groupSize == 0) {
+                throw std::runtime_error("Group size must be greater than zero.");
+            }
+            if (potentialCount == 0) {
+                return VibwaBatchPlan{};
+            }
+
+            // Requirements of single potential, 64 bit to avoid overflow for large groups.
+            const vk::DeviceSize stagingBytes =
+                vk::DeviceSize{requirements.stagingBuffersElementCount} *
+                requirements.getStorageElementSizeBytes();
+            const vk::DeviceSize gpuOnlyBytes =
+                vk::DeviceSize{requirements.gpuOnlyStorageBuffersElementCount} *
+                requirements.getStorageElementSizeBytes();
+            const vk::DeviceSize outputBytes =
+                vk::DeviceSize{requirements.outputBuffersElementCount} * sizeof(FP);
+            const vk::DeviceSize largestBufferBytes =
+                std::max({stagingBytes, gpuOnlyBytes, outputBytes, vk::DeviceSize{1}});
+            const vk::DeviceSize maxBufferBytes =
+                std::min(limits.maxStorageBufferRange, limits.maxMemoryAllocationSize);
+
+            if (largestBufferBytes > maxBufferBytes) {
+                throw std::runtime_error(fmt::format(
+                    "Buffers of single potential need {} bytes, but device allows only {}.",
+                    largestBufferBytes,
+                    maxBufferBytes
+                ));
+            }
+
+            const vk::DeviceSize deviceLocalBytes =
+                requirements.getGpuOnlyStorageBufferSizeBytes();
+            const vk::DeviceSize hostVisibleBytes =
+                requirements.getStagingBuffersSizeBytes() + requirements.getOutputBufferSizeBytes();
+
+            // Potentials of all batches in flight fitting into memory budget.
+            auto fitting = [](vk::DeviceSize budget, vk::DeviceSize bytesPerPotential) {
+                const auto available =
+                    static_cast<vk::DeviceSize>(static_cast<double>(budget) * maxBudgetUsage);
+                return bytesPerPotential == 0 ? UINT64_MAX : available / bytesPerPotential;
+            };
+            uint64_t potentialsInFlight = 0;
+            if (limits.sharedHeap) {
+                potentialsInFlight = fitting(
+                    std::max(limits.deviceLocalBudget, limits.hostVisibleBudget),
+                    deviceLocalBytes + hostVisibleBytes
+                );
+            } else {
+                potentialsInFlight = std::min(
+                    fitting(limits.deviceLocalBudget, deviceLocalBytes),
+                    fitting(limits.hostVisibleBudget, hostVisibleBytes)
+                );
+            }
+            const uint64_t memoryLimit = potentialsInFlight / batchesInFlight;
+            if (memoryLimit == 0) {
+                throw std::runtime_error(fmt::format(
+                    "Buffers of {} potentials don't fit into available device memory.",
+                    batchesInFlight
+                ));
+            }
+
+            VibwaBatchPlan plan{};
+
+            uint64_t potentialsPerBatch = std::min<uint64_t>(
+                {groupSize, potentialCount, limits.maxWorkGroupCount, memoryLimit}
+            );
+            const uint64_t maxPotentialsPerBuffer = maxBufferBytes / largestBufferBytes;
+            // Descriptor arrays limit number of buffers, not potentials.
+            potentialsPerBatch = std::min<uint64_t>(
+                potentialsPerBatch, limits.maxBufferSetCount * maxPotentialsPerBuffer
+            );
+            // Potentials are spread evenly among buffer sets. Buffers are allocated for
+            // whole sets, so batch shrinks if rounding would exceed memory limit.
+            const uint64_t bufferSetCount =
+                (potentialsPerBatch + maxPotentialsPerBuffer - 1) / maxPotentialsPerBuffer;
+            uint64_t potentialsPerBuffer =
+                (potentialsPerBatch + bufferSetCount - 1) / bufferSetCount;
+            if (bufferSetCount * potentialsPerBuffer > memoryLimit) {
+                potentialsPerBuffer = memoryLimit / bufferSetCount;
+                potentialsPerBatch  = bufferSetCount * potentialsPerBuffer;
+            }
+
+            plan.potentialsPerBatch  = static_cast<uint32_t>(potentialsPerBatch);
+            plan.potentialsPerBuffer = static_cast<uint32_t>(potentialsPerBuffer);
+            plan.bufferSetCount      = static_cast<uint32_t>(bufferSetCount);
+            plan.batchCount = (potentialCount + potentialsPerBatch - 1) / potentialsPerBatch;
+            plan.slotCount  = static_cast<uint32_t>(
+                std::min<size_t>(batchesInFlight, plan.batchCount)
+            );
+
+            // Buffers are allocated for whole buffer sets.
+            const vk::DeviceSize slotPotentials =
+                vk::DeviceSize{plan.bufferSetCount} * plan.potentialsPerBuffer * plan.slotCount;
+            plan.deviceLocalBytes = slotPotentials * deviceLocalBytes;
+            plan.hostVisibleBytes = slotPotentials * hostVisibleBytes;
+            return plan;
         }
 
-        vk::raii::Device createLogicalDevice(const vk::raii::PhysicalDevice& physicalDevice) {
-            // Exclusive transfer Queue in some GPUs, we may use it in
-            // future.
-            uint32_t             queue_index      = selectQueueFamilyIndex(physicalDevice);
-            std::array<float, 1> queue_priorities = {1.0F};
-            std::vector<vk::DeviceQueueCreateInfo> queueCreateInfos{
-                vk::DeviceQueueCreateInfo()
-                    .setQueueFamilyIndex(queue_index)
-                    .setQueueCount(1)
-                    .setPQueuePriorities(queue_priorities.data())
+        /* Buffers needed by shaders of task, one element per potential of group. All
+         * shaders have the same requirements. */
+        static std::vector<ShaderBuffersRequirements<FP>>
+        getShaderBufferRequirements(const TaskConfigurator<FP>& configurator) {
+            const auto algorithmConfig = std::dynamic_pointer_cast<VibwaAlgorithmConfig<FP>>(
+                configurator.getAlgorithmConfig()
+            );
+            if (!algorithmConfig) {
+                throw std::runtime_error("VibwaAlgorithm requires VibwaAlgorithmConfig.");
+            }
+            const uint32_t groupSize = configurator.getHardwareConfig()->getGroupSize();
+            // Rounded up like rows of potential buffers, so that they fit into slots with
+            // their padding, see getPotentialSlotStride().
+            const uint32_t bufferElementCount = static_cast<uint32_t>(std::min<size_t>(
+                getAlignedRowStride<FP>(configurator.getHardwareConfig()->getPotentialBufferSize()),
+                UINT32_MAX
+            ));
+
+            const auto shaderRequirements = ShaderBuffersRequirements<FP>{
+                .stagingBuffersCount               = 1,
+                .stagingBuffersElementCount        = bufferElementCount,
+                // Potential and Numerov factors, see shaders/vibwa.comp.
+                .gpuOnlyStorageBuffersCount        = gpuOnlyBufferCount,
+                .gpuOnlyStorageBuffersElementCount = bufferElementCount,
+                .outputBuffersCount                = 1,
+                .outputBuffersElementCount         = algorithmConfig->getLevelCount(),
+                .storagePrecision                  = configurator.getStoragePrecision()
             };
+            return std::vector<ShaderBuffersRequirements<FP>>(groupSize, shaderRequirements);
+        }
 
-            std::vector<const char*> required_device_extensions{};
+        /* Distance in values between potential slots of staging and GPU only buffers. Slots
+         * take row stride of curves when they are stored in storage precision and their
+         * rows fit into maxStride values, so that uploadPotentials() copies curves of whole
+         * batch at once. */
+        static uint32_t getPotentialSlotStride(
+            const PotentialView<FP>& potentials, uint32_t maxStride, PrecisionType storagePrecision
+        ) {
+            if (storagePrecision == getPrecisionType<FP>() && !potentials.empty() &&
+                potentials.getRowStride() >= potentials.getPointCount() &&
+                potentials.getRowStride() <= maxStride) {
+                return static_cast<uint32_t>(potentials.getRowStride());
+            }
+            return maxStride;
+        }
+
+        /* Curves can be written to slots potentialStride values apart with single copy,
+         * padding between them included. */
+        static bool canCopyPotentialsAtOnce(
+            const PotentialView<FP>& potentials,
+            uint32_t                 potentialStride,
+            PrecisionType            storagePrecision
+        ) {
+            return storagePrecision == getPrecisionType<FP>() &&
+                   (potentials.size() <= 1 || potentials.getRowStride() == potentialStride);
+        }
+
+        /* Plan how task would be split into batches if it was started now, with memory
+         * budgets of device at the moment. Task itself plans again when it starts, as
+         * budgets change over time. */
+        static VibwaBatchPlan planTask(
+            const vk::raii::PhysicalDevice& physicalDevice,
+            const DeviceContext&            deviceContext,
+            const TaskConfigurator<FP>&     configurator
+        ) {
+            if (!configurator.isConfigured()) {
+                throw std::runtime_error(
+                    "TaskConfigurator wasn't fully configured before planning."
+                );
+            }
+            if (!std::dynamic_pointer_cast<VibwaAlgorithmConfig<FP>>(
+                    configurator.getAlgorithmConfig()
+                )) {
+                throw std::runtime_error("Only tasks using VIBWA algorithm can be planned.");
+            }
+            const auto requirements = getShaderBufferRequirements(configurator);
+            if (requirements.empty()) {
+                throw std::runtime_error("Group size must be greater than zero.");
+            }
+            return planBatches(
+                getDeviceLimits(physicalDevice, deviceContext),
+                requirements.front(),
+                requirements.size(),
+                configurator.getPotentialSource()->get_potential_count()
+            );
+        }
+
+        /* Largest workgroup size allowed by device. Shader uses no shared memory, so
+         * only invocation limits apply. */
+        static uint32_t getMaxWorkgroupSize(const vk::PhysicalDeviceLimits& limits) {
+            return std::min(
+                limits.maxComputeWorkGroupSize[0], limits.maxComputeWorkGroupInvocations
+            );
+        }
 
-            auto logicalDevice = physicalDevice.createDevice(
-                vk::DeviceCreateInfo()
-                    .setQueueCreateInfos(queueCreateInfos)
-                    .setPEnabledExtensionNames(required_device_extensions)
+        /* Workgroup size requested by hardware config, defaultWorkgroupSize if it is 0,
+         * clamped to device limits. */
+        static uint32_t
+        getWorkgroupSize(const vk::raii::PhysicalDevice& physicalDevice, uint32_t requested) {
+            const uint32_t workgroupSize = requested == 0 ? defaultWorkgroupSize : requested;
+            return std::min(
+                workgroupSize, getMaxWorkgroupSize(physicalDevice.getProperties().limits)
             );
-            return std::move(logicalDevice);
         }
 
         std::vector<vk::raii::DescriptorSet> allocateDescriptorSets(
@@ -0,0 +1,315 @@
+#pragma once
+
+#include "epseon/vulkan_headers.hpp"
+
+#include "epseon/gpu/predecl.hpp"
+
+#include "epseon/gpu/algorithms/vibwa.hpp"
+#include "epseon/gpu/device_interface.hpp"
+#include "epseon/gpu/enums.hpp"
+#include "epseon/gpu/task_handle.hpp"
+#include "epseon/task_configurator/algorithm_config.hpp"
+#include "epseon/task_configurator/hardware_config.hpp"
+#include "epseon/task_configurator/potential_source.hpp"
+#include "fmt/format.h"
+#include "spdlog/logger.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <compare>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace epseon::gpu::cpp {
+
+    /* Shape of task autotuning results apply to. */
+    struct AutotuneKey {
+        PrecisionType precision  = {};
+        uint32_t      pointCount = {};
+        uint32_t      levelCount = {};
+
+        auto operator<=>(const AutotuneKey&) const = default;
+    };
+
+    /* Hardware settings selected by autotuning. */
+    struct AutotuneResult {
+        uint32_t groupSize     = {};
+        uint32_t workgroupSize = {};
+
+        bool operator==(const AutotuneResult&) const = default;
+    };
+
+    /* Persistent store for autotuning results of single physical device.
+     *
+     * Results are kept in text file named after deviceUUID of device, in the same
+     * directory as pipeline caches. Unlike pipeline cache data they don't depend on
+     * driver version, so they survive driver updates. File is read again when result is
+     * missing, so that results found by other interfaces to the same device are reused,
+     * I/O errors are only logged, as lack of cache only makes autotuning run again.
+     */
+    class AutotuneCache {
+      private: /* Private members. */
+        std::shared_ptr<spdlog::logger>       logger  = {};
+        std::filesystem::path                 path    = {};
+        mutable std::mutex                    mutex   = {};
+        std::map<AutotuneKey, AutotuneResult> entries = {};
+
+      public: /* Public constructors. */
+        AutotuneCache(
+            std::shared_ptr<spdlog::logger>          logger_,
+            const std::filesystem::path&             directory,
+            const std::array<uint8_t, VK_UUID_SIZE>& deviceUUID
+        );
+
+        // Copy constructor.
+        AutotuneCache(const AutotuneCache&) = delete;
+
+        // Copy assignment operator.
+        AutotuneCache& operator=(const AutotuneCache&) = delete;
+
+        // Move constructor.
+        AutotuneCache(AutotuneCache&&) = delete;
+
+        // Move assignment operator.
+        AutotuneCache& operator=(AutotuneCache&&) = delete;
+
+      public: /* Public destructor. */
+        ~AutotuneCache() = default;
+
+      public: /* Public methods. */
+        /* Name of cache file, hex encoded deviceUUID. */
+        static std::string getFileName(const std::array<uint8_t, VK_UUID_SIZE>&);
+
+        [[nodiscard]] const std::filesystem::path& getPath() const {
+            return this->path;
+        }
+
+        /* Stored result for given task shape, if any. */
+        [[nodiscard]] std::optional<AutotuneResult> get(const AutotuneKey&);
+
+        /* Store result and save all results to disk, merged with results saved there by
+         * other instances. */
+        void store(const AutotuneKey&, const AutotuneResult&);
+
+      private: /* Private methods. */
+        // Both expect mutex to be locked.
+        void load();
+        void save() const;
+    };
+
+    /* Micro-benchmark of VIBWA tasks on single device selecting workgroup size and group
+     * size (potentials per batch) which give the highest throughput.
+     *
+     * Benchmark tasks solve synthetic Morse potentials of requested shape. Workgroup
+     * sizes are tuned first with fixed group size, as every level is solved by single
+     * invocation and workgroups wider than level count only idle, then group sizes with
+     * the best workgroup size. The smallest group size within groupSizeTolerance of the
+     * best throughput wins, as smaller batches need less memory.
+     */
+    template <typename FP>
+    class Autotuner {
+      public: /* Public constants. */
+        static constexpr uint32_t minWorkgroupSize   = 8;
+        static constexpr uint32_t minGroupSize       = 64;
+        // Group size used while workgroup sizes are tuned.
+        static constexpr uint32_t baseGroupSize      = 1024;
+        // Upper bound of potential points solved by single benchmark task.
+        static constexpr uint64_t maxBenchmarkPoints = uint64_t{1} << 25U;
+        static constexpr uint32_t repetitions        = 2;
+        static constexpr double   groupSizeTolerance = 0.95;
+
+      private: /* Private members. */
+        std::shared_ptr<ComputeDeviceInterface> device     = {};
+        uint32_t                                pointCount = {};
+        uint32_t                                levelCount = {};
+
+      public: /* Public constructors. */
+        Autotuner(
+            std::shared_ptr<ComputeDeviceInterface> device_,
+            uint32_t                                pointCount_,
+            uint32_t                                levelCount_
+        ) :
+            device(std::move(device_)),
+            pointCount(pointCount_),
+            levelCount(levelCount_) {
+            if (this->pointCount < 6) {
+                throw std::runtime_error(fmt::format(
+                    "Potential must have at least 6 points, got {}.", this->pointCount
+                ));
+            }
+            if (this->levelCount == 0) {
+                throw std::runtime_error("Level count must be greater than zero.");
+            }
+        }
+
+      public: /* Public methods. */
+        /* Powers of two from minWorkgroupSize up to level count rounded up, within device
+         * limits. */
+        static std::vector<uint32_t>
+        getWorkgroupSizeCandidates(const vk::PhysicalDeviceLimits& limits, uint32_t levelCount) {
+            const uint32_t maxSize = std::min(
+                VibwaAlgorithm<FP>::getMaxWorkgroupSize(limits),
+                std::max(minWorkgroupSize, std::bit_ceil(levelCount))
+            );
+            std::vector<uint32_t> candidates{};
+            for (uint32_t size = minWorkgroupSize; size <= maxSize; size *= 2) {
+                candidates.push_back(size);
+            }
+            if (candidates.empty()) {
+                candidates.push_back(maxSize);
+            }
+            return candidates;
+        }
+
+        /* Group sizes growing four times from minGroupSize up to maxGroupSize, which is
+         * always included. */
+        static std::vector<uint32_t> getGroupSizeCandidates(uint32_t maxGroupSize) {
+            std::vector<uint32_t> candidates{};
+            for (uint64_t size = minGroupSize; size < maxGroupSize; size *= 4) {
+                candidates.push_back(static_cast<uint32_t>(size));
+            }
+            candidates.push_back(maxGroupSize);
+            return candidates;
+        }
+
+        /* Run benchmarks, it takes from seconds to minutes depending on device. */
+        AutotuneResult tune() {
+            const auto& physicalDevice = this->device->getPhysicalDevice();
+            const auto  limits         = physicalDevice.getProperties().limits;
+
+            // Largest batch device can hold.
+            const auto requirements =
+                VibwaAlgorithm<FP>::getShaderBufferRequirements(*this->configure(1, 0, 0));
+            const auto plan = VibwaAlgorithm<FP>::planBatches(
+                VibwaAlgorithm<FP>::getDeviceLimits(
+                    physicalDevice, *this->device->getDeviceContext()
+                ),
+                requirements.front(),
+                std::numeric_limits<uint32_t>::max(),
+                std::numeric_limits<uint32_t>::max()
+            );
+            // Benchmark tasks have two batches per slot, so that transfers overlap with
+            // computation as in real tasks.
+            const uint64_t benchmarkLimit =
+                maxBenchmarkPoints /
+                (uint64_t{this->pointCount} * VibwaAlgorithm<FP>::batchesInFlight * 2);
+            const auto maxGroupSize = static_cast<uint32_t>(std::max<uint64_t>(
+                1, std::min<uint64_t>(plan.potentialsPerBatch, benchmarkLimit)
+            ));
+
+            AutotuneResult best{
+                .groupSize     = std::min(baseGroupSize, maxGroupSize),
+                .workgroupSize = 0
+            };
+            double bestThroughput = 0.0;
+            for (const auto workgroupSize : getWorkgroupSizeCandidates(limits, this->levelCount)) {
+                const double throughput = this->benchmark(best.groupSize, workgroupSize);
+                if (throughput > bestThroughput) {
+                    bestThroughput     = throughput;
+                    best.workgroupSize = workgroupSize;
+                }
+            }
+
+            std::vector<std::pair<uint32_t, double>> measured{};
+            for (const auto groupSize : getGroupSizeCandidates(maxGroupSize)) {
+                measured.emplace_back(groupSize, this->benchmark(groupSize, best.workgroupSize));
+            }
+            const double maxThroughput =
+                std::max_element(measured.begin(), measured.end(), [](auto lhs, auto rhs) {
+                    return lhs.second < rhs.second;
+                })->second;
+            for (const auto& [groupSize, throughput] : measured) {
+                if (throughput >= groupSizeTolerance * maxThroughput) {
+                    best.groupSize = groupSize;
+                    break;
+                }
+            }
+            return best;
+        }
+
+      private: /* Private methods. */
+        std::shared_ptr<TaskConfigurator<FP>>
+        configure(uint32_t groupSize, uint32_t workgroupSize, uint32_t potentialCount) const {
+            std::vector<MorsePotentialConfig<FP>> potentials{};
+            potentials.reserve(potentialCount);
+            for (uint32_t i = 0; i < potentialCount; i++) {
+                potentials.emplace_back(
+                    static_cast<FP>(5000.0 + 10.0 * (i % 100)),
+                    static_cast<FP>(2.0),
+                    static_cast<FP>(1.0),
+                    static_cast<FP>(1.0),
+                    static_cast<FP>(10.0),
+                    this->pointCount
+                );
+            }
+            const double integrationStep = 9.0 / (this->pointCount - 1);
+
+            auto cfg = this->device->template getTaskConfigurator<FP>();
+            cfg->setHardwareConfig(std::make_shared<HardwareConfig<FP>>(
+                   this->pointCount, groupSize, 0, workgroupSize
+            ))
+                .setAlgorithmConfig(std::make_shared<VibwaAlgorithmConfig<FP>>(
+                    87.62, 87.62, integrationStep, 0.1, 0, this->levelCount - 1
+                ))
+                .setPotentialSource(
+                    std::make_shared<MorsePotentialGenerator<FP>>(std::move(potentials))
+                );
+            return cfg;
+        }
+
+        /* Potentials solved per second with given settings, best of repetitions. First
+         * run with new settings also creates their pipeline, following ones load it from
+         * pipeline cache. */
+        double benchmark(uint32_t groupSize, uint32_t workgroupSize) const {
+            const uint32_t potentialCount = groupSize * VibwaAlgorithm<FP>::batchesInFlight * 2;
+
+            auto fastest = std::chrono::duration<double>::max();
+            for (uint32_t i = 0; i < repetitions; i++) {
+                auto handle = this->device->submitTask(
+                    this->configure(groupSize, workgroupSize, potentialCount)
+                );
+                handle->startWorker();
+                handle->wait();
+                // Rethrows errors of worker thread.
+                handle->getLevelCount();
+                fastest = std::min(fastest, handle->getElapsedTime());
+            }
+            return static_cast<double>(potentialCount) / std::max(fastest.count(), 1e-9);
+        }
+    };
+
+    template <typename FP>
+    std::shared_ptr<HardwareConfig<FP>> ComputeDeviceInterface::autotuneHardwareConfig(
+        uint32_t pointCount, uint32_t levelCount, bool useCache
+    ) {
+        const AutotuneKey key{
+            .precision  = getPrecisionType<FP>(),
+            .pointCount = pointCount,
+            .levelCount = levelCount
+        };
+        // Benchmarks running concurrently on the same device would disturb each other.
+        std::lock_guard<std::mutex> lock{this->autotuneMutex};
+
+        std::optional<AutotuneResult> result{};
+        if (useCache) {
+            result = this->autotuneCache->get(key);
+        }
+        if (!result) {
+            result = Autotuner<FP>{this->shared_from_this(), pointCount, levelCount}.tune();
+            this->autotuneCache->store(key, *result);
+        }
+        return std::make_shared<HardwareConfig<FP>>(
+            pointCount, result->groupSize, 0, result->workgroupSize
+        );
+    }
+} // namespace epseon::gpu::cpp
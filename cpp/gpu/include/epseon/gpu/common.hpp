@@ -1,12 +1,39 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <filesystem>
+#include <span>
 #include <string>
+#include <system_error>
 
 namespace epseon {
     namespace gpu {
         namespace common {
             std::string vulkan_version_to_string(uint32_t);
-        }
-    } // namespace gpu
+
+            /* Bits of IEEE 754 half precision value nearest to given float, ties to even.
+             * Values out of half range become infinities. */
+            uint16_t float_to_float16_bits(float);
+
+            /* Float equal to half precision value with given bits. */
+            float float16_bits_to_float(uint16_t);
+
+            /* Double split into unevaluated sum of two floats, nearest float first, as used
+             * by emulated Float64 shaders. Non finite values have zero low part. */
+            std::array<float, 2> double_to_float_pair(double);
+
+            /* Double nearest to sum of float pair. */
+            double float_pair_to_double(const std::array<float, 2>&);
+
+            /* Replace contents of file at path with data, creating missing parent
+             * directories. Data is written to temporary file with name unique to this
+             * writer and renamed over path, so readers, including other processes, see
+             * either old or new contents, never mix of concurrent writes. Returns error
+             * of failed step, temporary file is removed on failure. */
+            std::error_code
+            write_file_atomically(const std::filesystem::path&, std::span<const std::byte>);
+        } // namespace common
+    }     // namespace gpu
 } // namespace epseon
@@ -6,6 +6,7 @@
 
 #include "spdlog/logger.h"
 #include <cstdint>
+#include <filesystem>
 #include <iostream>
 #include <memory>
 #include <optional>
@@ -16,14 +17,16 @@ namespace epseon::gpu::cpp {
 
     struct ComputeContextState {
       public: /* Public members. */
-        std::shared_ptr<spdlog::logger>      logger           = {};
-        std::shared_ptr<vk::raii::Context>   context          = {};
-        std::shared_ptr<vk::ApplicationInfo> application_info = {};
-        std::shared_ptr<vk::raii::Instance>  instance         = {};
+        std::shared_ptr<spdlog::logger>      logger                 = {};
+        std::shared_ptr<vk::raii::Context>   context                = {};
+        std::shared_ptr<vk::ApplicationInfo> application_info       = {};
+        std::shared_ptr<vk::raii::Instance>  instance               = {};
+        // Directory where pipeline caches of devices are stored.
+        std::filesystem::path                pipelineCacheDirectory = {};
 
       public: /* Public constructors. */
         ComputeContextState(ComputeContextState&);
-        ComputeContextState(std::shared_ptr<spdlog::logger>, std::shared_ptr<vk::raii::Context>, std::shared_ptr<vk::ApplicationInfo>, std::shared_ptr<vk::raii::Instance>);
+        ComputeContextState(std::shared_ptr<spdlog::logger>, std::shared_ptr<vk::raii::Context>, std::shared_ptr<vk::ApplicationInfo>, std::shared_ptr<vk::raii::Instance>, std::filesystem::path);
 
       public: /* Public destructor. */
         ~ComputeContextState() = default;
@@ -36,6 +39,10 @@ namespace epseon::gpu::cpp {
         [[nodiscard]] uint32_t getVulkanApiVersion() const {
             return this->application_info->apiVersion;
         }
+
+        [[nodiscard]] const std::filesystem::path& getPipelineCacheDirectory() const {
+            return this->pipelineCacheDirectory;
+        }
     };
 
     struct PhysicalDeviceInfo {
@@ -46,6 +53,8 @@ namespace epseon::gpu::cpp {
 
     class ComputeDeviceInterface;
 
+    class MultiDeviceInterface;
+
     class ComputeContext {
       private:
         std::shared_ptr<ComputeContextState> state;
@@ -55,19 +64,29 @@ namespace epseon::gpu::cpp {
             std::shared_ptr<spdlog::logger>      logger_,
             std::shared_ptr<vk::raii::Context>   context_,
             std::shared_ptr<vk::ApplicationInfo> application_info_,
-            std::shared_ptr<vk::raii::Instance>  instance_
+            std::shared_ptr<vk::raii::Instance>  instance_,
+            std::filesystem::path                pipelineCacheDirectory_
         );
 
       public: /* Public destructor. */
         virtual ~ComputeContext() = default;
 
       public: /* Public factory method. */
-        static std::shared_ptr<ComputeContext>
-        create(uint32_t version = VK_MAKE_API_VERSION(0, 0, 1, 0));
+        /* Pipeline caches are stored in pipelineCacheDirectory, by default in directory
+         * returned by PipelineCache::getDefaultDirectory(). */
+        static std::shared_ptr<ComputeContext> create(
+            uint32_t                             version = VK_MAKE_API_VERSION(0, 0, 1, 0),
+            std::optional<std::filesystem::path> pipelineCacheDirectory = std::nullopt
+        );
 
       public: /* Public methods. */
         std::string                             getVulkanAPIVersion();
         std::vector<PhysicalDeviceInfo>         getPhysicalDevicesInfo();
         std::shared_ptr<ComputeDeviceInterface> getDeviceInterface(uint32_t);
+
+        /* Interface splitting tasks between devices with given IDs, all available
+         * devices if none are given. ID may repeat, device is then opened repeatedly. */
+        std::shared_ptr<MultiDeviceInterface>
+        getMultiDeviceInterface(const std::vector<uint32_t>& deviceIds = {});
     };
 } // namespace epseon::gpu::cpp
@@ -0,0 +1,240 @@
+#pragma once
+
+#include "epseon/vulkan_headers.hpp"
+
+#include "epseon/gpu/predecl.hpp"
+
+#include "spdlog/logger.h"
+#include "vk_mem_alloc_handles.hpp"
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace vma::raii {
+    class Allocator : public vma::Allocator { // NOLINT: hicpp-special-member-functions
+      public:
+        using vma::Allocator::Allocator;
+
+        ~Allocator() {
+            this->destroy();
+        }
+    };
+} // namespace vma::raii
+
+namespace epseon::gpu::cpp {
+
+    /* Logical device of single physical device together with objects which are expensive
+     * to create - queues, memory allocator, pipeline cache and command pools. It is
+     * created once per ComputeDeviceInterface and shared by all tasks submitted to it,
+     * possibly running concurrently in different threads.
+     *
+     * Device, allocator, memory pools and pipeline cache can be used from multiple threads
+     * as they are.
+     * Access to queues, which Vulkan requires to be externally synchronized, goes through
+     * submit() and submitTransfer(). Command pools are externally synchronized too,
+     * therefore each task leases its own pool with acquireCommandPool().
+     *
+     * If device has transfer only queue family (usually backed by DMA engine) it gets
+     * its own queue used for copies. Otherwise transfer queue is the compute queue and
+     * both family indices are equal.
+     */
+    class DeviceContext : public std::enable_shared_from_this<DeviceContext> {
+      public: /* Public types. */
+        /* Command pool used exclusively by single task, returned to DeviceContext for
+         * reuse when lease is destroyed. All command buffers allocated from the pool must
+         * be destroyed before lease. */
+        class CommandPoolLease {
+          private: /* Private members. */
+            std::shared_ptr<DeviceContext>         owner            = {};
+            uint32_t                               queueFamilyIndex = {};
+            std::unique_ptr<vk::raii::CommandPool> pool             = {};
+
+          public: /* Public constructors. */
+            CommandPoolLease(
+                std::shared_ptr<DeviceContext>         owner_,
+                uint32_t                               queueFamilyIndex_,
+                std::unique_ptr<vk::raii::CommandPool> pool_
+            );
+
+            // Copy constructor.
+            CommandPoolLease(const CommandPoolLease&) = delete;
+
+            // Copy assignment operator.
+            CommandPoolLease& operator=(const CommandPoolLease&) = delete;
+
+            // Move constructor.
+            CommandPoolLease(CommandPoolLease&&) noexcept = default;
+
+            // Move assignment operator.
+            CommandPoolLease& operator=(CommandPoolLease&&) noexcept = delete;
+
+          public: /* Public destructor. */
+            ~CommandPoolLease();
+
+          public: /* Public methods. */
+            [[nodiscard]] const vk::raii::CommandPool& operator*() const {
+                return *this->pool;
+            }
+
+            [[nodiscard]] const vk::raii::CommandPool* operator->() const {
+                return this->pool.get();
+            }
+        };
+
+      private: /* Private members. */
+        std::shared_ptr<spdlog::logger> logger                     = {};
+        vk::PhysicalDeviceFeatures      enabledFeatures            = {};
+        uint32_t                        queueFamilyIndex           = {};
+        std::optional<uint32_t>         transferQueueFamilyIndex   = {};
+        bool                            bufferDeviceAddressEnabled = false;
+        bool                            memoryBudgetEnabled        = false;
+        bool                            float16StorageEnabled      = false;
+        bool                            hostQueryResetEnabled      = false;
+        // Order of members matters - allocator, pipeline cache and command pools have to
+        // be destroyed before device.
+        vk::raii::Device                      device             = nullptr;
+        vk::raii::Queue                       queue              = nullptr;
+        std::mutex                            queueMutex         = {};
+        vk::raii::Queue                       transferQueue      = nullptr;
+        std::mutex                            transferQueueMutex = {};
+        std::shared_ptr<vma::raii::Allocator> allocator          = {};
+        vk::raii::PipelineCache               pipelineCache      = nullptr;
+
+        // Idle command pools by queue family index.
+        std::mutex commandPoolsMutex = {};
+        std::map<uint32_t, std::vector<std::unique_ptr<vk::raii::CommandPool>>> commandPools =
+            {};
+
+        // Custom VMA pools by memory type index and block size.
+        std::mutex                                               memoryPoolsMutex = {};
+        std::map<std::pair<uint32_t, vk::DeviceSize>, vma::Pool> memoryPools      = {};
+
+      public: /* Public constructors. */
+        DeviceContext(
+            const ComputeContextState&      computeContextState,
+            const vk::raii::PhysicalDevice& physicalDevice,
+            const PipelineCache&            pipelineCache_
+        );
+
+        // Copy constructor.
+        DeviceContext(const DeviceContext&) = delete;
+
+        // Copy assignment operator.
+        DeviceContext& operator=(const DeviceContext&) = delete;
+
+        // Move constructor.
+        DeviceContext(DeviceContext&&) = delete;
+
+        // Move assignment operator.
+        DeviceContext& operator=(DeviceContext&&) = delete;
+
+      public: /* Public destructor. */
+        ~DeviceContext();
+
+      public: /* Public methods. */
+        [[nodiscard]] const vk::raii::Device& getDevice() const {
+            return this->device;
+        }
+
+        /* Features enabled for device, optional ones (e.g. shaderFloat64) are enabled
+         * whenever physical device supports them. */
+        [[nodiscard]] const vk::PhysicalDeviceFeatures& getEnabledFeatures() const {
+            return this->enabledFeatures;
+        }
+
+        /* Whether VK_KHR_buffer_device_address was enabled, it is whenever physical
+         * device supports it. Allocator is created with matching flag then. */
+        [[nodiscard]] bool isBufferDeviceAddressEnabled() const {
+            return this->bufferDeviceAddressEnabled;
+        }
+
+        /* Whether 16 bit storage buffer access was enabled, it is whenever physical
+         * device supports it. Needed by tasks with Float16 storage precision. */
+        [[nodiscard]] bool isFloat16StorageEnabled() const {
+            return this->float16StorageEnabled;
+        }
+
+        /* Whether VK_EXT_host_query_reset was enabled, it is whenever physical device
+         * supports it. Lets tasks reset timestamp queries used on transfer only queue,
+         * which can't reset them in command buffers. */
+        [[nodiscard]] bool isHostQueryResetEnabled() const {
+            return this->hostQueryResetEnabled;
+        }
+
+        /* Whether VK_EXT_memory_budget was enabled, see getHeapBudgets(). */
+        [[nodiscard]] bool isMemoryBudgetEnabled() const {
+            return this->memoryBudgetEnabled;
+        }
+
+        [[nodiscard]] uint32_t getQueueFamilyIndex() const {
+            return this->queueFamilyIndex;
+        }
+
+        /* Family of queue used by submitTransfer(), same as getQueueFamilyIndex() unless
+         * device has dedicated transfer queue. */
+        [[nodiscard]] uint32_t getTransferQueueFamilyIndex() const {
+            return this->transferQueueFamilyIndex.value_or(this->queueFamilyIndex);
+        }
+
+        [[nodiscard]] bool hasDedicatedTransferQueue() const {
+            return this->transferQueueFamilyIndex.has_value();
+        }
+
+        [[nodiscard]] const std::shared_ptr<vma::raii::Allocator>& getAllocator() const {
+            return this->allocator;
+        }
+
+        [[nodiscard]] const vk::raii::PipelineCache& getPipelineCache() const {
+            return this->pipelineCache;
+        }
+
+        /* Budget and usage of each memory heap. With memory budget enabled they account
+         * for memory used by other processes, otherwise VMA estimates budget as 80% of
+         * heap size and usage includes only this process. */
+        [[nodiscard]] std::vector<vma::Budget> getHeapBudgets() const;
+
+        /* Create timeline semaphore, used to order batches of a task in flight. */
+        [[nodiscard]] vk::raii::Semaphore createTimelineSemaphore(uint64_t initialValue = 0) const;
+
+        /* Block until timeline semaphore reaches value. */
+        void waitForTimelineSemaphore(const vk::raii::Semaphore&, uint64_t value) const;
+
+        /* Block until timeline semaphore reaches value or timeout expires, false on
+         * timeout. */
+        [[nodiscard]] bool waitForTimelineSemaphore(
+            const vk::raii::Semaphore&, uint64_t value, std::chrono::nanoseconds timeout
+        ) const;
+
+        /* Submit work to compute queue, safe to call from multiple threads. */
+        void submit(const vk::SubmitInfo&, vk::Fence);
+
+        /* Submit work to transfer queue, safe to call from multiple threads. */
+        void submitTransfer(const vk::SubmitInfo&, vk::Fence);
+
+        /* Get command pool of given queue family for exclusive use, resetting flag of
+         * command buffers is enabled. */
+        [[nodiscard]] CommandPoolLease acquireCommandPool(uint32_t queueFamilyIndex_);
+
+        /* Get VMA pool allocating memory of given type in blocks of blockSize bytes.
+         * Pools are created on first use and live as long as device context, so that
+         * memory blocks can be reused by subsequent tasks. */
+        [[nodiscard]] vma::Pool getMemoryPool(uint32_t memoryTypeIndex, vk::DeviceSize blockSize);
+
+      private: /* Private methods. */
+        static bool hasExtension(const vk::raii::PhysicalDevice&, std::string_view extensionName);
+
+        static uint32_t selectQueueFamilyIndex(const vk::raii::PhysicalDevice&);
+
+        /* Family supporting transfer, but neither compute nor graphics. */
+        static std::optional<uint32_t>
+        selectTransferQueueFamilyIndex(const vk::raii::PhysicalDevice&);
+
+        void releaseCommandPool(uint32_t queueFamilyIndex_, std::unique_ptr<vk::raii::CommandPool>);
+    };
+} // namespace epseon::gpu::cpp
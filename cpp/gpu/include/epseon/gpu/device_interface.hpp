@@ -5,11 +5,14 @@
 #include "epseon/gpu/predecl.hpp"
 
 #include "epseon/gpu/compute_context.hpp"
-#include "epseon/gpu/task_configurator/task_configurator.hpp"
+#include "epseon/gpu/device_context.hpp"
+#include "epseon/gpu/pipeline_cache.hpp"
 #include "epseon/gpu/task_handle.hpp"
+#include "epseon/task_configurator/task_configurator.hpp"
 #include "fmt/format.h"
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <tuple>
 #include <variant>
@@ -21,6 +24,13 @@ namespace epseon::gpu::cpp {
       private: /* Private members. */
         std::shared_ptr<ComputeContextState>      computeContextState;
         std::shared_ptr<vk::raii::PhysicalDevice> physicalDevice;
+        std::shared_ptr<PipelineCache>            pipelineCache;
+        std::shared_ptr<AutotuneCache>            autotuneCache;
+        // Held while autotuning, see autotuneHardwareConfig().
+        std::mutex                                autotuneMutex;
+        // Created by first task which needs it, see getDeviceContext().
+        mutable std::mutex                        deviceContextMutex;
+        mutable std::shared_ptr<DeviceContext>    deviceContext;
 
       public: /* Public constructors. */
         ComputeDeviceInterface(std::shared_ptr<ComputeContextState>, std::shared_ptr<vk::raii::PhysicalDevice>);
@@ -33,6 +43,25 @@ namespace epseon::gpu::cpp {
 
         const vk::raii::PhysicalDevice& getPhysicalDevice() const;
 
+        /* Pipeline cache shared by all tasks submitted to this device, it is loaded
+         * from disk when interface is created. */
+        PipelineCache& getPipelineCache() const;
+
+        /* Logical device shared by all tasks submitted to this device, it is created on
+         * first call and reused afterwards. Safe to call from multiple threads. */
+        std::shared_ptr<DeviceContext> getDeviceContext() const;
+
+        /* Autotuning results of this device, stored next to pipeline cache. */
+        AutotuneCache& getAutotuneCache() const;
+
+        /* Hardware config for tasks with potentials of pointCount points and levelCount
+         * levels, with group size and workgroup size found by benchmarking device, see
+         * Autotuner. Results are cached per device UUID, benchmarks run only on cache
+         * miss or if useCache is false. Defined in autotuner.hpp. */
+        template <typename FP>
+        std::shared_ptr<HardwareConfig<FP>>
+        autotuneHardwareConfig(uint32_t pointCount, uint32_t levelCount, bool useCache = true);
+
         template <typename FP>
         // Namespaces specified explicitly to avoid confusion.
         std::shared_ptr<epseon::gpu::cpp::TaskHandle<FP>>
@@ -2,42 +2,30 @@
 
 #include "epseon/libepseon.hpp"
 
-#include <cassert>
-#include <exception>
-#include <stdexcept>
-#include <string>
-#include <string_view>
+#include "epseon/gpu/predecl.hpp"
 
-#define PrecisionTypeAssertValueCount(count)                           \
-    static_assert(                                                     \
-        static_cast<int>(epseon::gpu::cpp::PrecisionType::_Last) == 2, \
-        "The number of PrecisionTypes has changed."                    \
-    );
+#include "epseon/enums.hpp"
+#include <string>
 
 namespace epseon::gpu::cpp {
 
-    enum class PrecisionType {
-        Float32,
-        Float64,
-        // If it is necessary to add new value, add it here, before _Last.
-        _Last // Marker for last enum value.
+    // Brought in next to toString(TaskPhase), it would hide shared overloads otherwise.
+    using epseon::cpp::toString;
+
+    /* Stage of task execution, reported by TaskHandle::getProgress(). */
+    enum class TaskPhase {
+        // Submitted, worker not started yet.
+        Pending,
+        // Potential source generates or loads potential curves.
+        GeneratingPotentials,
+        // Logical device, buffers and pipeline are created.
+        Preparing,
+        // Batches are uploaded, computed and read back.
+        Computing,
+        Finished,
+        Cancelled,
+        Failed,
     };
 
-    class InvalidPrecisionTypeString : public std::exception {
-      private:
-        std::string message;
-
-      public:
-        InvalidPrecisionTypeString(std::string_view);
-        const char* what() const noexcept override;
-    };
-
-    std::string   toString(PrecisionType);
-    PrecisionType toPrecisionType(std::string_view prec);
-
-    template <typename FP>
-    PrecisionType getPrecisionType() {
-        PrecisionTypeAssertValueCount(2);
-        assert(false); // See template specializations in `enums.cpp`.
-    };
+    std::string toString(TaskPhase);
 } // namespace epseon::gpu::cpp
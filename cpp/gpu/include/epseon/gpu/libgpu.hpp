@@ -4,10 +4,14 @@
 
 #include "epseon/gpu/predecl.hpp"
 
+#include "epseon/gpu/autotuner.hpp"
 #include "epseon/gpu/common.hpp"
 #include "epseon/gpu/compute_context.hpp"
+#include "epseon/gpu/device_context.hpp"
 #include "epseon/gpu/device_interface.hpp"
 #include "epseon/gpu/enums.hpp"
+#include "epseon/gpu/multi_device_interface.hpp"
+#include "epseon/gpu/pipeline_cache.hpp"
 #include "epseon/gpu/task_handle.hpp"
 
 #include "epseon/gpu/python/api.hpp"
@@ -15,7 +19,7 @@
 #include "epseon/gpu/algorithms/algorithm.hpp"
 #include "epseon/gpu/algorithms/vibwa.hpp"
 
-#include "epseon/gpu/task_configurator/algorithm_config.hpp"
-#include "epseon/gpu/task_configurator/hardware_config.hpp"
-#include "epseon/gpu/task_configurator/potential_source.hpp"
-#include "epseon/gpu/task_configurator/task_configurator.hpp"
+#include "epseon/task_configurator/algorithm_config.hpp"
+#include "epseon/task_configurator/hardware_config.hpp"
+#include "epseon/task_configurator/potential_source.hpp"
+#include "epseon/task_configurator/task_configurator.hpp"
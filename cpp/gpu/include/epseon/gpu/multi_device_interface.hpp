@@ -0,0 +1,258 @@
+#pragma once
+
+#include "epseon/libepseon.hpp"
+
+#include "epseon/gpu/predecl.hpp"
+
+#include "epseon/gpu/device_interface.hpp"
+#include "epseon/gpu/enums.hpp"
+#include "epseon/gpu/task_handle.hpp"
+#include "epseon/task_configurator/potential_source.hpp"
+#include "epseon/task_configurator/task_configurator.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace epseon::gpu::cpp {
+
+    /* Interface running tasks on multiple devices at once. Potentials of each task are
+     * split into contiguous shards, one per device, sized in proportion to throughput
+     * measured on previous tasks, and results are merged back in original order.
+     *
+     * Same physical device may be listed more than once, each entry gets its own
+     * logical device then.
+     */
+    class MultiDeviceInterface : public std::enable_shared_from_this<MultiDeviceInterface> {
+      private: /* Private members. */
+        std::vector<std::shared_ptr<ComputeDeviceInterface>> devices         = {};
+        mutable std::mutex                                   throughputMutex = {};
+        // Potential points processed per second by each device, 0 until measured.
+        std::vector<double>                                  throughput      = {};
+
+      public: /* Public constants. */
+        // Weight of latest measurement in running average of device throughput.
+        static constexpr double throughputSmoothing = 0.5;
+
+      public: /* Public constructors. */
+        explicit MultiDeviceInterface(std::vector<std::shared_ptr<ComputeDeviceInterface>>);
+
+      public: /* Public methods. */
+        template <typename FP>
+        std::shared_ptr<TaskConfigurator<FP>> getTaskConfigurator() {
+            return std::make_shared<TaskConfigurator<FP>>();
+        }
+
+        template <typename FP>
+        std::shared_ptr<TaskHandle<FP>> submitTask(std::shared_ptr<TaskConfigurator<FP>> task_config
+        ) {
+            if (!task_config->isConfigured()) {
+                throw std::runtime_error("TaskConfigurator wasn't fully configured before "
+                                         "submitting for execution.");
+            }
+            return std::make_shared<MultiDeviceTaskHandle<FP>>(
+                this->shared_from_this(), task_config
+            );
+        }
+
+        [[nodiscard]] const std::vector<std::shared_ptr<ComputeDeviceInterface>>&
+        getDevices() const {
+            return this->devices;
+        }
+
+        /* Measured throughput of each device in potential points per second, 0 for
+         * devices which didn't finish any shard yet. */
+        [[nodiscard]] std::vector<double> getThroughput() const;
+
+        /* Number of potentials assigned to each device. Devices without measurement are
+         * assumed to be as fast as average measured device, all devices get equal
+         * shares if none was measured. */
+        [[nodiscard]] std::vector<size_t> planShards(size_t potentialCount) const;
+
+        /* Update throughput of device with shard whose batches took elapsed time. */
+        void recordThroughput(
+            size_t deviceIndex, size_t potentialPointCount, std::chrono::duration<double> elapsed
+        );
+    };
+
+    /* Task handle running shards of task as separate tasks on devices of
+     * MultiDeviceInterface. Shards are cancelled together with this handle and first
+     * shard error is rethrown when results are requested. Progress of this handle is sum
+     * of progress of shards, polled while they run, and so are streamed results of shards,
+     * which are forwarded with potential indices of whole task. */
+    template <typename FP>
+    class MultiDeviceTaskHandle : public TaskHandle<FP> {
+      public: /* Public constants. */
+        static constexpr std::chrono::milliseconds progressPollInterval{5};
+
+      private: /* Private members. */
+        std::shared_ptr<MultiDeviceInterface> multiDevice = {};
+
+      public: /* Public constructors. */
+        MultiDeviceTaskHandle(
+            std::shared_ptr<MultiDeviceInterface> multiDevice_,
+            std::shared_ptr<TaskConfigurator<FP>> config_
+        ) :
+            TaskHandle<FP>(multiDevice_->getDevices().front(), std::move(config_)),
+            multiDevice(std::move(multiDevice_)) {}
+
+      public: /* Public destructor. */
+        // Worker runs execute() of this class, which uses multiDevice, so it has to exit
+        // before members are destroyed.
+        ~MultiDeviceTaskHandle() override {
+            this->stopWorker();
+        }
+
+      protected: /* Protected methods. */
+        void execute(const std::stop_token& stop_token) override {
+            const auto& configurator = this->getTaskConfigurator();
+            const auto& devices      = this->multiDevice->getDevices();
+            auto&       progress     = this->getWorkerProgress();
+
+            progress.setPhase(TaskPhase::GeneratingPotentials);
+            // Shards of Morse potentials get slices of their parameters, so that every
+            // shard generates its curves itself, on device when it can. Curves of other
+            // sources are produced once here and shards view the same contiguous memory.
+            const auto& source = configurator.getPotentialSource();
+            const auto  morse  = std::dynamic_pointer_cast<MorsePotentialGenerator<FP>>(source);
+            std::shared_ptr<PotentialBuffer<FP>> buffer{};
+            if (!morse) {
+                buffer = source->get_potential_buffer();
+            }
+            const PotentialSource<FP>& sharded =
+                morse ? static_cast<const PotentialSource<FP>&>(*morse) : *buffer;
+            const size_t potentialCount = sharded.get_potential_count();
+            const size_t pointCount     = sharded.get_point_count();
+            const auto   shardSizes     = this->multiDevice->planShards(potentialCount);
+            const auto   getShardSource =
+                [&](size_t first, size_t count) -> std::shared_ptr<PotentialSource<FP>> {
+                if (morse) {
+                    const auto begin =
+                        morse->configurations.begin() + static_cast<std::ptrdiff_t>(first);
+                    return std::make_shared<MorsePotentialGenerator<FP>>(
+                        std::vector<MorsePotentialConfig<FP>>(
+                            begin, begin + static_cast<std::ptrdiff_t>(count)
+                        )
+                    );
+                }
+                return buffer->slice(first, count);
+            };
+
+            struct Shard {
+                size_t                          deviceIndex = {};
+                size_t                          first       = {};
+                size_t                          count       = {};
+                std::shared_ptr<TaskHandle<FP>> handle      = {};
+            };
+            std::vector<Shard> shards{};
+
+            size_t first = 0;
+            for (size_t deviceIndex = 0; deviceIndex < devices.size(); deviceIndex++) {
+                const size_t count = shardSizes[deviceIndex];
+                // Empty task still runs on first device, to fill in level count.
+                if (count == 0 && !(potentialCount == 0 && deviceIndex == 0)) {
+                    continue;
+                }
+                auto shardConfig = std::make_shared<TaskConfigurator<FP>>(configurator);
+                shardConfig->setPotentialSource(getShardSource(first, count));
+
+                auto handle = devices[deviceIndex]->submitTask(shardConfig);
+                if (this->isStreaming()) {
+                    handle->enableResultStream(this->getResultStream()->getCapacity());
+                }
+                handle->startWorker();
+                shards.push_back({deviceIndex, first, count, std::move(handle)});
+                first += count;
+            }
+            LIB_EPSEON_ASSERT_TRUE(first == potentialCount);
+
+            {
+                std::stop_callback cancelShards(stop_token, [&shards]() {
+                    for (auto& shard : shards) {
+                        shard.handle->cancel();
+                    }
+                });
+                for (bool done = false; !done;) {
+                    done = true;
+                    TaskProgress total{
+                        .phase = TaskPhase::Computing, .potentialCount = potentialCount
+                    };
+                    for (const auto& shard : shards) {
+                        done = shard.handle->isDone() && done;
+                        if (this->isStreaming()) {
+                            this->forwardResults(shard.first, *shard.handle, stop_token);
+                        }
+                        const auto shardProgress = shard.handle->getProgress();
+                        total.potentialsCompleted += shardProgress.potentialsCompleted;
+                        total.levelsFound += shardProgress.levelsFound;
+                        total.bytesUploaded += shardProgress.bytesUploaded;
+                        total.bytesReadBack += shardProgress.bytesReadBack;
+                    }
+                    progress.store(total);
+                    if (!done) {
+                        std::this_thread::sleep_for(progressPollInterval);
+                    }
+                }
+                for (auto& shard : shards) {
+                    shard.handle->wait();
+                }
+            }
+
+            // Rethrows first shard error.
+            this->allocateResults(potentialCount, shards.front().handle->getLevelCount());
+            // Streamed results were forwarded while shards ran.
+            for (const auto& shard : shards) {
+                const auto& levelEnergies = shard.handle->getLevelEnergies();
+                const auto  levelCount    = shard.handle->getLevelCount();
+                for (size_t i = 0; i < shard.count && !this->isStreaming(); i++) {
+                    std::copy_n(
+                        levelEnergies.begin() + static_cast<std::ptrdiff_t>(i * levelCount),
+                        levelCount,
+                        this->getPotentialLevelEnergies(shard.first + i).begin()
+                    );
+                }
+            }
+
+            if (!stop_token.stop_requested()) {
+                for (const auto& shard : shards) {
+                    if (shard.count == 0) {
+                        continue;
+                    }
+                    // Only batches count, creation of logical device and pipeline
+                    // compilation on cold cache are paid once and would make first
+                    // shard of device look much slower than following ones.
+                    const auto& timings = shard.handle->getTimings();
+                    this->multiDevice->recordThroughput(
+                        shard.deviceIndex,
+                        shard.count * pointCount,
+                        timings.total - timings.potentialGeneration - timings.deviceSetup -
+                            timings.pipelineSetup
+                    );
+                }
+            }
+        }
+
+      private: /* Private methods. */
+        /* Pass results queued by shard starting at potential first to stream of this
+         * handle. Shard handle is done before its stream is closed, so all its results
+         * are forwarded once isDone() was observed before call. */
+        void forwardResults(
+            size_t first, const TaskHandle<FP>& shard, const std::stop_token& stop_token
+        ) {
+            const auto stream = shard.getResultStream();
+            while (auto result = stream->tryPop()) {
+                result->firstPotential += first;
+                this->pushBatchResult(std::move(*result), stop_token);
+            }
+        }
+    };
+
+    template class MultiDeviceTaskHandle<float>;
+    template class MultiDeviceTaskHandle<double>;
+} // namespace epseon::gpu::cpp
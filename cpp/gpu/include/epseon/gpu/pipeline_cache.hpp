@@ -0,0 +1,90 @@
+#pragma once
+
+#include "epseon/vulkan_headers.hpp"
+
+#include "epseon/gpu/predecl.hpp"
+
+#include "spdlog/logger.h"
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace epseon::gpu::cpp {
+
+    /* Persistent store for Vulkan pipeline cache data of single physical device.
+     *
+     * Cache data is loaded from file named after pipelineCacheUUID of device when
+     * instance is created and written back every time it is updated with contents of
+     * vk::PipelineCache used to create pipelines. Data which doesn't match vendor,
+     * device or pipelineCacheUUID (e.g. after driver update) is discarded, I/O errors
+     * are only logged, as lack of cache affects only first task latency.
+     */
+    class PipelineCache {
+      public: /* Public constants. */
+        // Environment variable overriding default cache directory.
+        static constexpr const char* directoryEnvironmentVariable =
+            "EPSEON_GPU_PIPELINE_CACHE_DIR";
+
+      private: /* Private members. */
+        std::shared_ptr<spdlog::logger> logger           = {};
+        std::filesystem::path           path             = {};
+        vk::PhysicalDeviceProperties    deviceProperties = {};
+        mutable std::mutex              mutex            = {};
+        std::vector<uint8_t>            data             = {};
+
+      public: /* Public constructors. */
+        PipelineCache(
+            std::shared_ptr<spdlog::logger>     logger_,
+            const std::filesystem::path&        directory,
+            const vk::PhysicalDeviceProperties& deviceProperties_
+        );
+
+        // Copy constructor.
+        PipelineCache(const PipelineCache&) = delete;
+
+        // Copy assignment operator.
+        PipelineCache& operator=(const PipelineCache&) = delete;
+
+        // Move constructor.
+        PipelineCache(PipelineCache&&) = delete;
+
+        // Move assignment operator.
+        PipelineCache& operator=(PipelineCache&&) = delete;
+
+      public: /* Public destructor. */
+        ~PipelineCache() = default;
+
+      public: /* Public methods. */
+        /* Directory from EPSEON_GPU_PIPELINE_CACHE_DIR or ./cache/epseon/gpu. */
+        static std::filesystem::path getDefaultDirectory();
+
+        /* Name of cache file, hex encoded pipelineCacheUUID. */
+        static std::string getFileName(const vk::PhysicalDeviceProperties&);
+
+        [[nodiscard]] const std::filesystem::path& getPath() const {
+            return this->path;
+        }
+
+        /* Copy of currently stored cache data. */
+        [[nodiscard]] std::vector<uint8_t> getData() const;
+
+        /* Check if data has valid header created for this device. */
+        [[nodiscard]] bool isCompatible(std::span<const uint8_t>) const;
+
+        /* Create vk::PipelineCache for logical device, initialized with stored data. */
+        [[nodiscard]] vk::raii::PipelineCache createVkPipelineCache(const vk::raii::Device&
+        ) const;
+
+        /* Replace stored data with contents of vk::PipelineCache created with
+         * createVkPipelineCache() and save it to disk if it changed. */
+        void store(const vk::raii::PipelineCache&);
+
+      private: /* Private methods. */
+        void load();
+        void save(std::span<const uint8_t>) const;
+    };
+} // namespace epseon::gpu::cpp
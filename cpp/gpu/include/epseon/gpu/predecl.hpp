@@ -1,8 +1,13 @@
 #pragma once
 
+#include "epseon/predecl.hpp"
+
 namespace epseon::gpu {
     namespace cpp {
 
+        // Task configuration and potential sources are shared with CPU backend.
+        using namespace epseon::cpp;
+
         template <typename FP>
         class Algorithm;
 
@@ -12,34 +17,33 @@ namespace epseon::gpu {
         template <typename FP>
         class TaskHandle;
 
-        template <typename FP>
-        struct HardwareConfig;
+        struct TaskTimings;
+        struct TaskProgress;
 
         template <typename FP>
-        class PotentialSource;
+        struct BatchResult;
 
         template <typename FP>
-        class PotentialFileLoader;
+        class ResultStream;
 
         template <typename FP>
-        class MorsePotentialConfig;
+        struct ShaderBuffersRequirements;
 
-        template <typename FP>
-        class MorsePotentialGenerator;
+        class ComputeDeviceInterface;
 
-        template <typename FP>
-        struct ShaderBuffersRequirements;
+        class MultiDeviceInterface;
 
         template <typename FP>
-        class AlgorithmConfig;
+        class MultiDeviceTaskHandle;
 
-        template <typename FP>
-        class VibwaAlgorithmConfig;
+        class PipelineCache;
+
+        class AutotuneCache;
 
         template <typename FP>
-        class TaskConfigurator;
+        class Autotuner;
 
-        class ComputeDeviceInterface;
+        class DeviceContext;
 
     } // namespace cpp
 
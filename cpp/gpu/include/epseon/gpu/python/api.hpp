@@ -5,15 +5,21 @@
 #include "epseon/gpu/compute_context.hpp"
 #include "epseon/gpu/device_interface.hpp"
 #include "epseon/gpu/enums.hpp"
-#include "epseon/gpu/task_configurator/algorithm_config.hpp"
-#include "epseon/gpu/task_configurator/hardware_config.hpp"
-#include "epseon/gpu/task_configurator/potential_source.hpp"
-#include "epseon/gpu/task_configurator/task_configurator.hpp"
+#include "epseon/gpu/multi_device_interface.hpp"
 #include "epseon/gpu/task_handle.hpp"
+#include "epseon/task_configurator/algorithm_config.hpp"
+#include "epseon/task_configurator/hardware_config.hpp"
+#include "epseon/task_configurator/potential_source.hpp"
+#include "epseon/task_configurator/task_configurator.hpp"
+#include "fmt/format.h"
+#include "pybind11/numpy.h"
+#include "pybind11/pybind11.h"
 #include "pybind11/pytypes.h"
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <variant>
@@ -23,21 +29,125 @@ namespace epseon {
     namespace gpu {
         namespace python {
 
+            /* Wrap level energies, level_count consecutive values for each potential, into
+             * 2D NumPy array without copying them. Owner is moved into capsule which is
+             * the base of array, so memory it keeps alive outlives array and its views.
+             */
+            template <typename FP, typename Owner>
+            pybind11::array_t<FP>
+            makeLevelEnergiesArray(const FP* data, size_t size, uint32_t level_count, Owner owner) {
+                const size_t      potential_count = level_count == 0 ? 0 : size / level_count;
+                pybind11::capsule base{
+                    new Owner(std::move(owner)),
+                    [](void* pointer) { delete static_cast<Owner*>(pointer); }
+                };
+                return pybind11::array_t<FP>(
+                    {potential_count, size_t{level_count}},
+                    {size_t{level_count} * sizeof(FP), sizeof(FP)},
+                    data,
+                    base
+                );
+            }
+
+            /* Python API - Iterator over batches of streamed task results. */
+            template <typename FP>
+            class ResultIterator {
+              private: /* Private members. */
+                // Keeps task alive while its results are consumed.
+                std::shared_ptr<cpp::TaskHandle<FP>>   handle = {};
+                std::shared_ptr<cpp::ResultStream<FP>> stream = {};
+
+              public: /* Public constructors. */
+                explicit ResultIterator(std::shared_ptr<cpp::TaskHandle<FP>> handle_) :
+                    handle(std::move(handle_)),
+                    stream(this->handle->getResultStream()) {}
+
+              public: /* Public methods. */
+                /* Python API - Index of first potential of next finished batch and level
+                 * energies of its potentials, array with one row per potential which
+                 * takes over memory of batch. Blocks until batch is finished, raises
+                 * StopIteration once all batches were consumed and error of task if it
+                 * failed.
+                 */
+                std::pair<size_t, pybind11::array_t<FP>> next() {
+                    std::optional<cpp::BatchResult<FP>> result{};
+                    {
+                        // Worker thread doesn't need GIL to produce next batch.
+                        pybind11::gil_scoped_release release{};
+                        result = this->stream->pop();
+                    }
+                    if (!result) {
+                        throw pybind11::stop_iteration();
+                    }
+                    // Moving vector keeps its data pointer, array points to it.
+                    const FP*    data       = result->levelEnergies.data();
+                    const size_t size       = result->levelEnergies.size();
+                    const auto   levelCount = result->levelCount;
+                    return {
+                        result->firstPotential,
+                        makeLevelEnergiesArray(
+                            data, size, levelCount, std::move(result->levelEnergies)
+                        )
+                    };
+                }
+            };
+
+            template class ResultIterator<float>;
+            template class ResultIterator<double>;
+
             template <typename FP>
             class TaskHandle {
               private: /* Private members. */
                 std::shared_ptr<cpp::TaskHandle<FP>> handle = {};
 
               public: /* Public constructors. */
-                TaskHandle(std::shared_ptr<cpp::TaskHandle<FP>> handle_) :
+                /* Results are streamed in batches when stream_capacity is not zero, see
+                 * stream_results(). */
+                TaskHandle(
+                    std::shared_ptr<cpp::TaskHandle<FP>> handle_, size_t stream_capacity = 0
+                ) :
                     handle(handle_) {
+                    if (stream_capacity != 0 && !this->handle->isRunning())
+                        this->handle->enableResultStream(stream_capacity);
                     if (!this->handle->isRunning())
                         this->handle->startWorker();
                 }
 
               public: /* Public methods. */
+                /* Python API - Phase of task and counts of work done, formatted for
+                 * display. */
                 std::string get_status_message() {
-                    return "status";
+                    const auto progress = handle->getProgress();
+                    if (progress.potentialCount == 0) {
+                        return cpp::toString(progress.phase);
+                    }
+                    return fmt::format(
+                        "{}: {}/{} potentials solved, {} levels found.",
+                        cpp::toString(progress.phase),
+                        progress.potentialsCompleted,
+                        progress.potentialCount,
+                        progress.levelsFound
+                    );
+                }
+
+                /* Python API - Get iterator over batches of results as soon as they are
+                 * finished. Task must have been submitted with stream capacity, results of
+                 * whole task are not kept then.
+                 */
+                ResultIterator<FP> stream_results() {
+                    if (!handle->isStreaming()) {
+                        throw std::runtime_error(
+                            "Task was submitted without result stream, use get_results()."
+                        );
+                    }
+                    return ResultIterator<FP>{handle};
+                }
+
+                /* Python API - Get progress of task, it doesn't block and can be polled
+                 * while task runs.
+                 */
+                cpp::TaskProgress get_progress() {
+                    return handle->getProgress();
                 }
 
                 /* Python API - Check if underlying worker thread finished its work.
@@ -69,6 +179,55 @@ namespace epseon {
                 void wait() {
                     handle->wait();
                 }
+
+                /* Python API - Get energies of vibrational levels, one list per potential.
+                 * Levels which were not found are NaN. Raises if task has not finished
+                 * yet or if it failed.
+                 */
+                std::vector<std::vector<FP>> get_results() {
+                    const auto& level_energies = handle->getLevelEnergies();
+                    const auto  level_count    = handle->getLevelCount();
+
+                    std::vector<std::vector<FP>> results{};
+                    results.reserve(handle->getPotentialCount());
+
+                    for (auto begin = level_energies.begin(); begin != level_energies.end();
+                         begin += level_count) {
+                        results.emplace_back(begin, begin + level_count);
+                    }
+                    return results;
+                }
+
+                /* Python API - Get energies of vibrational levels as read-only 2D array,
+                 * one row per potential, which views results kept by task. Task stays
+                 * alive while array or its views exist. Raises if task has not finished
+                 * yet or if it failed.
+                 */
+                pybind11::array_t<FP> get_results_array() {
+                    const auto& level_energies = handle->getLevelEnergies();
+
+                    auto array = makeLevelEnergiesArray(
+                        level_energies.data(),
+                        level_energies.size(),
+                        handle->getLevelCount(),
+                        handle
+                    );
+                    // Writes would show up in results of other arrays and get_results().
+                    array.attr("flags").attr("writeable") = false;
+                    return array;
+                }
+
+                /* Python API - Get time spent in phases of task. Raises if task has not
+                 * finished yet.
+                 */
+                cpp::TaskTimings get_timings() {
+                    if (!handle->isDone()) {
+                        throw std::runtime_error(
+                            "Task timings are not available until task finishes."
+                        );
+                    }
+                    return handle->getTimings();
+                }
             };
 
             template class TaskHandle<float>;
@@ -156,10 +315,11 @@ namespace epseon {
                 TaskConfigurator& set_hardware_config(
                     uint32_t potential_buffer_size,
                     uint32_t group_size,
-                    uint32_t allocation_block_size
+                    uint32_t allocation_block_size,
+                    uint32_t workgroup_size
                 ) {
                     this->configurator->setHardwareConfig(std::make_shared<cpp::HardwareConfig<FP>>(
-                        potential_buffer_size, group_size, allocation_block_size
+                        potential_buffer_size, group_size, allocation_block_size, workgroup_size
                     ));
                     return *this;
                 };
@@ -170,11 +330,10 @@ namespace epseon {
                 set_morse_potential(const std::vector<MorsePotentialConfig>& configurations) {
                     // Track used point count, all configs should have the same for now.
                     std::optional<uint32_t>                    point_count = std::nullopt;
-                    // By giving from the start necessary vector size, we will avoid
+                    // By reserving necessary vector size from the start, we will avoid
                     // reallocating it multiple times.
-                    std::vector<cpp::MorsePotentialConfig<FP>> configurations_cpp(
-                        configurations.size()
-                    );
+                    std::vector<cpp::MorsePotentialConfig<FP>> configurations_cpp{};
+                    configurations_cpp.reserve(configurations.size());
                     // We will always get all floating point values in config as
                     // doubles, additionally we want to make sure users can't modify
                     // those values after assignment. Therefore we have to copy and
@@ -217,6 +376,49 @@ namespace epseon {
                     return *this;
                 }
 
+                /* Python API - Set potential curves given as C-contiguous 2D array with
+                 * one row per potential. Curves are uploaded straight from memory of
+                 * array, which is kept alive by task configuration and must not be
+                 * modified while tasks using it run.
+                 */
+                TaskConfigurator&
+                set_potential_array(const pybind11::array_t<FP, pybind11::array::c_style>& array
+                ) {
+                    if (array.ndim() != 2) {
+                        throw std::runtime_error(fmt::format(
+                            "Potential array must have 2 dimensions, but has {}.", array.ndim()
+                        ));
+                    }
+                    // Last copy of potential source may be dropped by worker thread, GIL
+                    // has to be held while reference to array is released.
+                    std::shared_ptr<pybind11::object> owner{
+                        new pybind11::object(array),
+                        [](pybind11::object* object) {
+                            pybind11::gil_scoped_acquire gil{};
+                            delete object;
+                        }
+                    };
+                    this->configurator->setPotentialSource(
+                        std::make_shared<cpp::PotentialBuffer<FP>>(
+                            std::shared_ptr<const FP>(owner, array.data()),
+                            static_cast<size_t>(array.shape(0)),
+                            static_cast<size_t>(array.shape(1))
+                        )
+                    );
+                    return *this;
+                }
+
+                /* Python API - Set potential curves stored in binary potential files,
+                 * curves of all files are used in order of files. Headers are validated
+                 * here, curves are read from memory mapped files when task runs.
+                 */
+                TaskConfigurator& set_potential_files(const std::vector<std::string>& file_names) {
+                    auto loader = std::make_shared<cpp::PotentialFileLoader<FP>>(file_names);
+                    loader->get_potential_count();
+                    this->configurator->setPotentialSource(std::move(loader));
+                    return *this;
+                }
+
                 /* Python API - Set algorithm configuration for a GPU compute task.
                  */
                 TaskConfigurator& set_vibwa_algorithm(
@@ -275,18 +477,87 @@ namespace epseon {
                 /* Python API - Submit task for execution. Will raise RuntimeError upon
                  * receiving not fully configured TaskConfigurator. */
                 template <typename FP>
-                TaskHandleVariant submit_task(const TaskConfigurator<FP>& task_config) {
+                TaskHandleVariant
+                submit_task(const TaskConfigurator<FP>& task_config, size_t stream_capacity) {
                     if (!task_config.is_configured()) {
                         throw std::runtime_error("TaskConfigurator submitted for execution "
                                                  "before fully configured.");
                     }
-                    auto config      = task_config.getTaskConfigurator();
+                    // Task gets its own copy of configuration, so that setters called on
+                    // task_config afterwards neither change task nor leave worker with
+                    // last reference to replaced source, e.g. NumPy array.
+                    auto config = std::make_shared<cpp::TaskConfigurator<FP>>(
+                        *task_config.getTaskConfigurator()
+                    );
                     auto task_handle = this->device->submitTask(config);
 
                     return TaskHandleVariant{// Namespaces specified explicitly to avoid confusion.
-                                             epseon::gpu::python::TaskHandle<FP>{task_handle}
+                                             epseon::gpu::python::TaskHandle<FP>{
+                                                 task_handle, stream_capacity
+                                             }
+                    };
+                }
+
+                /* Python API - Get split of task into batches it would use if submitted
+                 * now, given current memory budgets of device. */
+                template <typename FP>
+                cpp::VibwaBatchPlan plan_task(const TaskConfigurator<FP>& task_config) {
+                    return cpp::VibwaAlgorithm<FP>::planTask(
+                        this->device->getPhysicalDevice(),
+                        *this->device->getDeviceContext(),
+                        *task_config.getTaskConfigurator()
+                    );
+                }
+
+                /* Python API - Hardware configuration for tasks of given precision and
+                 * shape found by benchmarking device, cached per device UUID. */
+                cpp::HardwareConfig<double> autotune_hardware_config(
+                    const std::string& precision,
+                    uint32_t           point_count,
+                    uint32_t           level_count,
+                    bool               use_cache
+                );
+            };
+
+            /* Python API - Wrapper class around MultiDeviceInterface class. */
+            class MultiDeviceInterface {
+              private:
+                std::shared_ptr<cpp::MultiDeviceInterface> devices;
+
+              public:
+                MultiDeviceInterface(std::shared_ptr<cpp::MultiDeviceInterface>);
+                /* Python API - Get builder instance for configuring GPU compute task.
+                 */
+                TaskConfiguratorVariant get_task_configurator(std::string);
+
+                /* Python API - Submit task split between all devices of interface. Will
+                 * raise RuntimeError upon receiving not fully configured
+                 * TaskConfigurator. */
+                template <typename FP>
+                TaskHandleVariant
+                submit_task(const TaskConfigurator<FP>& task_config, size_t stream_capacity) {
+                    if (!task_config.is_configured()) {
+                        throw std::runtime_error("TaskConfigurator submitted for execution "
+                                                 "before fully configured.");
+                    }
+                    // Task gets its own copy of configuration, so that setters called on
+                    // task_config afterwards neither change task nor leave worker with
+                    // last reference to replaced source, e.g. NumPy array.
+                    auto config = std::make_shared<cpp::TaskConfigurator<FP>>(
+                        *task_config.getTaskConfigurator()
+                    );
+                    auto task_handle = this->devices->submitTask(config);
+
+                    return TaskHandleVariant{// Namespaces specified explicitly to avoid confusion.
+                                             epseon::gpu::python::TaskHandle<FP>{
+                                                 task_handle, stream_capacity
+                                             }
                     };
                 }
+
+                /* Python API - Measured throughput of each device, in potential points
+                 * per second, 0 for devices which didn't complete any task yet. */
+                std::vector<double> get_throughput();
             };
 
             class EpseonComputeContext {
@@ -306,6 +577,10 @@ namespace epseon {
                  * devices.
                  */
                 ComputeDeviceInterface               get_device_interface(uint32_t);
+                /* Python API - Get interface splitting tasks between multiple Vulkan
+                 * devices, all available devices if no IDs are given.
+                 */
+                MultiDeviceInterface get_multi_device_interface(const std::vector<uint32_t>&);
             };
         } // namespace python
     }     // namespace gpu
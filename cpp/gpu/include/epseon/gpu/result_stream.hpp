@@ -0,0 +1,150 @@
+#pragma once
+
+#include "epseon/gpu/predecl.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <stop_token>
+#include <utility>
+#include <vector>
+
+namespace epseon::gpu::cpp {
+
+    /* Level energies of consecutive potentials, delivered as soon as device finished
+     * them. */
+    template <typename FP>
+    struct BatchResult {
+        // Index of first potential of batch within task.
+        size_t          firstPotential = {};
+        uint32_t        levelCount     = {};
+        // levelCount values for each potential, levels which were not found are NaN.
+        std::vector<FP> levelEnergies  = {};
+
+        [[nodiscard]] size_t getPotentialCount() const {
+            return this->levelCount == 0 ? 0 : this->levelEnergies.size() / this->levelCount;
+        }
+    };
+
+    /* Bounded queue of batch results passed from worker thread to consumer.
+     *
+     * Worker blocks once capacity results are queued, so that memory used by results
+     * not consumed yet stays bounded, until consumer pops one or stop is requested.
+     * Worker closes stream when task ends, consumer then drains remaining results and
+     * gets error of worker thread, if any.
+     */
+    template <typename FP>
+    class ResultStream {
+      private: /* Private members. */
+        size_t                      capacity = {};
+        mutable std::mutex          mutex    = {};
+        std::condition_variable_any notFull  = {};
+        std::condition_variable     notEmpty = {};
+        std::deque<BatchResult<FP>> results  = {};
+        bool                        closed   = false;
+        std::exception_ptr          error    = {};
+
+      public: /* Public constructors. */
+        explicit ResultStream(size_t capacity_) :
+            capacity(capacity_) {
+            if (this->capacity == 0) {
+                throw std::runtime_error("Result stream capacity must be greater than zero.");
+            }
+        }
+
+        // Copy constructor.
+        ResultStream(const ResultStream&) = delete;
+
+        // Copy assignment operator.
+        ResultStream& operator=(const ResultStream&) = delete;
+
+        // Move constructor.
+        ResultStream(ResultStream&&) = delete;
+
+        // Move assignment operator.
+        ResultStream& operator=(ResultStream&&) = delete;
+
+      public: /* Public destructor. */
+        ~ResultStream() = default;
+
+      public: /* Public methods. */
+        /* Queue result, blocking while stream is full. False if result was dropped
+         * because stop was requested or stream is closed. */
+        bool push(BatchResult<FP>&& result, const std::stop_token& stop_token) {
+            {
+                std::unique_lock<std::mutex> lock{this->mutex};
+                // False when stop was requested before space was freed.
+                const bool hasSpace = this->notFull.wait(lock, stop_token, [this]() {
+                    return this->closed || this->results.size() < this->capacity;
+                });
+                if (!hasSpace || this->closed) {
+                    return false;
+                }
+                this->results.push_back(std::move(result));
+            }
+            this->notEmpty.notify_one();
+            return true;
+        }
+
+        /* Next result, blocking until one is available. Empty once stream is closed and
+         * drained, error of worker thread is rethrown instead. */
+        std::optional<BatchResult<FP>> pop() {
+            std::unique_lock<std::mutex> lock{this->mutex};
+            this->notEmpty.wait(lock, [this]() { return this->closed || !this->results.empty(); });
+            return this->takeFront(lock);
+        }
+
+        /* Next result if one is queued already, never blocks nor rethrows. */
+        std::optional<BatchResult<FP>> tryPop() {
+            std::unique_lock<std::mutex> lock{this->mutex};
+            if (this->results.empty()) {
+                return std::nullopt;
+            }
+            return this->takeFront(lock);
+        }
+
+        /* Mark end of results, error is rethrown by pop() once stream is drained. */
+        void close(std::exception_ptr error_ = {}) {
+            {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                this->closed = true;
+                this->error  = std::move(error_);
+            }
+            this->notFull.notify_all();
+            this->notEmpty.notify_all();
+        }
+
+        /* Closed and all results were consumed. */
+        [[nodiscard]] bool isDrained() const {
+            std::lock_guard<std::mutex> lock{this->mutex};
+            return this->closed && this->results.empty();
+        }
+
+        [[nodiscard]] size_t getCapacity() const {
+            return this->capacity;
+        }
+
+      private: /* Private methods. */
+        std::optional<BatchResult<FP>> takeFront(std::unique_lock<std::mutex>& lock) {
+            if (this->results.empty()) {
+                if (this->error) {
+                    std::rethrow_exception(this->error);
+                }
+                return std::nullopt;
+            }
+            auto result = std::move(this->results.front());
+            this->results.pop_front();
+            lock.unlock();
+            this->notFull.notify_one();
+            return result;
+        }
+    };
+
+    template class ResultStream<float>;
+    template class ResultStream<double>;
+} // namespace epseon::gpu::cpp
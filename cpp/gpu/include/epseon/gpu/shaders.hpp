@@ -0,0 +1,18 @@
+#pragma once
+
+#include "epseon/gpu/enums.hpp"
+#include <cstdint>
+#include <span>
+
+namespace epseon::gpu::shaders {
+
+    /* SPIR-V code of VIBWA compute shader compiled for given storage precision, Float16
+     * variant computes in Float32, Float64Emulated one with pairs of floats. Variant with
+     * bufferDeviceAddress set reads buffer addresses from push constants instead of
+     * descriptor sets. Variant with morseGeneration set evaluates Morse potentials from
+     * their parameters, it exists only for Float32 and Float64. */
+    std::span<const uint32_t> getVibwaShaderCode(
+        cpp::PrecisionType, bool bufferDeviceAddress = false, bool morseGeneration = false
+    );
+
+} // namespace epseon::gpu::shaders
@@ -1,19 +1,154 @@
 #pragma once
 
+#include "epseon/libepseon.hpp"
+
 #include "epseon/gpu/predecl.hpp"
 
+#include "epseon/gpu/algorithms/algorithm.hpp"
+#include "epseon/gpu/algorithms/vibwa.hpp"
 #include "epseon/gpu/device_interface.hpp"
-#include "epseon/gpu/task_configurator/task_configurator.hpp"
+#include "epseon/gpu/enums.hpp"
+#include "epseon/gpu/result_stream.hpp"
+#include "epseon/task_configurator/task_configurator.hpp"
 #include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <limits>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <span>
 #include <stdexcept>
 #include <stop_token>
 #include <system_error>
 #include <thread>
+#include <vector>
 
 namespace epseon::gpu::cpp {
 
+    /* Time spent by single task in each of its phases, summed over all batches.
+     *
+     * Host phases are measured by worker thread with steady clock. Device phases are
+     * measured with timestamp queries written at beginning and end of upload and compute
+     * command buffers, they are empty when queue family used doesn't support timestamps.
+     * Uploads run on transfer queue and overlap with compute of other batches, so device
+     * phases don't add up to total.
+     */
+    struct TaskTimings {
+        using Duration = std::chrono::duration<double>;
+
+        // Generation of potential curves by potential source.
+        Duration                potentialGeneration = {};
+        // Creation of logical device, non-zero only for first task on device.
+        Duration                deviceSetup         = {};
+        // Batch planning, allocation of buffers and synchronization objects.
+        Duration                resourceSetup       = {};
+        // Pipeline creation, mostly loading it from pipeline cache.
+        Duration                pipelineSetup       = {};
+        // Host copies of potentials to staging buffers.
+        Duration                stagingWrite        = {};
+        // Host blocked waiting for device to finish batches.
+        Duration                deviceWait          = {};
+        // Host copies of level energies from output buffers.
+        Duration                readBack            = {};
+        // Wall time of whole task.
+        Duration                total               = {};
+        // Copies of potentials to GPU only buffers on device.
+        std::optional<Duration> deviceUpload        = {};
+        // Dispatches of compute shader on device.
+        std::optional<Duration> deviceCompute       = {};
+        // Batches whose results were read completely.
+        uint64_t                batchCount          = {};
+        // Compute dispatches, each batch is split into chunks of bounded duration.
+        uint64_t                dispatchCount       = {};
+    };
+
+    /* Snapshot of task progress, see TaskHandle::getProgress(). */
+    struct TaskProgress {
+        TaskPhase phase               = TaskPhase::Pending;
+        // Number of potentials in task, known once potentials are generated.
+        uint64_t  potentialCount      = {};
+        // Potentials solved by device, including those whose results are still copied.
+        uint64_t  potentialsCompleted = {};
+        // Levels found among solved potentials, levels which don't exist are not counted.
+        uint64_t  levelsFound         = {};
+        // Potentials copied to device and level energies copied back.
+        uint64_t  bytesUploaded       = {};
+        uint64_t  bytesReadBack       = {};
+    };
+
+    /* Progress counters written by worker thread, read by any number of threads polling
+     * them without locks. Counters are independent of each other, so relaxed ordering
+     * is enough - snapshot may mix values from slightly different moments.
+     */
+    class TaskProgressCounters {
+        static_assert(std::atomic<uint64_t>::is_always_lock_free);
+        static_assert(std::atomic<TaskPhase>::is_always_lock_free);
+
+      private: /* Private members. */
+        std::atomic<TaskPhase> phase               = TaskPhase::Pending;
+        std::atomic<uint64_t>  potentialCount      = 0;
+        std::atomic<uint64_t>  potentialsCompleted = 0;
+        std::atomic<uint64_t>  levelsFound         = 0;
+        std::atomic<uint64_t>  bytesUploaded       = 0;
+        std::atomic<uint64_t>  bytesReadBack       = 0;
+
+      public: /* Public methods. */
+        void reset() {
+            this->store(TaskProgress{});
+        }
+
+        void store(const TaskProgress& progress) {
+            this->phase.store(progress.phase, std::memory_order_relaxed);
+            this->potentialCount.store(progress.potentialCount, std::memory_order_relaxed);
+            this->potentialsCompleted.store(
+                progress.potentialsCompleted, std::memory_order_relaxed
+            );
+            this->levelsFound.store(progress.levelsFound, std::memory_order_relaxed);
+            this->bytesUploaded.store(progress.bytesUploaded, std::memory_order_relaxed);
+            this->bytesReadBack.store(progress.bytesReadBack, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] TaskProgress load() const noexcept {
+            return TaskProgress{
+                .phase               = this->phase.load(std::memory_order_relaxed),
+                .potentialCount      = this->potentialCount.load(std::memory_order_relaxed),
+                .potentialsCompleted = this->potentialsCompleted.load(std::memory_order_relaxed),
+                .levelsFound         = this->levelsFound.load(std::memory_order_relaxed),
+                .bytesUploaded       = this->bytesUploaded.load(std::memory_order_relaxed),
+                .bytesReadBack       = this->bytesReadBack.load(std::memory_order_relaxed)
+            };
+        }
+
+        void setPhase(TaskPhase phase_) {
+            this->phase.store(phase_, std::memory_order_relaxed);
+        }
+
+        void setPotentialCount(uint64_t count) {
+            this->potentialCount.store(count, std::memory_order_relaxed);
+        }
+
+        // Device counters of chunks in flight are live, so completed counts are set
+        // rather than incremented.
+        void setPotentialsCompleted(uint64_t count) {
+            this->potentialsCompleted.store(count, std::memory_order_relaxed);
+        }
+
+        void setLevelsFound(uint64_t count) {
+            this->levelsFound.store(count, std::memory_order_relaxed);
+        }
+
+        void addBytesUploaded(uint64_t bytes) {
+            this->bytesUploaded.fetch_add(bytes, std::memory_order_relaxed);
+        }
+
+        void addBytesReadBack(uint64_t bytes) {
+            this->bytesReadBack.fetch_add(bytes, std::memory_order_relaxed);
+        }
+    };
+
     template <typename FP>
     class TaskHandle : public std::enable_shared_from_this<TaskHandle<FP>> {
       private:
@@ -22,6 +157,17 @@ namespace epseon::gpu::cpp {
         std::atomic<bool>                       is_worker_done    = false;
         std::atomic<bool>                       is_worker_started = false;
         std::jthread                            worker            = {};
+        // Written only by worker thread, read only after is_worker_done is set.
+        std::vector<FP>                         level_energies    = {};
+        uint32_t                                level_count       = {};
+        size_t                                  potential_count   = {};
+        std::exception_ptr                      worker_error      = {};
+        std::chrono::duration<double>           elapsed_time      = {};
+        TaskTimings                             timings           = {};
+        TaskProgressCounters                    progress          = {};
+        // Results are passed to stream instead of level_energies when capacity is set.
+        size_t                                  stream_capacity   = {};
+        std::shared_ptr<ResultStream<FP>>       result_stream     = {};
 
       public: /* Public constructors. */
         TaskHandle(
@@ -56,9 +202,22 @@ namespace epseon::gpu::cpp {
         TaskHandle& operator=(TaskHandle&&) noexcept = default;
 
       public: /* Public destructor. */
-        ~TaskHandle() = default;
+        // Worker writes to members of handle, it must be gone before they are.
+        virtual ~TaskHandle() {
+            this->stopWorker();
+        }
 
       protected: /* Protected methods. */
+        /* Request stop of worker thread and wait for it to exit. Destructors of derived
+         * classes overriding execute() must call it first, as worker may still use their
+         * members otherwise. */
+        void stopWorker() {
+            if (this->worker.joinable()) {
+                this->worker.request_stop();
+                this->worker.join();
+            }
+        }
+
         void setDoneFlag() {
             /* Release all previous writes. */
             // Nothing that was before the store can be observed after the
@@ -87,6 +246,60 @@ namespace epseon::gpu::cpp {
             this->is_worker_started.store(false, std::memory_order_release);
         }
 
+        /* Allocate space for results, level energies are initialized with NaN. Streamed
+         * results are allocated per batch instead. */
+        void allocateResults(size_t potential_count_, uint32_t level_count_) {
+            this->level_count     = level_count_;
+            this->potential_count = potential_count_;
+            if (this->isStreaming()) {
+                this->level_energies.clear();
+                return;
+            }
+            this->level_energies.assign(
+                potential_count_ * level_count_, std::numeric_limits<FP>::quiet_NaN()
+            );
+        }
+
+        /* Pass results of finished batch to consumer of result stream, blocking while
+         * stream is full. False if stop was requested meanwhile. */
+        bool pushBatchResult(BatchResult<FP>&& result, const std::stop_token& stop_token) {
+            LIB_EPSEON_ASSERT_TRUE(this->result_stream);
+            return this->result_stream->push(std::move(result), stop_token);
+        }
+
+        /* Get view of results belonging to single potential. */
+        std::span<FP> getPotentialLevelEnergies(size_t potential_index) {
+            LIB_EPSEON_ASSERT_TRUE((potential_index + 1) * level_count <= level_energies.size());
+            return {level_energies.data() + (potential_index * level_count), level_count};
+        }
+
+        /* Progress counters updated by worker thread while task runs. */
+        TaskProgressCounters& getWorkerProgress() {
+            return this->progress;
+        }
+
+        /* Timings recorded by worker thread while task runs. */
+        TaskTimings& getWorkerTimings() {
+            return this->timings;
+        }
+
+        void checkResultsAvailable() const {
+            if (!this->isDone()) {
+                throw std::runtime_error("Task results are not available until task finishes.");
+            }
+            if (this->worker_error) {
+                std::rethrow_exception(this->worker_error);
+            }
+        }
+
+        /* Work done by worker thread, runs algorithm selected by task configuration on
+         * device of this handle. */
+        virtual void execute(const std::stop_token& stop_token) {
+            const auto implementation =
+                Algorithm<FP>::create(*this->config->getAlgorithmConfig());
+            implementation->run(stop_token, this);
+        }
+
         friend VibwaAlgorithm<FP>;
 
       public: /* Public methods. */
@@ -97,16 +310,49 @@ namespace epseon::gpu::cpp {
             }
             this->setNotDoneFlag();
             this->setStartedFlag();
+            if (this->isStreaming()) {
+                this->result_stream = std::make_shared<ResultStream<FP>>(this->stream_capacity);
+            }
             this->worker = std::jthread(this->run, this);
         }
 
+        /* Deliver results through bounded stream of batches, see getResultStream(),
+         * instead of keeping level energies of whole task. Must be enabled before worker
+         * is started. */
+        void enableResultStream(size_t capacity) {
+            if (this->isRunning()) {
+                throw std::runtime_error("Result stream must be enabled before task starts.");
+            }
+            if (capacity == 0) {
+                throw std::runtime_error("Result stream capacity must be greater than zero.");
+            }
+            this->stream_capacity = capacity;
+        }
+
         /* Code run withing worker thread. */
         void static run(std::stop_token stop_token, TaskHandle<FP>* this_ptr) {
-            const auto config         = this_ptr->config->getAlgorithmConfig();
-            const auto implementation = config->getImplementation();
-            implementation->run(stop_token, this_ptr);
+            const auto start = std::chrono::steady_clock::now();
+            this_ptr->timings = {};
+            this_ptr->progress.reset();
+            // Exception escaping std::jthread would terminate whole process, it is stored
+            // and rethrown when results are requested instead.
+            try {
+                this_ptr->execute(stop_token);
+                this_ptr->progress.setPhase(
+                    stop_token.stop_requested() ? TaskPhase::Cancelled : TaskPhase::Finished
+                );
+            } catch (...) {
+                this_ptr->worker_error = std::current_exception();
+                this_ptr->progress.setPhase(TaskPhase::Failed);
+            }
+            this_ptr->elapsed_time  = std::chrono::steady_clock::now() - start;
+            this_ptr->timings.total = this_ptr->elapsed_time;
             this_ptr->setDoneFlag();
             this_ptr->setNotStartedFlag();
+            // Consumer sees end of stream only once task is done.
+            if (this_ptr->result_stream) {
+                this_ptr->result_stream->close(this_ptr->worker_error);
+            }
         }
 
         /* Check if underlying worker thread finished its work.
@@ -156,6 +402,59 @@ namespace epseon::gpu::cpp {
             return *this->config;
         }
 
+        /* Energies of vibrational levels, getLevelCount() consecutive values for each
+         * potential, in order of potentials from potential source. Levels which were not
+         * found are NaN. Empty when results are streamed. Rethrows exception raised by
+         * worker thread, if any.
+         */
+        [[nodiscard]] const std::vector<FP>& getLevelEnergies() const {
+            this->checkResultsAvailable();
+            return this->level_energies;
+        }
+
+        /* Number of levels computed for each potential. */
+        [[nodiscard]] uint32_t getLevelCount() const {
+            this->checkResultsAvailable();
+            return this->level_count;
+        }
+
+        /* Number of potentials for which levels were computed. */
+        [[nodiscard]] size_t getPotentialCount() const {
+            this->checkResultsAvailable();
+            return this->level_count == 0 ? 0 : this->potential_count;
+        }
+
+        /* Wall time spent by worker thread, valid once task is done. */
+        [[nodiscard]] std::chrono::duration<double> getElapsedTime() const {
+            LIB_EPSEON_ASSERT_TRUE(this->isDone());
+            return this->elapsed_time;
+        }
+
+        /* Time spent in phases of task, valid once task is done. Partial when task was
+         * cancelled or failed. */
+        [[nodiscard]] const TaskTimings& getTimings() const {
+            LIB_EPSEON_ASSERT_TRUE(this->isDone());
+            return this->timings;
+        }
+
+        /* Progress of task, safe to call from any thread at any time. It only loads a few
+         * atomics, so it can be polled often. */
+        [[nodiscard]] TaskProgress getProgress() const noexcept {
+            return this->progress.load();
+        }
+
+        [[nodiscard]] bool isStreaming() const {
+            return this->stream_capacity != 0;
+        }
+
+        /* Stream of batch results of current run, available once worker is started with
+         * result stream enabled. Batches arrive in order of completion as soon as their
+         * results are read back. Worker blocks while stream is full, so consumer has to
+         * drain it, or cancel task. */
+        [[nodiscard]] std::shared_ptr<ResultStream<FP>> getResultStream() const {
+            return this->result_stream;
+        }
+
         [[nodiscard]] const ComputeDeviceInterface& getDeviceInterface() const {
             return *this->device;
         }
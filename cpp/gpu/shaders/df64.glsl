@@ -0,0 +1,93 @@
+/* Double-float arithmetic for devices without shaderFloat64.
+ *
+ * Value is stored in vec2 as unevaluated sum x + y of two floats, |y| <= ulp(x) / 2,
+ * which gives about 48 bits of mantissa and range of float. Error free transformations
+ * follow Dekker 1971 and Knuth, products are split with Veltkamp's method instead of
+ * fma(), as Vulkan doesn't guarantee fma() to be fused. Intermediate results are
+ * precise, so that compiler doesn't reassociate or contract them.
+ */
+
+#ifndef EPSEON_DF64_GLSL
+#define EPSEON_DF64_GLSL
+
+vec2 df64(float a) {
+    return vec2(a, 0.0);
+}
+
+/* Exact sum of two floats. */
+vec2 df64_two_sum(float a, float b) {
+    precise float s  = a + b;
+    precise float bb = s - a;
+    precise float e  = (a - (s - bb)) + (b - bb);
+    return vec2(s, e);
+}
+
+/* Exact sum of two floats, |a| >= |b|. */
+vec2 df64_quick_two_sum(float a, float b) {
+    precise float s = a + b;
+    precise float e = b - (s - a);
+    return vec2(s, e);
+}
+
+/* Split float into two halves of 12 bits each. */
+vec2 df64_split(float a) {
+    precise float c  = 4097.0 * a;
+    precise float hi = c - (c - a);
+    precise float lo = a - hi;
+    return vec2(hi, lo);
+}
+
+/* Exact product of two floats. */
+vec2 df64_two_prod(float a, float b) {
+    precise float p  = a * b;
+    vec2          as = df64_split(a);
+    vec2          bs = df64_split(b);
+    precise float e  = ((as.x * bs.x - p) + as.x * bs.y + as.y * bs.x) + as.y * bs.y;
+    return vec2(p, e);
+}
+
+vec2 df64_add(vec2 a, vec2 b) {
+    vec2          s = df64_two_sum(a.x, b.x);
+    vec2          t = df64_two_sum(a.y, b.y);
+    precise float e = s.y + t.x;
+    s               = df64_quick_two_sum(s.x, e);
+    e               = s.y + t.y;
+    return df64_quick_two_sum(s.x, e);
+}
+
+vec2 df64_sub(vec2 a, vec2 b) {
+    return df64_add(a, -b);
+}
+
+vec2 df64_mul(vec2 a, vec2 b) {
+    vec2          p = df64_two_prod(a.x, b.x);
+    precise float e = p.y + (a.x * b.y + a.y * b.x);
+    return df64_quick_two_sum(p.x, e);
+}
+
+vec2 df64_mul(vec2 a, float b) {
+    vec2          p = df64_two_prod(a.x, b);
+    precise float e = p.y + a.y * b;
+    return df64_quick_two_sum(p.x, e);
+}
+
+/* Long division, each float quotient digit corrects remainder of previous ones, so
+ * that inexact float division doesn't matter. */
+vec2 df64_div(vec2 a, vec2 b) {
+    float q1 = a.x / b.x;
+    vec2  r  = df64_sub(a, df64_mul(b, q1));
+    float q2 = r.x / b.x;
+    r        = df64_sub(r, df64_mul(b, q2));
+    float q3 = r.x / b.x;
+    return df64_add(df64_quick_two_sum(q1, q2), df64(q3));
+}
+
+bool df64_lt(vec2 a, vec2 b) {
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+vec2 df64_abs(vec2 a) {
+    return a.x < 0.0 || (a.x == 0.0 && a.y < 0.0) ? -a : a;
+}
+
+#endif
@@ -0,0 +1,120 @@
+#include "epseon/vulkan_headers.hpp"
+
+#include "epseon/gpu/autotuner.hpp"
+#include "epseon/gpu/common.hpp"
+#include "epseon/gpu/enums.hpp"
+#include "fmt/format.h"
+#include "spdlog/spdlog.h"
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <string>
+#include <utility>
+
+namespace epseon::gpu::cpp {
+
+    namespace {
+        // First line of cache file, changed whenever format or meaning of results does.
+        constexpr const char* fileHeader = "epseon-gpu-autotune 1";
+    } // namespace
+
+    AutotuneCache::AutotuneCache(
+        std::shared_ptr<spdlog::logger>          logger_,
+        const std::filesystem::path&             directory,
+        const std::array<uint8_t, VK_UUID_SIZE>& deviceUUID
+    ) :
+        logger(std::move(logger_)),
+        path(directory / getFileName(deviceUUID)) {
+        std::lock_guard<std::mutex> lock{this->mutex};
+        this->load();
+    }
+
+    std::string AutotuneCache::getFileName(const std::array<uint8_t, VK_UUID_SIZE>& deviceUUID) {
+        std::string name{"autotune_"};
+        for (uint8_t byte : deviceUUID) {
+            name += fmt::format("{:02x}", byte);
+        }
+        return name + ".txt";
+    }
+
+    std::optional<AutotuneResult> AutotuneCache::get(const AutotuneKey& key) {
+        std::lock_guard<std::mutex> lock{this->mutex};
+        if (!this->entries.contains(key)) {
+            this->load();
+        }
+        const auto entry = this->entries.find(key);
+        if (entry == this->entries.end()) {
+            return std::nullopt;
+        }
+        return entry->second;
+    }
+
+    void AutotuneCache::store(const AutotuneKey& key, const AutotuneResult& result) {
+        std::lock_guard<std::mutex> lock{this->mutex};
+        this->entries.insert_or_assign(key, result);
+        // File is rewritten as whole, pick up results stored by other instances since it
+        // was last read, so that they are not dropped.
+        this->load();
+        this->save();
+    }
+
+    void AutotuneCache::load() {
+        std::ifstream file{this->path};
+        if (!file) {
+            return;
+        }
+        std::string line{};
+        if (!std::getline(file, line) || line != fileHeader) {
+            this->logger->warn(
+                "Autotune cache {} has unknown format, ignoring it.", this->path.string()
+            );
+            return;
+        }
+        // Each line holds: precision point_count level_count group_size workgroup_size.
+        while (std::getline(file, line)) {
+            std::istringstream stream{line};
+            std::string        precision{};
+            AutotuneKey        key{};
+            AutotuneResult     result{};
+            if (!(stream >> precision >> key.pointCount >> key.levelCount >> result.groupSize >>
+                  result.workgroupSize)) {
+                continue;
+            }
+            try {
+                key.precision = toPrecisionType(precision);
+            } catch (const InvalidPrecisionTypeString&) {
+                continue;
+            }
+            // Results tuned in this process take precedence.
+            this->entries.try_emplace(key, result);
+        }
+    }
+
+    void AutotuneCache::save() const {
+        std::string contents{fileHeader};
+        contents += '\n';
+        for (const auto& [key, result] : this->entries) {
+            contents += fmt::format(
+                "{} {} {} {} {}\n",
+                toString(key.precision),
+                key.pointCount,
+                key.levelCount,
+                result.groupSize,
+                result.workgroupSize
+            );
+        }
+        const auto error =
+            common::write_file_atomically(this->path, std::as_bytes(std::span{contents}));
+        if (error) {
+            this->logger->warn(
+                "Failed to save autotune cache {}: {}", this->path.string(), error.message()
+            );
+        }
+    }
+} // namespace epseon::gpu::cpp
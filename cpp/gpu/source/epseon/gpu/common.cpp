@@ -1,17 +1,185 @@
 #include "epseon/vulkan_headers.hpp"
 
 #include "epseon/gpu/common.hpp"
+#include "fmt/format.h"
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <span>
 #include <sstream>
+#include <system_error>
+
+#if defined(_WIN32)
+    #include <process.h>
+#else
+    #include <unistd.h>
+#endif
 
 namespace epseon {
     namespace gpu {
         namespace common {
+            namespace {
+                // Number of temporary files created by this process so far.
+                std::atomic<uint64_t> temporaryFileCount = 0;
+
+                uint64_t get_process_id() {
+#if defined(_WIN32)
+                    return static_cast<uint64_t>(::_getpid());
+#else
+                    return static_cast<uint64_t>(::getpid());
+#endif
+                }
+
+                std::error_code last_error() {
+                    return {errno != 0 ? errno : EIO, std::generic_category()};
+                }
+
+                /* Create new file next to path, failing if file of chosen name already
+                 * exists, so that no two writers ever share temporary file. */
+                std::FILE* create_temporary_file(
+                    const std::filesystem::path& path,
+                    std::filesystem::path&       temporaryPath,
+                    std::error_code&             error
+                ) {
+                    // Random part tells apart processes of equal pid on different hosts
+                    // sharing directory.
+                    static const uint64_t processTag = std::random_device{}();
+
+                    constexpr uint32_t maxAttempts = 16;
+                    for (uint32_t attempt = 0; attempt < maxAttempts; attempt++) {
+                        temporaryPath = path;
+                        temporaryPath += fmt::format(
+                            ".{}.{:08x}.{}.tmp",
+                            get_process_id(),
+                            processTag,
+                            temporaryFileCount.fetch_add(1, std::memory_order_relaxed)
+                        );
+                        errno = 0;
+                        // "x" makes fopen fail if file exists instead of truncating it.
+                        std::FILE* file = std::fopen(temporaryPath.string().c_str(), "wbx");
+                        if (file != nullptr) {
+                            return file;
+                        }
+                        if (errno != EEXIST) {
+                            break;
+                        }
+                    }
+                    error = last_error();
+                    return nullptr;
+                }
+            } // namespace
+
             std::string vulkan_version_to_string(uint32_t version) {
                 std::stringstream ss;
                 ss << vk::apiVersionVariant(version) << "." << vk::apiVersionMajor(version) << "."
                    << vk::apiVersionMinor(version) << "." << vk::apiVersionPatch(version);
                 return ss.str();
             }
+
+            uint16_t float_to_float16_bits(float value) {
+                const auto     bits     = std::bit_cast<uint32_t>(value);
+                const auto     sign     = static_cast<uint32_t>((bits >> 16U) & 0x8000U);
+                const uint32_t exponent = (bits >> 23U) & 0xFFU;
+                uint32_t       mantissa = bits & 0x7FFFFFU;
+
+                if (exponent == 0xFFU) {
+                    // Infinity stays infinity, NaN stays quiet NaN.
+                    return static_cast<uint16_t>(sign | 0x7C00U | (mantissa != 0 ? 0x200U : 0U));
+                }
+                const int32_t halfExponent = static_cast<int32_t>(exponent) - 127 + 15;
+                if (halfExponent >= 31) {
+                    return static_cast<uint16_t>(sign | 0x7C00U);
+                }
+                // Number of low mantissa bits dropped, more for subnormal results.
+                uint32_t shift = 13;
+                if (halfExponent <= 0) {
+                    if (halfExponent < -10) {
+                        return static_cast<uint16_t>(sign);
+                    }
+                    mantissa |= 0x800000U;
+                    shift = static_cast<uint32_t>(14 - halfExponent);
+                }
+                uint32_t half = mantissa >> shift;
+                if (halfExponent > 0) {
+                    half |= static_cast<uint32_t>(halfExponent) << 10U;
+                }
+                const uint32_t remainder = mantissa & ((1U << shift) - 1U);
+                const uint32_t halfway   = 1U << (shift - 1U);
+                // Carry out of mantissa correctly increments exponent, up to infinity.
+                if (remainder > halfway || (remainder == halfway && (half & 1U) != 0)) {
+                    half++;
+                }
+                return static_cast<uint16_t>(sign | half);
+            }
+
+            float float16_bits_to_float(uint16_t bits) {
+                const uint32_t sign     = static_cast<uint32_t>(bits & 0x8000U) << 16U;
+                const uint32_t exponent = (bits >> 10U) & 0x1FU;
+                const uint32_t mantissa = bits & 0x3FFU;
+
+                if (exponent == 0) {
+                    const float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+                    return sign != 0 ? -magnitude : magnitude;
+                }
+                if (exponent == 0x1FU) {
+                    return std::bit_cast<float>(sign | 0x7F800000U | (mantissa << 13U));
+                }
+                return std::bit_cast<float>(
+                    sign | ((exponent + 127 - 15) << 23U) | (mantissa << 13U)
+                );
+            }
+
+            std::array<float, 2> double_to_float_pair(double value) {
+                const auto high = static_cast<float>(value);
+                if (!std::isfinite(high)) {
+                    return {high, 0.0F};
+                }
+                return {high, static_cast<float>(value - static_cast<double>(high))};
+            }
+
+            double float_pair_to_double(const std::array<float, 2>& pair) {
+                return static_cast<double>(pair[0]) + static_cast<double>(pair[1]);
+            }
+
+            std::error_code write_file_atomically(
+                const std::filesystem::path& path, std::span<const std::byte> data
+            ) {
+                std::error_code error{};
+                if (path.has_parent_path()) {
+                    std::filesystem::create_directories(path.parent_path(), error);
+                    if (error) {
+                        return error;
+                    }
+                }
+                std::filesystem::path temporaryPath{};
+                std::FILE*            file = create_temporary_file(path, temporaryPath, error);
+                if (file == nullptr) {
+                    return error;
+                }
+                errno = 0;
+                if (std::fwrite(data.data(), 1, data.size(), file) != data.size() ||
+                    std::fflush(file) != 0) {
+                    error = last_error();
+                }
+                if (std::fclose(file) != 0 && !error) {
+                    error = last_error();
+                }
+                if (!error) {
+                    std::filesystem::rename(temporaryPath, path, error);
+                }
+                if (error) {
+                    std::error_code ignored{};
+                    std::filesystem::remove(temporaryPath, ignored);
+                }
+                return error;
+            }
         } // namespace common
     }     // namespace gpu
 } // namespace epseon
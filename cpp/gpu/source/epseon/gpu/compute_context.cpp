@@ -3,16 +3,21 @@
 #include "epseon/gpu/common.hpp"
 #include "epseon/gpu/compute_context.hpp"
 #include "epseon/gpu/device_interface.hpp"
+#include "epseon/gpu/multi_device_interface.hpp"
+#include "epseon/gpu/pipeline_cache.hpp"
 #include "spdlog/sinks/basic_file_sink.h"
 #include "spdlog/spdlog.h"
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <filesystem>
 #include <iostream>
 #include <memory>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace epseon::gpu::cpp {
 
@@ -22,23 +27,29 @@ namespace epseon::gpu::cpp {
         std::shared_ptr<spdlog::logger>      logger_,
         std::shared_ptr<vk::raii::Context>   context_,
         std::shared_ptr<vk::ApplicationInfo> application_info_,
-        std::shared_ptr<vk::raii::Instance>  instance_
+        std::shared_ptr<vk::raii::Instance>  instance_,
+        std::filesystem::path                pipelineCacheDirectory_
     ) :
         logger(std::move(logger_)),
         context(std::move(context_)),
         application_info(std::move(application_info_)),
-        instance(std::move(instance_)) {}
+        instance(std::move(instance_)),
+        pipelineCacheDirectory(std::move(pipelineCacheDirectory_)) {}
 
     ComputeContext::ComputeContext(
         std::shared_ptr<spdlog::logger>      logger_,
         std::shared_ptr<vk::raii::Context>   context_,
         std::shared_ptr<vk::ApplicationInfo> application_info_,
-        std::shared_ptr<vk::raii::Instance>  instance_
+        std::shared_ptr<vk::raii::Instance>  instance_,
+        std::filesystem::path                pipelineCacheDirectory_
     ) :
-        state(std::make_shared<ComputeContextState>(logger_, context_, application_info_, instance_)
-        ) {}
+        state(std::make_shared<ComputeContextState>(
+            logger_, context_, application_info_, instance_, std::move(pipelineCacheDirectory_)
+        )) {}
 
-    std::shared_ptr<ComputeContext> ComputeContext::create(uint32_t version) {
+    std::shared_ptr<ComputeContext> ComputeContext::create(
+        uint32_t version, std::optional<std::filesystem::path> pipelineCacheDirectory
+    ) {
         auto logger = spdlog::get("_libepseon_gpu");
         if (!logger) {
             logger = spdlog::basic_logger_mt("_libepseon_gpu", "./log/epseon/gpu/log.txt");
@@ -83,7 +94,13 @@ namespace epseon::gpu::cpp {
             std::move(context->createInstance(instanceCreateInfo))
         );
 
-        return std::make_shared<ComputeContext>(logger, context, applicationInfo, instance);
+        return std::make_shared<ComputeContext>(
+            logger,
+            context,
+            applicationInfo,
+            instance,
+            pipelineCacheDirectory.value_or(PipelineCache::getDefaultDirectory())
+        );
     }
 
     std::string ComputeContext::getVulkanAPIVersion() {
@@ -115,4 +132,25 @@ namespace epseon::gpu::cpp {
         }
         throw std::runtime_error("Device not available.");
     };
+
+    std::shared_ptr<MultiDeviceInterface>
+    ComputeContext::getMultiDeviceInterface(const std::vector<uint32_t>& deviceIds) {
+        std::vector<std::shared_ptr<ComputeDeviceInterface>> devices;
+
+        if (deviceIds.empty()) {
+            // Enumerated directly, identical cards share deviceID.
+            for (auto& physicalDevice : vk::raii::PhysicalDevices{this->state->getVkInstance()}) {
+                auto physicalDevicePtr =
+                    std::make_shared<vk::raii::PhysicalDevice>(std::move(physicalDevice));
+                devices.push_back(
+                    std::make_shared<ComputeDeviceInterface>(this->state, physicalDevicePtr)
+                );
+            }
+        } else {
+            for (const auto deviceId : deviceIds) {
+                devices.push_back(this->getDeviceInterface(deviceId));
+            }
+        }
+        return std::make_shared<MultiDeviceInterface>(std::move(devices));
+    }
 } // namespace epseon::gpu::cpp
@@ -0,0 +1,356 @@
+#include "epseon/vulkan_headers.hpp"
+
+#include "epseon/libepseon.hpp"
+
+#include "epseon/gpu/compute_context.hpp"
+#include "epseon/gpu/device_context.hpp"
+#include "epseon/gpu/pipeline_cache.hpp"
+#include "fmt/format.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace epseon::gpu::cpp {
+
+    DeviceContext::CommandPoolLease::CommandPoolLease(
+        std::shared_ptr<DeviceContext>         owner_,
+        uint32_t                               queueFamilyIndex_,
+        std::unique_ptr<vk::raii::CommandPool> pool_
+    ) :
+        owner(std::move(owner_)),
+        queueFamilyIndex(queueFamilyIndex_),
+        pool(std::move(pool_)) {}
+
+    DeviceContext::CommandPoolLease::~CommandPoolLease() {
+        if (this->owner && this->pool) {
+            this->owner->releaseCommandPool(this->queueFamilyIndex, std::move(this->pool));
+        }
+    }
+
+    DeviceContext::DeviceContext(
+        const ComputeContextState&      computeContextState,
+        const vk::raii::PhysicalDevice& physicalDevice,
+        const PipelineCache&            pipelineCache_
+    ) :
+        logger(computeContextState.logger),
+        queueFamilyIndex(selectQueueFamilyIndex(physicalDevice)),
+        transferQueueFamilyIndex(selectTransferQueueFamilyIndex(physicalDevice)) {
+        const auto supportedFeatures = physicalDevice.getFeatures();
+
+        // Shader indexes descriptor arrays with workgroup index.
+        if (!supportedFeatures.shaderStorageBufferArrayDynamicIndexing) {
+            throw std::runtime_error(
+                "Device doesn't support dynamic indexing of storage buffer arrays."
+            );
+        }
+        this->enabledFeatures.setShaderStorageBufferArrayDynamicIndexing(VK_TRUE);
+        // Used by Float64 tasks when available, otherwise they fall back to emulated Float64.
+        this->enabledFeatures.setShaderFloat64(supportedFeatures.shaderFloat64);
+
+        // Batches in flight are ordered with timeline semaphores. Instance targets
+        // Vulkan 1.1, so they come from extension rather than core 1.2.
+        if (!hasExtension(physicalDevice, VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME) ||
+            !physicalDevice
+                 .getFeatures2<
+                     vk::PhysicalDeviceFeatures2,
+                     vk::PhysicalDeviceTimelineSemaphoreFeatures>()
+                 .get<vk::PhysicalDeviceTimelineSemaphoreFeatures>()
+                 .timelineSemaphore) {
+            throw std::runtime_error("Device doesn't support timeline semaphores.");
+        }
+
+        std::array<float, 1>                   queuePriorities = {1.0F};
+        std::vector<vk::DeviceQueueCreateInfo> queueCreateInfos{
+            vk::DeviceQueueCreateInfo()
+                .setQueueFamilyIndex(this->queueFamilyIndex)
+                .setQueueCount(1)
+                .setPQueuePriorities(queuePriorities.data())
+        };
+        if (this->transferQueueFamilyIndex) {
+            queueCreateInfos.push_back(vk::DeviceQueueCreateInfo()
+                                           .setQueueFamilyIndex(*this->transferQueueFamilyIndex)
+                                           .setQueueCount(1)
+                                           .setPQueuePriorities(queuePriorities.data()));
+        }
+        std::vector<const char*> deviceExtensions{VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME};
+
+        // Optional, shaders can address buffers directly instead of through descriptor
+        // arrays, which are limited in size and have to be written for every task.
+        this->bufferDeviceAddressEnabled =
+            hasExtension(physicalDevice, VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME) &&
+            physicalDevice
+                .getFeatures2<
+                    vk::PhysicalDeviceFeatures2,
+                    vk::PhysicalDeviceBufferDeviceAddressFeatures>()
+                .get<vk::PhysicalDeviceBufferDeviceAddressFeatures>()
+                .bufferDeviceAddress;
+        if (this->bufferDeviceAddressEnabled) {
+            deviceExtensions.push_back(VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME);
+        }
+        // Optional, needed only by tasks with Float16 storage, those check if it was
+        // enabled. Core in Vulkan 1.1, so no extension is needed.
+        this->float16StorageEnabled =
+            physicalDevice
+                .getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDevice16BitStorageFeatures>()
+                .get<vk::PhysicalDevice16BitStorageFeatures>()
+                .storageBuffer16BitAccess;
+        // Optional, used only for timestamp queries of tasks, see TaskTimings.
+        this->hostQueryResetEnabled =
+            hasExtension(physicalDevice, VK_EXT_HOST_QUERY_RESET_EXTENSION_NAME) &&
+            physicalDevice
+                .getFeatures2<
+                    vk::PhysicalDeviceFeatures2,
+                    vk::PhysicalDeviceHostQueryResetFeatures>()
+                .get<vk::PhysicalDeviceHostQueryResetFeatures>()
+                .hostQueryReset;
+        if (this->hostQueryResetEnabled) {
+            deviceExtensions.push_back(VK_EXT_HOST_QUERY_RESET_EXTENSION_NAME);
+        }
+        // Optional, lets batch planning account for memory used by other processes.
+        this->memoryBudgetEnabled =
+            hasExtension(physicalDevice, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+        if (this->memoryBudgetEnabled) {
+            deviceExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+        }
+
+        vk::StructureChain<
+            vk::DeviceCreateInfo,
+            vk::PhysicalDeviceTimelineSemaphoreFeatures,
+            vk::PhysicalDeviceBufferDeviceAddressFeatures,
+            vk::PhysicalDevice16BitStorageFeatures,
+            vk::PhysicalDeviceHostQueryResetFeatures>
+            deviceCreateInfo{
+                vk::DeviceCreateInfo()
+                    .setQueueCreateInfos(queueCreateInfos)
+                    .setPEnabledExtensionNames(deviceExtensions)
+                    .setPEnabledFeatures(&this->enabledFeatures),
+                vk::PhysicalDeviceTimelineSemaphoreFeatures().setTimelineSemaphore(VK_TRUE),
+                vk::PhysicalDeviceBufferDeviceAddressFeatures().setBufferDeviceAddress(VK_TRUE),
+                vk::PhysicalDevice16BitStorageFeatures().setStorageBuffer16BitAccess(VK_TRUE),
+                vk::PhysicalDeviceHostQueryResetFeatures().setHostQueryReset(VK_TRUE)
+            };
+        if (!this->bufferDeviceAddressEnabled) {
+            deviceCreateInfo.unlink<vk::PhysicalDeviceBufferDeviceAddressFeatures>();
+        }
+        if (!this->float16StorageEnabled) {
+            deviceCreateInfo.unlink<vk::PhysicalDevice16BitStorageFeatures>();
+        }
+        if (!this->hostQueryResetEnabled) {
+            deviceCreateInfo.unlink<vk::PhysicalDeviceHostQueryResetFeatures>();
+        }
+        this->device = physicalDevice.createDevice(deviceCreateInfo.get<vk::DeviceCreateInfo>());
+        this->queue = this->device.getQueue(this->queueFamilyIndex, 0);
+        if (this->transferQueueFamilyIndex) {
+            this->transferQueue = this->device.getQueue(*this->transferQueueFamilyIndex, 0);
+        }
+
+        const auto& instance  = computeContextState.getVkInstance();
+        auto        functions = vma::VulkanFunctions();
+
+        functions.setVkGetInstanceProcAddr(instance.getDispatcher()->vkGetInstanceProcAddr)
+            .setVkGetDeviceProcAddr(instance.getDispatcher()->vkGetDeviceProcAddr);
+
+        LIB_EPSEON_ASSERT_TRUE(functions.vkGetInstanceProcAddr != nullptr);
+        LIB_EPSEON_ASSERT_TRUE(functions.vkGetDeviceProcAddr != nullptr);
+
+        vma::AllocatorCreateFlags allocatorFlags{};
+        if (this->bufferDeviceAddressEnabled) {
+            allocatorFlags |= vma::AllocatorCreateFlagBits::eBufferDeviceAddress;
+        }
+        if (this->memoryBudgetEnabled) {
+            allocatorFlags |= vma::AllocatorCreateFlagBits::eExtMemoryBudget;
+        }
+
+        vma::Allocator allocator_ =
+            vma::createAllocator(vma::AllocatorCreateInfo()
+                                     .setVulkanApiVersion(computeContextState.getVulkanApiVersion())
+                                     .setInstance(*instance)
+                                     .setPhysicalDevice(*physicalDevice)
+                                     .setDevice(*this->device)
+                                     .setPVulkanFunctions(&functions)
+                                     .setFlags(allocatorFlags));
+        // vma::raii::Allocator is a transparent wrapper taking over ownership of handle.
+        this->allocator = std::make_shared<vma::raii::Allocator>(allocator_);
+
+        this->pipelineCache = pipelineCache_.createVkPipelineCache(this->device);
+
+        this->logger->info(
+            "Created logical device for {}, {}, {}.",
+            static_cast<const char*>(physicalDevice.getProperties().deviceName),
+            this->transferQueueFamilyIndex ? "with dedicated transfer queue"
+                                           : "without dedicated transfer queue",
+            this->bufferDeviceAddressEnabled ? "with buffer device address"
+                                             : "without buffer device address"
+        );
+    }
+
+    DeviceContext::~DeviceContext() {
+        // Pools have to be destroyed before allocator, which is destroyed with members.
+        for (auto& [key, pool] : this->memoryPools) {
+            this->allocator->destroyPool(pool);
+        }
+    }
+
+    std::vector<vma::Budget> DeviceContext::getHeapBudgets() const {
+        const auto* memoryProperties = this->allocator->getMemoryProperties();
+
+        std::vector<vma::Budget> budgets(memoryProperties->memoryHeapCount);
+        this->allocator->getHeapBudgets(budgets.data());
+        return budgets;
+    }
+
+    vk::raii::Semaphore DeviceContext::createTimelineSemaphore(uint64_t initialValue) const {
+        const auto semaphoreTypeCreateInfo = vk::SemaphoreTypeCreateInfo()
+                                                 .setSemaphoreType(vk::SemaphoreType::eTimeline)
+                                                 .setInitialValue(initialValue);
+
+        return this->device.createSemaphore(
+            vk::SemaphoreCreateInfo().setPNext(&semaphoreTypeCreateInfo)
+        );
+    }
+
+    void DeviceContext::waitForTimelineSemaphore(
+        const vk::raii::Semaphore& semaphore, uint64_t value
+    ) const {
+        const auto result = this->device.waitSemaphores(
+            vk::SemaphoreWaitInfo().setSemaphores(*semaphore).setValues(value), UINT64_MAX
+        );
+        if (result != vk::Result::eSuccess) {
+            throw std::runtime_error(
+                fmt::format("Waiting for timeline semaphore failed: {}", vk::to_string(result))
+            );
+        }
+    }
+
+    bool DeviceContext::waitForTimelineSemaphore(
+        const vk::raii::Semaphore& semaphore, uint64_t value, std::chrono::nanoseconds timeout
+    ) const {
+        const auto result = this->device.waitSemaphores(
+            vk::SemaphoreWaitInfo().setSemaphores(*semaphore).setValues(value),
+            static_cast<uint64_t>(std::max(timeout.count(), std::chrono::nanoseconds::rep{0}))
+        );
+        if (result == vk::Result::eTimeout) {
+            return false;
+        }
+        if (result != vk::Result::eSuccess) {
+            throw std::runtime_error(
+                fmt::format("Waiting for timeline semaphore failed: {}", vk::to_string(result))
+            );
+        }
+        return true;
+    }
+
+    void DeviceContext::submit(const vk::SubmitInfo& submitInfo, vk::Fence fence) {
+        std::lock_guard<std::mutex> lock{this->queueMutex};
+        this->queue.submit(submitInfo, fence);
+    }
+
+    void DeviceContext::submitTransfer(const vk::SubmitInfo& submitInfo, vk::Fence fence) {
+        if (!this->transferQueueFamilyIndex) {
+            this->submit(submitInfo, fence);
+            return;
+        }
+        std::lock_guard<std::mutex> lock{this->transferQueueMutex};
+        this->transferQueue.submit(submitInfo, fence);
+    }
+
+    DeviceContext::CommandPoolLease DeviceContext::acquireCommandPool(uint32_t queueFamilyIndex_) {
+        LIB_EPSEON_ASSERT_TRUE(
+            queueFamilyIndex_ == this->queueFamilyIndex ||
+            queueFamilyIndex_ == this->getTransferQueueFamilyIndex()
+        );
+        {
+            std::lock_guard<std::mutex> lock{this->commandPoolsMutex};
+            auto&                       pools = this->commandPools[queueFamilyIndex_];
+            if (!pools.empty()) {
+                auto pool = std::move(pools.back());
+                pools.pop_back();
+                return {this->shared_from_this(), queueFamilyIndex_, std::move(pool)};
+            }
+        }
+        return {
+            this->shared_from_this(),
+            queueFamilyIndex_,
+            std::make_unique<vk::raii::CommandPool>(this->device.createCommandPool(
+                vk::CommandPoolCreateInfo()
+                    .setFlags(vk::CommandPoolCreateFlagBits::eResetCommandBuffer)
+                    .setQueueFamilyIndex(queueFamilyIndex_)
+            ))
+        };
+    }
+
+    void DeviceContext::releaseCommandPool(
+        uint32_t queueFamilyIndex_, std::unique_ptr<vk::raii::CommandPool> pool
+    ) {
+        // Give memory of command buffers back to pool, so that next task starts clean.
+        pool->reset();
+
+        std::lock_guard<std::mutex> lock{this->commandPoolsMutex};
+        this->commandPools[queueFamilyIndex_].push_back(std::move(pool));
+    }
+
+    vma::Pool DeviceContext::getMemoryPool(uint32_t memoryTypeIndex, vk::DeviceSize blockSize) {
+        std::lock_guard<std::mutex> lock{this->memoryPoolsMutex};
+
+        auto [iterator, inserted] =
+            this->memoryPools.try_emplace({memoryTypeIndex, blockSize}, vma::Pool{});
+        if (inserted) {
+            try {
+                iterator->second = this->allocator->createPool(
+                    vma::PoolCreateInfo().setMemoryTypeIndex(memoryTypeIndex).setBlockSize(blockSize)
+                );
+            } catch (...) {
+                this->memoryPools.erase(iterator);
+                throw;
+            }
+        }
+        return iterator->second;
+    }
+
+    bool DeviceContext::hasExtension(
+        const vk::raii::PhysicalDevice& physicalDevice, std::string_view extensionName
+    ) {
+        const auto extensions = physicalDevice.enumerateDeviceExtensionProperties();
+        return std::any_of(
+            extensions.begin(),
+            extensions.end(),
+            [extensionName](const vk::ExtensionProperties& properties) {
+                return extensionName == static_cast<const char*>(properties.extensionName);
+            }
+        );
+    }
+
+    uint32_t DeviceContext::selectQueueFamilyIndex(const vk::raii::PhysicalDevice& physicalDevice
+    ) {
+        for (uint32_t i = 0; const auto& queue : physicalDevice.getQueueFamilyProperties()) {
+            if ((queue.queueFlags & vk::QueueFlagBits::eCompute) &&
+                (queue.queueFlags & vk::QueueFlagBits::eTransfer)) {
+                return i;
+            }
+            i++;
+        }
+        throw std::runtime_error("Device has no queue family supporting compute and transfer.");
+    }
+
+    std::optional<uint32_t>
+    DeviceContext::selectTransferQueueFamilyIndex(const vk::raii::PhysicalDevice& physicalDevice) {
+        for (uint32_t i = 0; const auto& queue : physicalDevice.getQueueFamilyProperties()) {
+            if ((queue.queueFlags & vk::QueueFlagBits::eTransfer) &&
+                !(queue.queueFlags & (vk::QueueFlagBits::eCompute | vk::QueueFlagBits::eGraphics)
+                )) {
+                return i;
+            }
+            i++;
+        }
+        return std::nullopt;
+    }
+} // namespace epseon::gpu::cpp
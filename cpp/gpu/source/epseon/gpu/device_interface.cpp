@@ -1,6 +1,12 @@
+#include "epseon/gpu/autotuner.hpp"
+#include "epseon/gpu/device_context.hpp"
 #include "epseon/gpu/device_interface.hpp"
-#include "epseon/gpu/task_configurator/task_configurator.hpp"
+#include "epseon/gpu/pipeline_cache.hpp"
+#include "epseon/task_configurator/task_configurator.hpp"
+#include <algorithm>
+#include <array>
 #include <memory>
+#include <mutex>
 
 #include "epseon/vulkan_headers.hpp"
 
@@ -12,11 +18,50 @@ namespace epseon {
                 std::shared_ptr<vk::raii::PhysicalDevice> physicalDevice_
             ) :
                 computeContextState(computeContextState_),
-                physicalDevice(physicalDevice_) {}
+                physicalDevice(physicalDevice_),
+                pipelineCache(std::make_shared<PipelineCache>(
+                    computeContextState_->logger,
+                    computeContextState_->getPipelineCacheDirectory(),
+                    physicalDevice_->getProperties()
+                )) {
+                const auto properties = physicalDevice_->getProperties2<
+                    vk::PhysicalDeviceProperties2,
+                    vk::PhysicalDeviceIDProperties>();
+                const auto& deviceUUID =
+                    properties.get<vk::PhysicalDeviceIDProperties>().deviceUUID;
+
+                // Tuned settings depend on hardware only, not on driver like pipeline
+                // cache, so results are keyed by device UUID.
+                std::array<uint8_t, VK_UUID_SIZE> uuid{};
+                std::copy(deviceUUID.begin(), deviceUUID.end(), uuid.begin());
+                this->autotuneCache = std::make_shared<AutotuneCache>(
+                    computeContextState_->logger,
+                    computeContextState_->getPipelineCacheDirectory(),
+                    uuid
+                );
+            }
 
             const vk::raii::PhysicalDevice& ComputeDeviceInterface::getPhysicalDevice() const {
                 return *this->physicalDevice;
             }
+
+            PipelineCache& ComputeDeviceInterface::getPipelineCache() const {
+                return *this->pipelineCache;
+            }
+
+            AutotuneCache& ComputeDeviceInterface::getAutotuneCache() const {
+                return *this->autotuneCache;
+            }
+
+            std::shared_ptr<DeviceContext> ComputeDeviceInterface::getDeviceContext() const {
+                std::lock_guard<std::mutex> lock{this->deviceContextMutex};
+                if (!this->deviceContext) {
+                    this->deviceContext = std::make_shared<DeviceContext>(
+                        *this->computeContextState, *this->physicalDevice, *this->pipelineCache
+                    );
+                }
+                return this->deviceContext;
+            }
         } // namespace cpp
     }     // namespace gpu
 } // namespace epseon
@@ -0,0 +1,89 @@
+#include "epseon/libepseon.hpp"
+
+#include "epseon/gpu/multi_device_interface.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace epseon::gpu::cpp {
+
+    MultiDeviceInterface::MultiDeviceInterface(
+        std::vector<std::shared_ptr<ComputeDeviceInterface>> devices_
+    ) :
+        devices(std::move(devices_)),
+        throughput(this->devices.size(), 0.0) {
+        if (this->devices.empty()) {
+            throw std::runtime_error("MultiDeviceInterface requires at least one device.");
+        }
+    }
+
+    std::vector<double> MultiDeviceInterface::getThroughput() const {
+        std::lock_guard<std::mutex> lock{this->throughputMutex};
+        return this->throughput;
+    }
+
+    std::vector<size_t> MultiDeviceInterface::planShards(size_t potentialCount) const {
+        std::vector<double> weights = this->getThroughput();
+
+        const auto measuredCount = static_cast<size_t>(
+            std::count_if(weights.begin(), weights.end(), [](double w) { return w > 0.0; })
+        );
+        const double assumed =
+            measuredCount == 0
+                ? 1.0
+                : std::accumulate(weights.begin(), weights.end(), 0.0) /
+                      static_cast<double>(measuredCount);
+        for (auto& weight : weights) {
+            if (weight <= 0.0) {
+                weight = assumed;
+            }
+        }
+        const double total = std::accumulate(weights.begin(), weights.end(), 0.0);
+
+        // Largest remainder method, so that shard sizes sum up to potentialCount.
+        std::vector<size_t> shardSizes(weights.size());
+        std::vector<double> remainders(weights.size());
+        size_t              assigned = 0;
+        for (size_t i = 0; i < weights.size(); i++) {
+            const double exact = static_cast<double>(potentialCount) * weights[i] / total;
+            shardSizes[i]      = static_cast<size_t>(std::floor(exact));
+            remainders[i]      = exact - static_cast<double>(shardSizes[i]);
+            assigned += shardSizes[i];
+        }
+        LIB_EPSEON_ASSERT_TRUE(assigned <= potentialCount);
+
+        std::vector<size_t> order(weights.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&remainders](size_t lhs, size_t rhs) {
+            return remainders[lhs] > remainders[rhs];
+        });
+        for (size_t i = 0; assigned < potentialCount; i = (i + 1) % order.size()) {
+            shardSizes[order[i]]++;
+            assigned++;
+        }
+        return shardSizes;
+    }
+
+    void MultiDeviceInterface::recordThroughput(
+        size_t deviceIndex, size_t potentialPointCount, std::chrono::duration<double> elapsed
+    ) {
+        LIB_EPSEON_ASSERT_TRUE(deviceIndex < this->devices.size());
+        if (elapsed.count() <= 0.0) {
+            return;
+        }
+        const double measured = static_cast<double>(potentialPointCount) / elapsed.count();
+
+        std::lock_guard<std::mutex> lock{this->throughputMutex};
+        double&                     current = this->throughput[deviceIndex];
+        current = current <= 0.0
+                      ? measured
+                      : throughputSmoothing * measured + (1.0 - throughputSmoothing) * current;
+    }
+} // namespace epseon::gpu::cpp
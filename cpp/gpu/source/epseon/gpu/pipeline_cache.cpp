@@ -0,0 +1,149 @@
+#include "epseon/vulkan_headers.hpp"
+
+#include "epseon/gpu/pipeline_cache.hpp"
+
+#include "epseon/gpu/common.hpp"
+#include "fmt/format.h"
+#include "spdlog/spdlog.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace epseon::gpu::cpp {
+
+    namespace {
+        /* Header written by drivers at the beginning of pipeline cache data, see
+         * "Pipeline Cache Header" in Vulkan specification. */
+        struct PipelineCacheHeader {
+            uint32_t                          headerSize        = {};
+            uint32_t                          headerVersion     = {};
+            uint32_t                          vendorID          = {};
+            uint32_t                          deviceID          = {};
+            std::array<uint8_t, VK_UUID_SIZE> pipelineCacheUUID = {};
+        };
+
+        static_assert(sizeof(PipelineCacheHeader) == 16 + VK_UUID_SIZE);
+    } // namespace
+
+    PipelineCache::PipelineCache(
+        std::shared_ptr<spdlog::logger>     logger_,
+        const std::filesystem::path&        directory,
+        const vk::PhysicalDeviceProperties& deviceProperties_
+    ) :
+        logger(std::move(logger_)),
+        path(directory / getFileName(deviceProperties_)),
+        deviceProperties(deviceProperties_) {
+        this->load();
+    }
+
+    std::filesystem::path PipelineCache::getDefaultDirectory() {
+        const char* directory = std::getenv(directoryEnvironmentVariable);
+        if (directory != nullptr && *directory != '\0') {
+            return {directory};
+        }
+        return std::filesystem::path{"."} / "cache" / "epseon" / "gpu";
+    }
+
+    std::string PipelineCache::getFileName(const vk::PhysicalDeviceProperties& properties) {
+        std::string name{"pipeline_cache_"};
+        for (uint8_t byte : properties.pipelineCacheUUID) {
+            name += fmt::format("{:02x}", byte);
+        }
+        return name + ".bin";
+    }
+
+    std::vector<uint8_t> PipelineCache::getData() const {
+        std::lock_guard<std::mutex> lock{this->mutex};
+        return this->data;
+    }
+
+    bool PipelineCache::isCompatible(std::span<const uint8_t> cacheData) const {
+        PipelineCacheHeader header{};
+        if (cacheData.size() < sizeof(header)) {
+            return false;
+        }
+        std::memcpy(&header, cacheData.data(), sizeof(header));
+
+        return header.headerSize >= sizeof(header) &&
+               header.headerVersion ==
+                   static_cast<uint32_t>(vk::PipelineCacheHeaderVersion::eOne) &&
+               header.vendorID == this->deviceProperties.vendorID &&
+               header.deviceID == this->deviceProperties.deviceID &&
+               std::memcmp(
+                   header.pipelineCacheUUID.data(),
+                   this->deviceProperties.pipelineCacheUUID.data(),
+                   VK_UUID_SIZE
+               ) == 0;
+    }
+
+    vk::raii::PipelineCache PipelineCache::createVkPipelineCache(const vk::raii::Device& device
+    ) const {
+        std::lock_guard<std::mutex> lock{this->mutex};
+        return device.createPipelineCache(vk::PipelineCacheCreateInfo()
+                                              .setInitialDataSize(this->data.size())
+                                              .setPInitialData(this->data.data()));
+    }
+
+    void PipelineCache::store(const vk::raii::PipelineCache& pipelineCache) {
+        auto cacheData = pipelineCache.getData();
+        if (!this->isCompatible(cacheData)) {
+            this->logger->warn("Driver returned invalid pipeline cache data, not storing it.");
+            return;
+        }
+        std::lock_guard<std::mutex> lock{this->mutex};
+        if (cacheData == this->data) {
+            return;
+        }
+        this->data = std::move(cacheData);
+        this->save(this->data);
+    }
+
+    void PipelineCache::load() {
+        std::ifstream file{this->path, std::ios::binary};
+        if (!file) {
+            this->logger->info("Pipeline cache {} not found.", this->path.string());
+            return;
+        }
+        std::vector<uint8_t> cacheData(
+            (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>()
+        );
+        if (!this->isCompatible(cacheData)) {
+            this->logger->warn(
+                "Pipeline cache {} was created for different device or driver, ignoring it.",
+                this->path.string()
+            );
+            return;
+        }
+        this->logger->info(
+            "Loaded pipeline cache {} ({} bytes).", this->path.string(), cacheData.size()
+        );
+        this->data = std::move(cacheData);
+    }
+
+    void PipelineCache::save(std::span<const uint8_t> cacheData) const {
+        // Other instances for the same device, in this or other processes, may save
+        // concurrently, each of them writes its own temporary file.
+        const auto error = common::write_file_atomically(this->path, std::as_bytes(cacheData));
+        if (error) {
+            this->logger->warn(
+                "Failed to save pipeline cache {}: {}", this->path.string(), error.message()
+            );
+            return;
+        }
+        this->logger->info(
+            "Saved pipeline cache {} ({} bytes).", this->path.string(), cacheData.size()
+        );
+    }
+} // namespace epseon::gpu::cpp
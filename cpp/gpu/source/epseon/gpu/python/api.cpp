@@ -1,9 +1,10 @@
 
 
+#include "epseon/gpu/autotuner.hpp"
 #include "epseon/gpu/common.hpp"
 #include "epseon/gpu/compute_context.hpp"
 #include "epseon/gpu/enums.hpp"
-#include "epseon/gpu/task_configurator/task_configurator.hpp"
+#include "epseon/task_configurator/task_configurator.hpp"
 #include "fmt/format.h"
 #include "pybind11/detail/common.h"
 #include "pybind11/pytypes.h"
@@ -58,6 +59,50 @@ namespace epseon {
 
             // =========================================================================
 
+            /* Parse precision name, raising ValueError if it is invalid. */
+            static cpp::PrecisionType parsePrecisionType(const std::string& precision) {
+                try {
+                    return cpp::toPrecisionType(precision);
+                } catch (cpp::InvalidPrecisionTypeString e) {
+                    throw py::value_error(e.what());
+                }
+            }
+
+            /* Create task configurator of given precision with single or multi device
+             * interface. */
+            template <typename DeviceInterfaceT>
+            static TaskConfiguratorVariant
+            makeTaskConfigurator(DeviceInterfaceT& device, const std::string& precision) {
+                auto precision_enum_value = parsePrecisionType(precision);
+
+                PrecisionTypeAssertValueCount(4);
+                switch (precision_enum_value) {
+                    case cpp::PrecisionType::Float32:
+                        return TaskConfigurator<float>{
+                            device.template getTaskConfigurator<float>()
+                        };
+                    case cpp::PrecisionType::Float64:
+                        return TaskConfigurator<double>{
+                            device.template getTaskConfigurator<double>()
+                        };
+                    case cpp::PrecisionType::Float16: {
+                        // Float32 task with potentials stored in half precision on GPU.
+                        auto configurator = device.template getTaskConfigurator<float>();
+                        configurator->setStoragePrecision(cpp::PrecisionType::Float16);
+                        return TaskConfigurator<float>{configurator};
+                    }
+                    case cpp::PrecisionType::Float64Emulated: {
+                        // Float64 task forced to use double-float arithmetic on GPU.
+                        auto configurator = device.template getTaskConfigurator<double>();
+                        configurator->setStoragePrecision(cpp::PrecisionType::Float64Emulated);
+                        return TaskConfigurator<double>{configurator};
+                    }
+                    default:
+                        throw std::runtime_error("Unreachable.");
+                }
+                assert(false);
+            }
+
             ComputeDeviceInterface::ComputeDeviceInterface(
                 std::shared_ptr<cpp::ComputeDeviceInterface> device_
             ) :
@@ -65,24 +110,55 @@ namespace epseon {
 
             TaskConfiguratorVariant
             ComputeDeviceInterface::get_task_configurator(const std::string precision) {
-                auto precision_enum_value = [&precision]() {
-                    try {
-                        return cpp::toPrecisionType(precision);
-                    } catch (cpp::InvalidPrecisionTypeString e) {
-                        throw py::value_error(e.what());
-                    }
-                }();
+                return makeTaskConfigurator(*device, precision);
+            }
 
-                PrecisionTypeAssertValueCount(2);
-                switch (precision_enum_value) {
+            cpp::HardwareConfig<double> ComputeDeviceInterface::autotune_hardware_config(
+                const std::string& precision,
+                uint32_t           point_count,
+                uint32_t           level_count,
+                bool               use_cache
+            ) {
+                // Fields of hardware config don't depend on precision, only tuned values do.
+                auto toPython = [](const auto& config) {
+                    return cpp::HardwareConfig<double>{
+                        config->getPotentialBufferSize(),
+                        config->getGroupSize(),
+                        config->getAllocationBlockSize(),
+                        config->getWorkgroupSize()
+                    };
+                };
+                PrecisionTypeAssertValueCount(4);
+                switch (parsePrecisionType(precision)) {
+                    // Float16 storage tasks compute in Float32, emulated Float64 is tuned
+                    // as Float64, which falls back to it when needed.
                     case cpp::PrecisionType::Float32:
-                        return TaskConfigurator<float>{device->getTaskConfigurator<float>()};
+                    case cpp::PrecisionType::Float16:
+                        return toPython(device->autotuneHardwareConfig<float>(
+                            point_count, level_count, use_cache
+                        ));
                     case cpp::PrecisionType::Float64:
-                        return TaskConfigurator<double>{device->getTaskConfigurator<double>()};
+                    case cpp::PrecisionType::Float64Emulated:
+                        return toPython(device->autotuneHardwareConfig<double>(
+                            point_count, level_count, use_cache
+                        ));
                     default:
                         throw std::runtime_error("Unreachable.");
                 }
-                assert(false);
+            }
+
+            MultiDeviceInterface::MultiDeviceInterface(
+                std::shared_ptr<cpp::MultiDeviceInterface> devices_
+            ) :
+                devices(devices_) {}
+
+            TaskConfiguratorVariant
+            MultiDeviceInterface::get_task_configurator(const std::string precision) {
+                return makeTaskConfigurator(*devices, precision);
+            }
+
+            std::vector<double> MultiDeviceInterface::get_throughput() {
+                return devices->getThroughput();
             }
 
             EpseonComputeContext::EpseonComputeContext(
@@ -111,6 +187,12 @@ namespace epseon {
                 return {application->getDeviceInterface(device_id)};
             }
 
+            MultiDeviceInterface EpseonComputeContext::get_multi_device_interface(
+                const std::vector<uint32_t>& device_ids
+            ) {
+                return {application->getMultiDeviceInterface(device_ids)};
+            }
+
             PYBIND11_MODULE(_libepseon_gpu, m) {
                 m.doc() = "Sub package for interacting with GPU compute "
                           "capabilities.";
@@ -328,6 +410,121 @@ namespace epseon {
                     )
                     .doc() = "Container for physical device info retrieved from Vulkan API.";
 
+                // Python API - Durations in seconds, device ones are None when device
+                // doesn't support timestamp queries on queue used.
+                py::class_<cpp::TaskTimings>(m, "TaskTimings")
+                    .def_property_readonly(
+                        "potential_generation",
+                        [](const cpp::TaskTimings& timings) {
+                            return timings.potentialGeneration.count();
+                        }
+                    )
+                    .def_property_readonly(
+                        "device_setup",
+                        [](const cpp::TaskTimings& timings) {
+                            return timings.deviceSetup.count();
+                        }
+                    )
+                    .def_property_readonly(
+                        "resource_setup",
+                        [](const cpp::TaskTimings& timings) {
+                            return timings.resourceSetup.count();
+                        }
+                    )
+                    .def_property_readonly(
+                        "pipeline_setup",
+                        [](const cpp::TaskTimings& timings) {
+                            return timings.pipelineSetup.count();
+                        }
+                    )
+                    .def_property_readonly(
+                        "staging_write",
+                        [](const cpp::TaskTimings& timings) {
+                            return timings.stagingWrite.count();
+                        }
+                    )
+                    .def_property_readonly(
+                        "device_wait",
+                        [](const cpp::TaskTimings& timings) {
+                            return timings.deviceWait.count();
+                        }
+                    )
+                    .def_property_readonly(
+                        "read_back",
+                        [](const cpp::TaskTimings& timings) {
+                            return timings.readBack.count();
+                        }
+                    )
+                    .def_property_readonly(
+                        "total",
+                        [](const cpp::TaskTimings& timings) {
+                            return timings.total.count();
+                        }
+                    )
+                    .def_property_readonly(
+                        "device_upload",
+                        [](const cpp::TaskTimings& timings) -> std::optional<double> {
+                            if (!timings.deviceUpload) {
+                                return std::nullopt;
+                            }
+                            return timings.deviceUpload->count();
+                        }
+                    )
+                    .def_property_readonly(
+                        "device_compute",
+                        [](const cpp::TaskTimings& timings) -> std::optional<double> {
+                            if (!timings.deviceCompute) {
+                                return std::nullopt;
+                            }
+                            return timings.deviceCompute->count();
+                        }
+                    )
+                    .def_readonly("batch_count", &cpp::TaskTimings::batchCount)
+                    .def_readonly("dispatch_count", &cpp::TaskTimings::dispatchCount)
+                    .doc() = "Time spent by GPU compute task in each of its phases.";
+
+                py::class_<cpp::TaskProgress>(m, "TaskProgress")
+                    .def_property_readonly(
+                        "phase",
+                        [](const cpp::TaskProgress& progress) {
+                            return cpp::toString(progress.phase);
+                        }
+                    )
+                    .def_readonly("potential_count", &cpp::TaskProgress::potentialCount)
+                    .def_readonly("potentials_completed", &cpp::TaskProgress::potentialsCompleted)
+                    .def_readonly("levels_found", &cpp::TaskProgress::levelsFound)
+                    .def_readonly("bytes_uploaded", &cpp::TaskProgress::bytesUploaded)
+                    .def_readonly("bytes_read_back", &cpp::TaskProgress::bytesReadBack)
+                    .doc() = "Snapshot of progress of GPU compute task.";
+
+                py::class_<ResultIterator<float>>(m, "ResultIteratorFloat32")
+                    .def(
+                        "__iter__",
+                        [](ResultIterator<float>& iterator) -> ResultIterator<float>& {
+                            return iterator;
+                        }
+                    )
+                    .def(
+                        "__next__",
+                        &ResultIterator<float>::next,
+                        "Get first potential index and level energies of next finished batch."
+                    )
+                    .doc() = "Iterator over batches of streamed single precision task results.";
+
+                py::class_<ResultIterator<double>>(m, "ResultIteratorFloat64")
+                    .def(
+                        "__iter__",
+                        [](ResultIterator<double>& iterator) -> ResultIterator<double>& {
+                            return iterator;
+                        }
+                    )
+                    .def(
+                        "__next__",
+                        &ResultIterator<double>::next,
+                        "Get first potential index and level energies of next finished batch."
+                    )
+                    .doc() = "Iterator over batches of streamed double precision task results.";
+
                 py::class_<TaskHandleFloat32>(m, "TaskHandleFloat32")
                     .def(
                         "get_status_message",
@@ -339,7 +536,43 @@ namespace epseon {
                         &TaskHandleFloat32::is_done,
                         "Check if task already finished execution."
                     )
-                    .def("wait", &TaskHandleFloat32::wait, "Block and wait for task to finish.")
+                    .def(
+                        "wait",
+                        &TaskHandleFloat32::wait,
+                        // Worker may need GIL to finish, e.g. to release NumPy array.
+                        py::call_guard<py::gil_scoped_release>(),
+                        "Block and wait for task to finish."
+                    )
+                    .def(
+                        "cancel",
+                        &TaskHandleFloat32::cancel,
+                        "Request task to stop, results computed so far are kept."
+                    )
+                    .def(
+                        "get_results",
+                        &TaskHandleFloat32::get_results,
+                        "Get energies of vibrational levels, one list per potential."
+                    )
+                    .def(
+                        "get_results_array",
+                        &TaskHandleFloat32::get_results_array,
+                        "Get energies of vibrational levels as read-only NumPy array."
+                    )
+                    .def(
+                        "get_timings",
+                        &TaskHandleFloat32::get_timings,
+                        "Get time spent in phases of finished task."
+                    )
+                    .def(
+                        "get_progress",
+                        &TaskHandleFloat32::get_progress,
+                        "Get progress of task without blocking."
+                    )
+                    .def(
+                        "stream_results",
+                        &TaskHandleFloat32::stream_results,
+                        "Get iterator over batches of results as soon as they are finished."
+                    )
                     .doc() = "Handle object for referencing double precision GPU compute task.";
 
                 py::class_<TaskHandleFloat64>(m, "TaskHandleFloat64")
@@ -353,7 +586,43 @@ namespace epseon {
                         &TaskHandleFloat64::is_done,
                         "Check if task already finished execution."
                     )
-                    .def("wait", &TaskHandleFloat64::wait, "Block and wait for task to finish.")
+                    .def(
+                        "wait",
+                        &TaskHandleFloat64::wait,
+                        // Worker may need GIL to finish, e.g. to release NumPy array.
+                        py::call_guard<py::gil_scoped_release>(),
+                        "Block and wait for task to finish."
+                    )
+                    .def(
+                        "cancel",
+                        &TaskHandleFloat64::cancel,
+                        "Request task to stop, results computed so far are kept."
+                    )
+                    .def(
+                        "get_results",
+                        &TaskHandleFloat64::get_results,
+                        "Get energies of vibrational levels, one list per potential."
+                    )
+                    .def(
+                        "get_results_array",
+                        &TaskHandleFloat64::get_results_array,
+                        "Get energies of vibrational levels as read-only NumPy array."
+                    )
+                    .def(
+                        "get_timings",
+                        &TaskHandleFloat64::get_timings,
+                        "Get time spent in phases of finished task."
+                    )
+                    .def(
+                        "get_progress",
+                        &TaskHandleFloat64::get_progress,
+                        "Get progress of task without blocking."
+                    )
+                    .def(
+                        "stream_results",
+                        &TaskHandleFloat64::stream_results,
+                        "Get iterator over batches of results as soon as they are finished."
+                    )
                     .doc() = "Handle object for referencing double precision GPU compute task.";
 
                 py::class_<MorsePotentialConfig>(m, "MorsePotentialConfig")
@@ -377,7 +646,9 @@ namespace epseon {
                         py::arg("potential_buffer_size"),
                         py::arg("group_size"),
                         py::arg("allocation_block_size"),
-                        "Set hardware configuration for a GPU compute task."
+                        py::arg("workgroup_size") = 0,
+                        "Set hardware configuration for a GPU compute task, workgroup size 0 "
+                        "selects default one."
                     )
                     .def(
                         "set_morse_potential",
@@ -386,6 +657,20 @@ namespace epseon {
                         "Set potential data source configuration for GPU compute "
                         "task."
                     )
+                    .def(
+                        "set_potential_array",
+                        &TaskConfiguratorFloat32::set_potential_array,
+                        py::arg("array").noconvert(),
+                        "Set potential curves given as C-contiguous 2D array, one row per "
+                        "potential."
+                    )
+                    .def(
+                        "set_potential_files",
+                        &TaskConfiguratorFloat32::set_potential_files,
+                        py::arg("file_names"),
+                        "Set potential curves stored in binary potential files, curves of all "
+                        "files are used in order of files."
+                    )
                     .def(
                         "set_vibwa_algorithm",
                         &TaskConfiguratorFloat32::set_vibwa_algorithm,
@@ -416,7 +701,9 @@ namespace epseon {
                         py::arg("potential_buffer_size"),
                         py::arg("group_size"),
                         py::arg("allocation_block_size"),
-                        "Set hardware configuration for a GPU compute task."
+                        py::arg("workgroup_size") = 0,
+                        "Set hardware configuration for a GPU compute task, workgroup size 0 "
+                        "selects default one."
                     )
                     .def(
                         "set_morse_potential",
@@ -425,6 +712,20 @@ namespace epseon {
                         "Set potential data source configuration for GPU compute "
                         "task."
                     )
+                    .def(
+                        "set_potential_array",
+                        &TaskConfiguratorFloat64::set_potential_array,
+                        py::arg("array").noconvert(),
+                        "Set potential curves given as C-contiguous 2D array, one row per "
+                        "potential."
+                    )
+                    .def(
+                        "set_potential_files",
+                        &TaskConfiguratorFloat64::set_potential_files,
+                        py::arg("file_names"),
+                        "Set potential curves stored in binary potential files, curves of all "
+                        "files are used in order of files."
+                    )
                     .def(
                         "set_vibwa_algorithm",
                         &TaskConfiguratorFloat64::set_vibwa_algorithm,
@@ -447,6 +748,33 @@ namespace epseon {
                     )
                     .doc() = "Builder for configuring GPU compute task.";
 
+                // Python API - Wrapper around hardware configuration of task.
+                py::class_<
+                    cpp::HardwareConfig<double>,
+                    std::shared_ptr<cpp::HardwareConfig<double>>>(m, "HardwareConfig")
+                    .def_readonly(
+                        "potential_buffer_size", &cpp::HardwareConfig<double>::potential_buffer_size
+                    )
+                    .def_readonly("group_size", &cpp::HardwareConfig<double>::group_size)
+                    .def_readonly(
+                        "allocation_block_size", &cpp::HardwareConfig<double>::allocation_block_size
+                    )
+                    .def_readonly("workgroup_size", &cpp::HardwareConfig<double>::workgroup_size)
+                    .doc() = "Hardware configuration of GPU compute task.";
+
+                // Python API - Wrapper around plan of task execution.
+                py::class_<cpp::VibwaBatchPlan>(m, "BatchPlan")
+                    .def_readonly("potentials_per_batch", &cpp::VibwaBatchPlan::potentialsPerBatch)
+                    .def_readonly(
+                        "potentials_per_buffer", &cpp::VibwaBatchPlan::potentialsPerBuffer
+                    )
+                    .def_readonly("buffer_set_count", &cpp::VibwaBatchPlan::bufferSetCount)
+                    .def_readonly("batches_in_flight", &cpp::VibwaBatchPlan::slotCount)
+                    .def_readonly("batch_count", &cpp::VibwaBatchPlan::batchCount)
+                    .def_readonly("device_local_bytes", &cpp::VibwaBatchPlan::deviceLocalBytes)
+                    .def_readonly("host_visible_bytes", &cpp::VibwaBatchPlan::hostVisibleBytes)
+                    .doc() = "Split of task into batches processed back-to-back.";
+
                 // Python API - Wrapper class for ComputeDeviceInterface class.
                 py::class_<ComputeDeviceInterface>(m, "ComputeDeviceInterface")
                     .def(
@@ -457,17 +785,73 @@ namespace epseon {
                     .def(
                         "submit_task",
                         &ComputeDeviceInterface::submit_task<float>,
+                        py::arg("task_config"),
+                        py::arg("stream_capacity") = 0,
                         "Submit task for execution. Will raise RuntimeError upon "
                         "receiving not fully configured TaskConfigurator."
                     )
                     .def(
                         "submit_task",
                         &ComputeDeviceInterface::submit_task<double>,
+                        py::arg("task_config"),
+                        py::arg("stream_capacity") = 0,
                         "Submit task for execution. Will raise RuntimeError upon "
                         "receiving not fully configured TaskConfigurator."
                     )
+                    .def(
+                        "plan_task",
+                        &ComputeDeviceInterface::plan_task<float>,
+                        "Get split of task into batches with current memory budgets of device."
+                    )
+                    .def(
+                        "plan_task",
+                        &ComputeDeviceInterface::plan_task<double>,
+                        "Get split of task into batches with current memory budgets of device."
+                    )
+                    .def(
+                        "autotune_hardware_config",
+                        &ComputeDeviceInterface::autotune_hardware_config,
+                        py::arg("precision"),
+                        py::arg("point_count"),
+                        py::arg("level_count"),
+                        py::arg("use_cache") = true,
+                        // Benchmark tasks run on worker threads while this one waits.
+                        py::call_guard<py::gil_scoped_release>(),
+                        "Find hardware configuration for tasks of given shape by benchmarking "
+                        "device, results are cached per device UUID."
+                    )
                     .doc() = "Interface to particular Vulkan device.";
 
+                // Python API - Wrapper class for MultiDeviceInterface class.
+                py::class_<MultiDeviceInterface>(m, "MultiDeviceInterface")
+                    .def(
+                        "get_task_configurator",
+                        &MultiDeviceInterface::get_task_configurator,
+                        "Get builder instance for configuring GPU compute task."
+                    )
+                    .def(
+                        "submit_task",
+                        &MultiDeviceInterface::submit_task<float>,
+                        py::arg("task_config"),
+                        py::arg("stream_capacity") = 0,
+                        "Submit task split between all devices for execution. Will raise "
+                        "RuntimeError upon receiving not fully configured TaskConfigurator."
+                    )
+                    .def(
+                        "submit_task",
+                        &MultiDeviceInterface::submit_task<double>,
+                        py::arg("task_config"),
+                        py::arg("stream_capacity") = 0,
+                        "Submit task split between all devices for execution. Will raise "
+                        "RuntimeError upon receiving not fully configured TaskConfigurator."
+                    )
+                    .def(
+                        "get_throughput",
+                        &MultiDeviceInterface::get_throughput,
+                        "Get measured throughput of each device in potential points per second."
+                    )
+                    .doc() = "Interface splitting tasks between multiple Vulkan devices.";
+
                 // Python API - Wrapper class for EpseonComputeContext class.
                 py::class_<EpseonComputeContext>(m, "EpseonComputeContext")
                     .def(
@@ -490,6 +874,13 @@ namespace epseon {
                         &EpseonComputeContext::get_device_interface,
                         "Get interface for running algorithms on Vulkan devices."
                     )
+                    .def(
+                        "get_multi_device_interface",
+                        &EpseonComputeContext::get_multi_device_interface,
+                        py::arg("device_ids") = std::vector<uint32_t>{},
+                        "Get interface splitting tasks between multiple Vulkan devices, all "
+                        "available devices if no IDs are given."
+                    )
                     .doc() = "Vulkan interface handle.";
             }
 
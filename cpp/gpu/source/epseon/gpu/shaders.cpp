@@ -0,0 +1,120 @@
+#include "epseon/gpu/shaders.hpp"
+#include "epseon/gpu/enums.hpp"
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+
+namespace epseon {
+    namespace gpu {
+        namespace shaders {
+
+            namespace {
+                // Shader binaries are generated at build time by epseon_gpu_compile_shader()
+                // defined in CMakeLists.txt, they contain comma separated SPIR-V words.
+                constexpr uint32_t vibwaFloat32[] = { // NOLINT: modernize-avoid-c-arrays
+#include "vibwa_float32.spv.inc"
+                };
+
+                constexpr uint32_t vibwaFloat64[] = { // NOLINT: modernize-avoid-c-arrays
+#include "vibwa_float64.spv.inc"
+                };
+
+                constexpr uint32_t vibwaFloat32Bda[] = { // NOLINT: modernize-avoid-c-arrays
+#include "vibwa_float32_bda.spv.inc"
+                };
+
+                constexpr uint32_t vibwaFloat64Bda[] = { // NOLINT: modernize-avoid-c-arrays
+#include "vibwa_float64_bda.spv.inc"
+                };
+
+                constexpr uint32_t vibwaFloat16[] = { // NOLINT: modernize-avoid-c-arrays
+#include "vibwa_float16.spv.inc"
+                };
+
+                constexpr uint32_t vibwaFloat16Bda[] = { // NOLINT: modernize-avoid-c-arrays
+#include "vibwa_float16_bda.spv.inc"
+                };
+
+                constexpr uint32_t vibwaFloat64Emulated[] = { // NOLINT: modernize-avoid-c-arrays
+#include "vibwa_float64_emulated.spv.inc"
+                };
+
+                constexpr uint32_t vibwaFloat64EmulatedBda[] = { // NOLINT
+#include "vibwa_float64_emulated_bda.spv.inc"
+                };
+
+                constexpr uint32_t vibwaFloat32Morse[] = { // NOLINT: modernize-avoid-c-arrays
+#include "vibwa_float32_morse.spv.inc"
+                };
+
+                constexpr uint32_t vibwaFloat64Morse[] = { // NOLINT: modernize-avoid-c-arrays
+#include "vibwa_float64_morse.spv.inc"
+                };
+
+                constexpr uint32_t vibwaFloat32MorseBda[] = { // NOLINT
+#include "vibwa_float32_morse_bda.spv.inc"
+                };
+
+                constexpr uint32_t vibwaFloat64MorseBda[] = { // NOLINT
+#include "vibwa_float64_morse_bda.spv.inc"
+                };
+
+                std::span<const uint32_t>
+                getVibwaMorseShaderCode(cpp::PrecisionType precision, bool bufferDeviceAddress) {
+                    switch (precision) {
+                        using enum cpp::PrecisionType;
+                        case Float32:
+                            if (bufferDeviceAddress) {
+                                return {vibwaFloat32MorseBda};
+                            }
+                            return {vibwaFloat32Morse};
+                        case Float64:
+                            if (bufferDeviceAddress) {
+                                return {vibwaFloat64MorseBda};
+                            }
+                            return {vibwaFloat64Morse};
+                        default:
+                            throw std::runtime_error(
+                                "Morse potentials can be generated on device only when they "
+                                "are stored in Float32 or Float64."
+                            );
+                    }
+                }
+            } // namespace
+
+            std::span<const uint32_t> getVibwaShaderCode(
+                cpp::PrecisionType precision, bool bufferDeviceAddress, bool morseGeneration
+            ) {
+                PrecisionTypeAssertValueCount(4);
+                if (morseGeneration) {
+                    return getVibwaMorseShaderCode(precision, bufferDeviceAddress);
+                }
+                switch (precision) {
+                    using enum cpp::PrecisionType;
+                    case Float32:
+                        if (bufferDeviceAddress) {
+                            return {vibwaFloat32Bda};
+                        }
+                        return {vibwaFloat32};
+                    case Float64:
+                        if (bufferDeviceAddress) {
+                            return {vibwaFloat64Bda};
+                        }
+                        return {vibwaFloat64};
+                    case Float16:
+                        if (bufferDeviceAddress) {
+                            return {vibwaFloat16Bda};
+                        }
+                        return {vibwaFloat16};
+                    case Float64Emulated:
+                        if (bufferDeviceAddress) {
+                            return {vibwaFloat64EmulatedBda};
+                        }
+                        return {vibwaFloat64Emulated};
+                    default:
+                        throw std::runtime_error("Unreachable");
+                }
+            }
+        } // namespace shaders
+    }     // namespace gpu
+} // namespace epseon
@@ -1,6 +1,10 @@
-#include "epseon/gpu/task_configurator/algorithm_config.hpp" // Include the appropriate header
+#include "epseon/gpu/algorithms/algorithm.hpp"
+#include "epseon/task_configurator/algorithm_config.hpp" // Include the appropriate header
 #include "gtest/gtest.h"
+#include <cstdint>
+#include <limits>
 #include <memory>
+#include <stdexcept>
 
 namespace epseon {
     namespace gpu {
@@ -121,8 +125,20 @@ namespace epseon {
                 EXPECT_EQ(cloned_cast->getMaxLevel(), 20u);
             }
 
-            TYPED_TEST(VibwaAlgorithmConfigTest, GetImplementationMethod) {
-                auto implementation = this->config_default.getImplementation();
+            TYPED_TEST(VibwaAlgorithmConfigTest, InvalidLevelRangeIsRejected) {
+                using Config = VibwaAlgorithmConfig<TypeParam>;
+                EXPECT_EQ(this->config_custom.getLevelCount(), 11u);
+                EXPECT_THROW(Config(1.0, 2.0, 0.1, 0.05, 20, 10), std::runtime_error);
+                // Level count would wrap around to 0.
+                EXPECT_THROW(
+                    Config(1.0, 2.0, 0.1, 0.05, 0, std::numeric_limits<uint32_t>::max()),
+                    std::runtime_error
+                );
+                EXPECT_EQ(Config(1.0, 2.0, 0.1, 0.05, 1, 1).getLevelCount(), 1u);
+            }
+
+            TYPED_TEST(VibwaAlgorithmConfigTest, CreateImplementation) {
+                auto implementation = Algorithm<TypeParam>::create(this->config_default);
                 EXPECT_NE(implementation, nullptr);
             }
         } // namespace cpp
@@ -1,171 +1,360 @@
-#include "epseon/gpu/task_configurator/potential_source.hpp"
+#include "epseon/potential_file.hpp"
+#include "epseon/task_configurator/potential_source.hpp"
 #include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <type_traits>
 #include <vector>
 
 namespace epseon {
-    namespace gpu {
-        namespace cpp {
-
-            template <typename FP>
-            class PotentialFileLoaderTest : public ::testing::Test {
-              protected:
-                std::vector<std::string> fileNames      = {"file1.txt", "file2.txt"};
-                PotentialFileLoader<FP>  loader_default = {};
-                PotentialFileLoader<FP>  loader_custom  = {fileNames};
-            };
-
-            using MyTypes = ::testing::Types<float, double>;
-            TYPED_TEST_SUITE(PotentialFileLoaderTest, MyTypes);
-
-            TYPED_TEST(PotentialFileLoaderTest, DefaultConstructor) {
-                EXPECT_TRUE(this->loader_default.get_potential_data().empty());
-            }
+    namespace cpp {
 
-            TYPED_TEST(PotentialFileLoaderTest, CustomConstructor) {
-                auto data = this->loader_custom.get_potential_data();
-                EXPECT_TRUE(data.empty()
-                ); // Assuming get_potential_data() returns empty for this example
-            }
+        template <typename FP>
+        class PotentialFileLoaderTest : public ::testing::Test {
+          protected:
+            std::filesystem::path        directory = {};
+            std::vector<std::vector<FP>> curves    = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+            std::vector<std::string>     fileNames = {};
+            PotentialFileLoader<FP>      loader_default = {};
+            PotentialFileLoader<FP>      loader_custom  = {};
 
-            TYPED_TEST(PotentialFileLoaderTest, CopyConstructor) {
-                PotentialFileLoader<TypeParam> loader_copy = this->loader_custom;
-                auto                           data        = loader_copy.get_potential_data();
-                EXPECT_TRUE(data.empty());
+            void SetUp() override {
+                const auto* test = ::testing::UnitTest::GetInstance()->current_test_info();
+                // Names of typed test suites contain slashes.
+                std::string name = std::string{"epseon_"} + test->test_suite_name() + "_" +
+                                   test->name();
+                std::ranges::replace(name, '/', '_');
+                this->directory = std::filesystem::temp_directory_path() / name;
+                std::filesystem::create_directories(this->directory);
+                // First file holds first two curves, second one the last curve.
+                const std::vector<std::vector<FP>> first{this->curves[0], this->curves[1]};
+                const std::vector<std::vector<FP>> second{this->curves[2]};
+                this->fileNames = {
+                    (this->directory / "file1.pot").string(),
+                    (this->directory / "file2.pot").string()
+                };
+                writePotentialFile<FP>(this->fileNames[0], makeBuffer(first).getView(), 0, 1);
+                writePotentialFile<FP>(this->fileNames[1], makeBuffer(second).getView(), 0, 1);
+                this->loader_custom = PotentialFileLoader<FP>{this->fileNames};
             }
 
-            TYPED_TEST(PotentialFileLoaderTest, MoveConstructor) {
-                PotentialFileLoader<TypeParam> loader_moved(std::move(this->loader_custom));
-                auto                           data = loader_moved.get_potential_data();
-                EXPECT_TRUE(data.empty());
+            void TearDown() override {
+                std::filesystem::remove_all(this->directory);
             }
 
-            TYPED_TEST(PotentialFileLoaderTest, SharedCloneMethod) {
-                auto cloned = this->loader_custom.shared_clone();
-                EXPECT_NE(cloned, nullptr);
-                auto potential_data = cloned->get_potential_data();
-                EXPECT_TRUE(potential_data.empty());
+            // Curves of equal point count packed densely.
+            static PotentialBuffer<FP> makeBuffer(const std::vector<std::vector<FP>>& rows) {
+                auto values = std::make_shared<std::vector<FP>>();
+                for (const auto& row : rows) {
+                    values->insert(values->end(), row.begin(), row.end());
+                }
+                return {
+                    std::shared_ptr<const FP>(values, values->data()),
+                    rows.size(),
+                    rows.empty() ? 0 : rows.front().size()
+                };
             }
+        };
 
-            TYPED_TEST(PotentialFileLoaderTest, UniqueCloneMethod) {
-                auto cloned = this->loader_custom.unique_clone();
-                EXPECT_NE(cloned, nullptr);
-                auto potential_data = cloned->get_potential_data();
-                EXPECT_TRUE(potential_data.empty());
-            }
-        } // namespace cpp
-    }     // namespace gpu
+        using MyTypes = ::testing::Types<float, double>;
+        TYPED_TEST_SUITE(PotentialFileLoaderTest, MyTypes);
+
+        TYPED_TEST(PotentialFileLoaderTest, DefaultConstructor) {
+            EXPECT_TRUE(this->loader_default.get_potential_data().empty());
+        }
+
+        TYPED_TEST(PotentialFileLoaderTest, CustomConstructor) {
+            auto data = this->loader_custom.get_potential_data();
+            EXPECT_EQ(data, this->curves);
+        }
+
+        TYPED_TEST(PotentialFileLoaderTest, CopyConstructor) {
+            PotentialFileLoader<TypeParam> loader_copy = this->loader_custom;
+            auto                           data        = loader_copy.get_potential_data();
+            EXPECT_EQ(data, this->curves);
+        }
+
+        TYPED_TEST(PotentialFileLoaderTest, MoveConstructor) {
+            PotentialFileLoader<TypeParam> loader_moved(std::move(this->loader_custom));
+            auto                           data = loader_moved.get_potential_data();
+            EXPECT_EQ(data, this->curves);
+        }
+
+        TYPED_TEST(PotentialFileLoaderTest, SharedCloneMethod) {
+            auto cloned = this->loader_custom.shared_clone();
+            EXPECT_NE(cloned, nullptr);
+            auto potential_data = cloned->get_potential_data();
+            EXPECT_EQ(potential_data, this->curves);
+        }
+
+        TYPED_TEST(PotentialFileLoaderTest, UniqueCloneMethod) {
+            auto cloned = this->loader_custom.unique_clone();
+            EXPECT_NE(cloned, nullptr);
+            auto potential_data = cloned->get_potential_data();
+            EXPECT_EQ(potential_data, this->curves);
+        }
+
+        TYPED_TEST(PotentialFileLoaderTest, PotentialCountIsReadFromHeaders) {
+            EXPECT_EQ(this->loader_default.get_potential_count(), 0);
+            EXPECT_EQ(this->loader_custom.get_potential_count(), this->curves.size());
+        }
+
+        TYPED_TEST(PotentialFileLoaderTest, MissingFileIsRejected) {
+            const std::vector<std::string>  fileNames{(this->directory / "none").string()};
+            PotentialFileLoader<TypeParam> loader{fileNames};
+            EXPECT_THROW(loader.get_potential_data(), std::runtime_error);
+        }
+    } // namespace cpp
 } // namespace epseon
 
 namespace epseon {
-    namespace gpu {
-        namespace cpp {
-
-            template <typename FP>
-            class MorsePotentialConfigTest : public ::testing::Test {
-              protected:
-                MorsePotentialConfig<FP> config_default = {};
-                MorsePotentialConfig<FP> config_custom  = {1.0, 2.0, 3.0, 0.1, 5.0, 100};
-            };
-
-            using MyTypes = ::testing::Types<float, double>;
-            TYPED_TEST_SUITE(MorsePotentialConfigTest, MyTypes);
-
-            TYPED_TEST(MorsePotentialConfigTest, DefaultConstructor) {
-                EXPECT_EQ(this->config_default.getDissociationEnergy(), TypeParam{});
-                EXPECT_EQ(this->config_default.getEquilibriumBondDistance(), TypeParam{});
-                EXPECT_EQ(this->config_default.getWellWidth(), TypeParam{});
-                EXPECT_EQ(this->config_default.getMinR(), TypeParam{});
-                EXPECT_EQ(this->config_default.getMaxR(), TypeParam{});
-                EXPECT_EQ(this->config_default.getPointCount(), 0u);
-            }
+    namespace cpp {
 
-            TYPED_TEST(MorsePotentialConfigTest, CustomConstructor) {
-                EXPECT_EQ(this->config_custom.getDissociationEnergy(), TypeParam{1.0});
-                EXPECT_EQ(this->config_custom.getEquilibriumBondDistance(), TypeParam{2.0});
-                EXPECT_EQ(this->config_custom.getWellWidth(), TypeParam{3.0});
-                EXPECT_EQ(this->config_custom.getMinR(), TypeParam{0.1});
-                EXPECT_EQ(this->config_custom.getMaxR(), TypeParam{5.0});
-                EXPECT_EQ(this->config_custom.getPointCount(), 100u);
-            }
+        template <typename FP>
+        class MorsePotentialConfigTest : public ::testing::Test {
+          protected:
+            MorsePotentialConfig<FP> config_default = {};
+            MorsePotentialConfig<FP> config_custom  = {1.0, 2.0, 3.0, 0.1, 5.0, 100};
+        };
 
-            TYPED_TEST(MorsePotentialConfigTest, CopyConstructor) {
-                MorsePotentialConfig<TypeParam> copied_config(this->config_custom);
-                EXPECT_EQ(
-                    copied_config.getDissociationEnergy(),
-                    this->config_custom.getDissociationEnergy()
-                );
-                EXPECT_EQ(
-                    copied_config.getEquilibriumBondDistance(),
-                    this->config_custom.getEquilibriumBondDistance()
-                );
-                EXPECT_EQ(copied_config.getWellWidth(), this->config_custom.getWellWidth());
-                EXPECT_EQ(copied_config.getMinR(), this->config_custom.getMinR());
-                EXPECT_EQ(copied_config.getMaxR(), this->config_custom.getMaxR());
-                EXPECT_EQ(copied_config.getPointCount(), this->config_custom.getPointCount());
-            }
+        using MyTypes = ::testing::Types<float, double>;
+        TYPED_TEST_SUITE(MorsePotentialConfigTest, MyTypes);
 
-            TYPED_TEST(MorsePotentialConfigTest, CopyAssignmentOperator) {
-                MorsePotentialConfig<TypeParam> copied_config;
-                copied_config = this->config_custom;
-                EXPECT_EQ(
-                    copied_config.getDissociationEnergy(),
-                    this->config_custom.getDissociationEnergy()
-                );
-                EXPECT_EQ(
-                    copied_config.getEquilibriumBondDistance(),
-                    this->config_custom.getEquilibriumBondDistance()
-                );
-                EXPECT_EQ(copied_config.getWellWidth(), this->config_custom.getWellWidth());
-                EXPECT_EQ(copied_config.getMinR(), this->config_custom.getMinR());
-                EXPECT_EQ(copied_config.getMaxR(), this->config_custom.getMaxR());
-                EXPECT_EQ(copied_config.getPointCount(), this->config_custom.getPointCount());
+        TYPED_TEST(MorsePotentialConfigTest, DefaultConstructor) {
+            EXPECT_EQ(this->config_default.getDissociationEnergy(), TypeParam{});
+            EXPECT_EQ(this->config_default.getEquilibriumBondDistance(), TypeParam{});
+            EXPECT_EQ(this->config_default.getWellWidth(), TypeParam{});
+            EXPECT_EQ(this->config_default.getMinR(), TypeParam{});
+            EXPECT_EQ(this->config_default.getMaxR(), TypeParam{});
+            EXPECT_EQ(this->config_default.getPointCount(), 0u);
+        }
+
+        TYPED_TEST(MorsePotentialConfigTest, CustomConstructor) {
+            EXPECT_EQ(this->config_custom.getDissociationEnergy(), TypeParam{1.0});
+            EXPECT_EQ(this->config_custom.getEquilibriumBondDistance(), TypeParam{2.0});
+            EXPECT_EQ(this->config_custom.getWellWidth(), TypeParam{3.0});
+            EXPECT_EQ(this->config_custom.getMinR(), TypeParam{0.1});
+            EXPECT_EQ(this->config_custom.getMaxR(), TypeParam{5.0});
+            EXPECT_EQ(this->config_custom.getPointCount(), 100u);
+        }
+
+        TYPED_TEST(MorsePotentialConfigTest, CopyConstructor) {
+            MorsePotentialConfig<TypeParam> copied_config(this->config_custom);
+            EXPECT_EQ(
+                copied_config.getDissociationEnergy(),
+                this->config_custom.getDissociationEnergy()
+            );
+            EXPECT_EQ(
+                copied_config.getEquilibriumBondDistance(),
+                this->config_custom.getEquilibriumBondDistance()
+            );
+            EXPECT_EQ(copied_config.getWellWidth(), this->config_custom.getWellWidth());
+            EXPECT_EQ(copied_config.getMinR(), this->config_custom.getMinR());
+            EXPECT_EQ(copied_config.getMaxR(), this->config_custom.getMaxR());
+            EXPECT_EQ(copied_config.getPointCount(), this->config_custom.getPointCount());
+        }
+
+        TYPED_TEST(MorsePotentialConfigTest, CopyAssignmentOperator) {
+            MorsePotentialConfig<TypeParam> copied_config;
+            copied_config = this->config_custom;
+            EXPECT_EQ(
+                copied_config.getDissociationEnergy(),
+                this->config_custom.getDissociationEnergy()
+            );
+            EXPECT_EQ(
+                copied_config.getEquilibriumBondDistance(),
+                this->config_custom.getEquilibriumBondDistance()
+            );
+            EXPECT_EQ(copied_config.getWellWidth(), this->config_custom.getWellWidth());
+            EXPECT_EQ(copied_config.getMinR(), this->config_custom.getMinR());
+            EXPECT_EQ(copied_config.getMaxR(), this->config_custom.getMaxR());
+            EXPECT_EQ(copied_config.getPointCount(), this->config_custom.getPointCount());
+        }
+
+        TYPED_TEST(MorsePotentialConfigTest, MoveConstructor) {
+            // Create a copy of the custom configuration to compare after moving
+            MorsePotentialConfig<TypeParam> config_before_move = this->config_custom;
+
+            // Move constructor
+            MorsePotentialConfig<TypeParam> moved_config(std::move(this->config_custom));
+
+            // Check if the moved-to object has the correct values
+            EXPECT_EQ(
+                moved_config.getDissociationEnergy(), config_before_move.getDissociationEnergy()
+            );
+            EXPECT_EQ(
+                moved_config.getEquilibriumBondDistance(),
+                config_before_move.getEquilibriumBondDistance()
+            );
+            EXPECT_EQ(moved_config.getWellWidth(), config_before_move.getWellWidth());
+            EXPECT_EQ(moved_config.getMinR(), config_before_move.getMinR());
+            EXPECT_EQ(moved_config.getMaxR(), config_before_move.getMaxR());
+            EXPECT_EQ(moved_config.getPointCount(), config_before_move.getPointCount());
+        }
+
+        TYPED_TEST(MorsePotentialConfigTest, MoveAssignmentOperator) {
+            // Create a copy of the custom configuration to compare after moving
+            MorsePotentialConfig<TypeParam> config_before_move = this->config_custom;
+
+            // Move assignment operator
+            MorsePotentialConfig<TypeParam> moved_config;
+            moved_config = std::move(this->config_custom);
+
+            // Check if the moved-to object has the correct values
+            EXPECT_EQ(
+                moved_config.getDissociationEnergy(), config_before_move.getDissociationEnergy()
+            );
+            EXPECT_EQ(
+                moved_config.getEquilibriumBondDistance(),
+                config_before_move.getEquilibriumBondDistance()
+            );
+            EXPECT_EQ(moved_config.getWellWidth(), config_before_move.getWellWidth());
+            EXPECT_EQ(moved_config.getMinR(), config_before_move.getMinR());
+            EXPECT_EQ(moved_config.getMaxR(), config_before_move.getMaxR());
+            EXPECT_EQ(moved_config.getPointCount(), config_before_move.getPointCount());
+        }
+    } // namespace cpp
+} // namespace epseon
+
+namespace epseon {
+    namespace cpp {
+
+        template <typename FP>
+        class MorsePotentialGeneratorTest : public ::testing::Test {
+          protected:
+            // Point count which is not multiple of lane count nor alignment.
+            static constexpr uint32_t pointCount = 1001;
+
+            static MorsePotentialGenerator<FP> makeGenerator(size_t potentialCount) {
+                std::vector<MorsePotentialConfig<FP>> configurations{};
+                for (size_t i = 0; i < potentialCount; i++) {
+                    configurations.emplace_back(
+                        5000.0 + 10.0 * i, 2.0 + 0.001 * i, 1.0, 1.0, 10.0, pointCount
+                    );
+                }
+                return MorsePotentialGenerator<FP>{std::move(configurations)};
             }
+        };
 
-            TYPED_TEST(MorsePotentialConfigTest, MoveConstructor) {
-                // Create a copy of the custom configuration to compare after moving
-                MorsePotentialConfig<TypeParam> config_before_move = this->config_custom;
+        using MyTypes = ::testing::Types<float, double>;
+        TYPED_TEST_SUITE(MorsePotentialGeneratorTest, MyTypes);
 
-                // Move constructor
-                MorsePotentialConfig<TypeParam> moved_config(std::move(this->config_custom));
+        TYPED_TEST(MorsePotentialGeneratorTest, BufferMatchesReferenceCurves) {
+            const auto generator = this->makeGenerator(20);
+            const auto buffer    = generator.generatePotentialBuffer();
+            const auto view      = buffer->getView();
+            ASSERT_EQ(buffer->get_potential_count(), 20u);
+            ASSERT_EQ(buffer->get_point_count(), this->pointCount);
 
-                // Check if the moved-to object has the correct values
-                EXPECT_EQ(
-                    moved_config.getDissociationEnergy(), config_before_move.getDissociationEnergy()
-                );
+            for (size_t i = 0; i < 20; i++) {
+                const auto&     config = generator.configurations[i];
+                const auto      curve  = view[i];
+                const TypeParam step   = (config.getMaxR() - config.getMinR()) /
+                                       static_cast<TypeParam>(this->pointCount - 1);
                 EXPECT_EQ(
-                    moved_config.getEquilibriumBondDistance(),
-                    config_before_move.getEquilibriumBondDistance()
+                    reinterpret_cast<uintptr_t>(curve.data()) % potentialMemoryAlignment, 0u
                 );
-                EXPECT_EQ(moved_config.getWellWidth(), config_before_move.getWellWidth());
-                EXPECT_EQ(moved_config.getMinR(), config_before_move.getMinR());
-                EXPECT_EQ(moved_config.getMaxR(), config_before_move.getMaxR());
-                EXPECT_EQ(moved_config.getPointCount(), config_before_move.getPointCount());
+                for (size_t j = 0; j < this->pointCount; j++) {
+                    const double r = config.getMinR() + step * static_cast<TypeParam>(j);
+                    const double exponential = std::exp(
+                        -config.getWellWidth() * (r - config.getEquilibriumBondDistance())
+                    );
+                    const double expected =
+                        config.getDissociationEnergy() * (1 - exponential) * (1 - exponential);
+                    // Near minimum 1 - exp() cancels, so error is relative to De.
+                    ASSERT_NEAR(
+                        curve[j],
+                        expected,
+                        config.getDissociationEnergy() * 16 *
+                            std::numeric_limits<TypeParam>::epsilon()
+                    );
+                }
             }
+        }
 
-            TYPED_TEST(MorsePotentialConfigTest, MoveAssignmentOperator) {
-                // Create a copy of the custom configuration to compare after moving
-                MorsePotentialConfig<TypeParam> config_before_move = this->config_custom;
+        TYPED_TEST(MorsePotentialGeneratorTest, CurvesDontDependOnThreadCount) {
+            auto generator = this->makeGenerator(50);
 
-                // Move assignment operator
-                MorsePotentialConfig<TypeParam> moved_config;
-                moved_config = std::move(this->config_custom);
+            const auto singleThreaded = generator.generatePotentialBuffer(1);
+            const auto multiThreaded  = generator.generatePotentialBuffer(7);
+            EXPECT_TRUE(singleThreaded->equals(*multiThreaded));
+            EXPECT_EQ(singleThreaded->get_potential_data(), generator.get_potential_data());
+            EXPECT_EQ(
+                singleThreaded->get_potential_data()[3],
+                generator.configurations[3].getPotentialCurve()
+            );
+        }
 
-                // Check if the moved-to object has the correct values
-                EXPECT_EQ(
-                    moved_config.getDissociationEnergy(), config_before_move.getDissociationEnergy()
-                );
-                EXPECT_EQ(
-                    moved_config.getEquilibriumBondDistance(),
-                    config_before_move.getEquilibriumBondDistance()
-                );
-                EXPECT_EQ(moved_config.getWellWidth(), config_before_move.getWellWidth());
-                EXPECT_EQ(moved_config.getMinR(), config_before_move.getMinR());
-                EXPECT_EQ(moved_config.getMaxR(), config_before_move.getMaxR());
-                EXPECT_EQ(moved_config.getPointCount(), config_before_move.getPointCount());
+        TYPED_TEST(MorsePotentialGeneratorTest, MixedPointCountsAreRejected) {
+            auto generator = this->makeGenerator(2);
+            generator.configurations.emplace_back(5000.0, 2.0, 1.0, 1.0, 10.0, 500);
+
+            EXPECT_FALSE(generator.hasUniformPointCount());
+            EXPECT_THROW(generator.generatePotentialBuffer(), std::runtime_error);
+            // Curves of one source are stored in one buffer, so they can't differ.
+            EXPECT_THROW(generator.get_potential_data(), std::runtime_error);
+        }
+    } // namespace cpp
+} // namespace epseon
+
+namespace epseon {
+    namespace cpp {
+
+        template <typename FP>
+        class PotentialBufferTest : public ::testing::Test {
+          protected:
+            static std::shared_ptr<const FP> makeData(std::vector<FP> values) {
+                auto owner = std::make_shared<const std::vector<FP>>(std::move(values));
+                return {owner, owner->data()};
             }
-        } // namespace cpp
-    }     // namespace gpu
+
+            // Three curves of two points, padded to stride of three values.
+            std::shared_ptr<const FP> data = makeData({1, 2, 0, 3, 4, 0, 5, 6, 0});
+        };
+
+        using MyTypes = ::testing::Types<float, double>;
+        TYPED_TEST_SUITE(PotentialBufferTest, MyTypes);
+
+        TYPED_TEST(PotentialBufferTest, ViewSkipsPadding) {
+            PotentialBuffer<TypeParam> buffer{this->data, 3, 2, 3};
+            const auto                 view = buffer.getView();
+            ASSERT_EQ(view.size(), 3u);
+            EXPECT_EQ(view[1].size(), 2u);
+            EXPECT_EQ(view[1][0], TypeParam{3});
+            EXPECT_EQ(view[2][1], TypeParam{6});
+            EXPECT_EQ(buffer.get_potential_count(), 3u);
+            EXPECT_EQ(
+                buffer.get_potential_data(),
+                (std::vector<std::vector<TypeParam>>{{1, 2}, {3, 4}, {5, 6}})
+            );
+        }
+
+        TYPED_TEST(PotentialBufferTest, SliceSharesMemory) {
+            PotentialBuffer<TypeParam> buffer{this->data, 3, 2, 3};
+            const auto                 slice = buffer.slice(1, 2);
+            EXPECT_EQ(slice->get_potential_count(), 2u);
+            EXPECT_EQ(slice->getView()[0].data(), this->data.get() + 3);
+            EXPECT_THROW(buffer.slice(2, 2), std::runtime_error);
+        }
+
+        TYPED_TEST(PotentialBufferTest, EqualityComparesValues) {
+            PotentialBuffer<TypeParam> buffer{this->data, 3, 2, 3};
+            PotentialBuffer<TypeParam> other{this->makeData({1, 2, 3, 4, 5, 6}), 3, 2};
+            EXPECT_TRUE(buffer.equals(other));
+            EXPECT_FALSE(buffer.equals(*buffer.slice(0, 2)));
+            EXPECT_TRUE(buffer.equals(*buffer.shared_clone()));
+        }
+
+        TYPED_TEST(PotentialBufferTest, StrideShorterThanCurveIsRejected) {
+            EXPECT_THROW(
+                (PotentialBuffer<TypeParam>{this->data, 3, 2, 1}), std::runtime_error
+            );
+        }
+    } // namespace cpp
 } // namespace epseon
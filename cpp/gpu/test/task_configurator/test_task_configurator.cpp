@@ -1,8 +1,11 @@
-#include "epseon/gpu/task_configurator/algorithm_config.hpp"
-#include "epseon/gpu/task_configurator/hardware_config.hpp"
-#include "epseon/gpu/task_configurator/potential_source.hpp"
+#include "epseon/gpu/algorithms/vibwa.hpp"
+#include "epseon/task_configurator/algorithm_config.hpp"
+#include "epseon/task_configurator/hardware_config.hpp"
+#include "epseon/task_configurator/potential_source.hpp"
+#include "epseon/task_configurator/task_configurator.hpp"
 #include "gtest/gtest.h"
 #include <memory>
+#include <stdexcept>
 #include <type_traits>
 
 namespace epseon {
@@ -109,6 +112,44 @@ namespace epseon {
                     .setAlgorithmConfig(ac);
                 EXPECT_TRUE(this->configurator_default.isConfigured());
             }
+
+            TYPED_TEST(TaskConfiguratorTest, StoragePrecision) {
+                EXPECT_EQ(
+                    this->configurator_default.getStoragePrecision(),
+                    getPrecisionType<TypeParam>()
+                );
+                if constexpr (std::is_same_v<TypeParam, float>) {
+                    this->configurator_custom.setStoragePrecision(PrecisionType::Float16);
+                    TaskConfigurator<TypeParam> copied_config(this->configurator_custom);
+                    EXPECT_EQ(copied_config.getStoragePrecision(), PrecisionType::Float16);
+
+                    copied_config.setHardwareConfig(
+                        std::make_shared<HardwareConfig<TypeParam>>(100, 1, 0)
+                    );
+                    EXPECT_EQ(
+                        VibwaAlgorithm<TypeParam>::getShaderBufferRequirements(copied_config)
+                            .front()
+                            .getStorageElementSizeBytes(),
+                        2
+                    );
+                    EXPECT_THROW(
+                        this->configurator_custom.setStoragePrecision(
+                            PrecisionType::Float64Emulated
+                        ),
+                        std::runtime_error
+                    );
+                } else {
+                    EXPECT_THROW(
+                        this->configurator_custom.setStoragePrecision(PrecisionType::Float16),
+                        std::runtime_error
+                    );
+                    this->configurator_custom.setStoragePrecision(PrecisionType::Float64Emulated);
+                    EXPECT_EQ(
+                        this->configurator_custom.getStoragePrecision(),
+                        PrecisionType::Float64Emulated
+                    );
+                }
+            }
         } // namespace cpp
     }     // namespace gpu
 } // namespace epseon
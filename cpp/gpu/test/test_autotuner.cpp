@@ -0,0 +1,136 @@
+#include "epseon/gpu/autotuner.hpp"
+#include "epseon/gpu/compute_context.hpp"
+#include "epseon/gpu/device_interface.hpp"
+#include "epseon/gpu/enums.hpp"
+#include "spdlog/spdlog.h"
+#include <array>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+namespace epseon::gpu::cpp {
+    class AutotunerTest : public ::testing::Test {
+      protected:
+        std::filesystem::path directory =
+            std::filesystem::temp_directory_path() / "epseon_gpu_autotuner_test";
+
+        void SetUp() override {
+            std::filesystem::remove_all(directory);
+        }
+
+        void TearDown() override {
+            std::filesystem::remove_all(directory);
+        }
+
+        std::shared_ptr<ComputeDeviceInterface> getFirstDevice() {
+            auto ctx = ComputeContext::create(VK_MAKE_API_VERSION(0, 0, 1, 0), directory);
+
+            auto device_info_vector = ctx->getPhysicalDevicesInfo();
+            return ctx->getDeviceInterface(device_info_vector[0].deviceProperties.deviceID);
+        }
+    };
+
+    TEST_F(AutotunerTest, WorkgroupSizeCandidatesRespectLimits) {
+        vk::PhysicalDeviceLimits limits{};
+        limits.maxComputeWorkGroupSize[0]     = 1024;
+        limits.maxComputeWorkGroupInvocations = 256;
+
+        // Workgroups wider than level count would only idle.
+        ASSERT_EQ(
+            Autotuner<float>::getWorkgroupSizeCandidates(limits, 20),
+            (std::vector<uint32_t>{8, 16, 32})
+        );
+        ASSERT_EQ(
+            Autotuner<float>::getWorkgroupSizeCandidates(limits, 1000),
+            (std::vector<uint32_t>{8, 16, 32, 64, 128, 256})
+        );
+        ASSERT_EQ(
+            Autotuner<float>::getWorkgroupSizeCandidates(limits, 1), (std::vector<uint32_t>{8})
+        );
+
+        limits.maxComputeWorkGroupInvocations = 4;
+        ASSERT_EQ(
+            Autotuner<float>::getWorkgroupSizeCandidates(limits, 20), (std::vector<uint32_t>{4})
+        );
+    }
+
+    TEST_F(AutotunerTest, GroupSizeCandidatesEndWithMaximum) {
+        ASSERT_EQ(
+            Autotuner<double>::getGroupSizeCandidates(5000),
+            (std::vector<uint32_t>{64, 256, 1024, 4096, 5000})
+        );
+        ASSERT_EQ(Autotuner<double>::getGroupSizeCandidates(10), (std::vector<uint32_t>{10}));
+    }
+
+    TEST_F(AutotunerTest, CacheIsPersistedPerDeviceUUID) {
+        const std::array<uint8_t, VK_UUID_SIZE> uuid{0xAB, 0x01};
+
+        const AutotuneKey key{
+            .precision = PrecisionType::Float64, .pointCount = 1001, .levelCount = 8
+        };
+        const AutotuneKey otherKey{
+            .precision = PrecisionType::Float32, .pointCount = 1001, .levelCount = 8
+        };
+        const AutotuneResult result{.groupSize = 4096, .workgroupSize = 32};
+        const auto           logger = spdlog::default_logger();
+        {
+            AutotuneCache cache{logger, directory, uuid};
+            ASSERT_FALSE(cache.get(key).has_value());
+            cache.store(key, result);
+            ASSERT_EQ(cache.getPath().filename().string(), AutotuneCache::getFileName(uuid));
+        }
+        AutotuneCache cache{logger, directory, uuid};
+        ASSERT_EQ(cache.get(key), result);
+        ASSERT_FALSE(cache.get(otherKey).has_value());
+
+        std::array<uint8_t, VK_UUID_SIZE> otherUuid = uuid;
+        otherUuid[0]                                = 0xCD;
+        AutotuneCache otherCache{logger, directory, otherUuid};
+        ASSERT_FALSE(otherCache.get(key).has_value());
+    }
+
+    TEST_F(AutotunerTest, CacheKeepsResultsStoredByOtherInstances) {
+        const std::array<uint8_t, VK_UUID_SIZE> uuid{0xAB, 0x02};
+
+        const AutotuneKey key{
+            .precision = PrecisionType::Float32, .pointCount = 501, .levelCount = 16
+        };
+        const AutotuneKey otherKey{
+            .precision = PrecisionType::Float32, .pointCount = 2001, .levelCount = 16
+        };
+        const AutotuneResult result{.groupSize = 1024, .workgroupSize = 16};
+        const AutotuneResult otherResult{.groupSize = 256, .workgroupSize = 8};
+        const auto           logger = spdlog::default_logger();
+
+        // Both instances read the file before either of them stored anything.
+        AutotuneCache cache{logger, directory, uuid};
+        AutotuneCache otherCache{logger, directory, uuid};
+        cache.store(key, result);
+        otherCache.store(otherKey, otherResult);
+
+        AutotuneCache reloaded{logger, directory, uuid};
+        ASSERT_EQ(reloaded.get(key), result);
+        ASSERT_EQ(reloaded.get(otherKey), otherResult);
+    }
+
+    TEST_F(AutotunerTest, TunedConfigIsCachedAndRuns) {
+        auto device = getFirstDevice();
+
+        const auto config = device->autotuneHardwareConfig<float>(501, 4);
+        ASSERT_EQ(config->getPotentialBufferSize(), 501);
+        ASSERT_GT(config->getGroupSize(), 0);
+        ASSERT_GT(config->getWorkgroupSize(), 0);
+        ASSERT_LE(
+            config->getWorkgroupSize(),
+            VibwaAlgorithm<float>::getMaxWorkgroupSize(
+                device->getPhysicalDevice().getProperties().limits
+            )
+        );
+        ASSERT_TRUE(std::filesystem::exists(device->getAutotuneCache().getPath()));
+
+        // Other interface to the same device finds result in cache.
+        const auto cached = getFirstDevice()->autotuneHardwareConfig<float>(501, 4);
+        ASSERT_EQ(*cached, *config);
+    }
+} // namespace epseon::gpu::cpp
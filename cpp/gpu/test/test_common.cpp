@@ -0,0 +1,106 @@
+#include "epseon/gpu/common.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace epseon::gpu::common {
+    class CommonTest : public ::testing::Test {};
+
+    TEST_F(CommonTest, Float16BitsOfExactValues) {
+        EXPECT_EQ(float_to_float16_bits(0.0F), 0x0000);
+        EXPECT_EQ(float_to_float16_bits(-0.0F), 0x8000);
+        EXPECT_EQ(float_to_float16_bits(1.0F), 0x3C00);
+        EXPECT_EQ(float_to_float16_bits(-2.0F), 0xC000);
+        EXPECT_EQ(float_to_float16_bits(65504.0F), 0x7BFF);
+        // Smallest subnormal.
+        EXPECT_EQ(float_to_float16_bits(std::ldexp(1.0F, -24)), 0x0001);
+    }
+
+    TEST_F(CommonTest, Float16RoundsToNearestEven) {
+        // 1 + 2^-11 lies halfway between 1 and next half, ties go to even mantissa.
+        EXPECT_EQ(float_to_float16_bits(1.0F + std::ldexp(1.0F, -11)), 0x3C00);
+        EXPECT_EQ(float_to_float16_bits(1.0F + 3 * std::ldexp(1.0F, -11)), 0x3C02);
+        EXPECT_EQ(float_to_float16_bits(std::ldexp(1.0F, -25)), 0x0000);
+        EXPECT_EQ(float_to_float16_bits(std::ldexp(3.0F, -26)), 0x0001);
+    }
+
+    TEST_F(CommonTest, Float16OutOfRangeIsInfinity) {
+        EXPECT_EQ(float_to_float16_bits(65520.0F), 0x7C00);
+        EXPECT_EQ(float_to_float16_bits(-1e10F), 0xFC00);
+        EXPECT_EQ(float_to_float16_bits(std::numeric_limits<float>::infinity()), 0x7C00);
+        EXPECT_TRUE(std::isnan(
+            float16_bits_to_float(float_to_float16_bits(std::numeric_limits<float>::quiet_NaN()))
+        ));
+    }
+
+    TEST_F(CommonTest, Float16RoundTrip) {
+        for (uint32_t bits = 0; bits < 0x10000; bits++) {
+            const float value = float16_bits_to_float(static_cast<uint16_t>(bits));
+            if (std::isnan(value)) {
+                continue;
+            }
+            EXPECT_EQ(float_to_float16_bits(value), bits) << "bits " << bits;
+        }
+    }
+
+    TEST_F(CommonTest, FloatPairHoldsDoubleToFortyEightBits) {
+        for (const double value : {1.0 / 3.0, -2.718281828459045, 5500.123456789012, 1e-20}) {
+            const auto pair = double_to_float_pair(value);
+            EXPECT_EQ(pair[0], static_cast<float>(value));
+            EXPECT_LE(std::abs(pair[1]), std::abs(pair[0]) * std::ldexp(1.0F, -24));
+            EXPECT_NEAR(float_pair_to_double(pair), value, std::abs(value) * std::ldexp(1.0, -47));
+        }
+    }
+
+    TEST_F(CommonTest, FloatPairOfNonFiniteValue) {
+        const auto infinity = double_to_float_pair(std::numeric_limits<double>::infinity());
+        EXPECT_TRUE(std::isinf(float_pair_to_double(infinity)));
+        EXPECT_EQ(infinity[1], 0.0F);
+        // Out of float range.
+        EXPECT_TRUE(std::isinf(double_to_float_pair(1e300)[0]));
+        EXPECT_TRUE(std::isnan(
+            float_pair_to_double(double_to_float_pair(std::numeric_limits<double>::quiet_NaN()))
+        ));
+    }
+
+    TEST_F(CommonTest, ConcurrentAtomicWritesLeaveOneCompleteFile) {
+        const auto directory =
+            std::filesystem::temp_directory_path() / "epseon_gpu_common_test" / "nested";
+        const auto path = directory / "data.bin";
+        std::filesystem::remove_all(directory.parent_path());
+
+        constexpr size_t writerCount = 8;
+        constexpr size_t size        = 1 << 20;
+        {
+            std::vector<std::jthread> writers{};
+            for (size_t i = 0; i < writerCount; i++) {
+                writers.emplace_back([&path, i]() {
+                    const std::vector<std::byte> data(size, static_cast<std::byte>(i));
+                    for (int repeat = 0; repeat < 4; repeat++) {
+                        EXPECT_FALSE(write_file_atomically(path, data));
+                    }
+                });
+            }
+        }
+        std::ifstream           file{path, std::ios::binary};
+        const std::vector<char> contents(
+            (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>()
+        );
+        ASSERT_EQ(contents.size(), size);
+        for (const char value : contents) {
+            ASSERT_EQ(value, contents.front());
+        }
+        // Temporary files are gone.
+        EXPECT_EQ(std::distance(std::filesystem::directory_iterator{directory}, {}), 1);
+
+        std::filesystem::remove_all(directory.parent_path());
+    }
+} // namespace epseon::gpu::common
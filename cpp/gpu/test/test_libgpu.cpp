@@ -1,9 +1,15 @@
+#include "epseon/gpu/device_context.hpp"
 #include "epseon/gpu/enums.hpp"
 #include "epseon/gpu/libgpu.hpp"
-#include "epseon/gpu/task_configurator/algorithm_config.hpp"
-#include "epseon/gpu/task_configurator/potential_source.hpp"
+#include "epseon/task_configurator/algorithm_config.hpp"
+#include "epseon/task_configurator/potential_source.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <gtest/gtest.h>
 #include <memory>
+#include <string_view>
+#include <thread>
 #include <vector>
 
 namespace epseon {
@@ -105,6 +111,585 @@ namespace epseon {
                 handle->wait();
                 ASSERT_TRUE(handle->isDone());
             }
+
+            TEST_F(LibGPUTest, MorseLevelsMatchAnalyticSolution) {
+                auto ctx = ComputeContext::create();
+
+                auto device_info_vector = ctx->getPhysicalDevicesInfo();
+                auto first_device_info  = device_info_vector[0];
+                auto first_device =
+                    ctx->getDeviceInterface(first_device_info.deviceProperties.deviceID);
+
+                const double   dissociation_energy = 5500.0;
+                const double   well_width          = 1.0;
+                const double   mass                = 87.62;
+                const uint32_t max_level           = 4;
+
+                auto cfg = first_device->getTaskConfigurator<float>();
+                cfg->setHardwareConfig(
+                       std::make_shared<HardwareConfig<float>>(9001, 100, 16 * 1024 * 1024)
+                )
+                    .setAlgorithmConfig(std::make_shared<VibwaAlgorithmConfig<float>>(
+                        mass, mass, 0.001, 0.1, 0, max_level
+                    ))
+                    .setPotentialSource(std::make_shared<MorsePotentialGenerator<float>>(
+                        std::vector<MorsePotentialConfig<float>>{
+                            MorsePotentialConfig<float>(
+                                dissociation_energy, 2.0, well_width, 1.0, 10.0, 9001
+                            )
+                        }
+                    ));
+
+                auto handle = first_device->submitTask(cfg);
+                handle->startWorker();
+                handle->wait();
+
+                ASSERT_EQ(handle->getPotentialCount(), 1);
+                ASSERT_EQ(handle->getLevelCount(), max_level + 1);
+
+                // E(v) = we (v + 1/2) - wexe (v + 1/2)^2, with B = hbar^2 / (2 mu).
+                const double rotational_constant = 16.857629206 / (mass / 2);
+                const double we =
+                    2 * well_width * std::sqrt(rotational_constant * dissociation_energy);
+                const double wexe = well_width * well_width * rotational_constant;
+
+                const auto& levels = handle->getLevelEnergies();
+                for (uint32_t v = 0; v <= max_level; v++) {
+                    const double expected = we * (v + 0.5) - wexe * (v + 0.5) * (v + 0.5);
+                    EXPECT_NEAR(levels[v], expected, 0.05) << "level " << v;
+                }
+            }
+
+            template <typename FP>
+            std::vector<FP> runMorseTask(
+                const std::shared_ptr<ComputeDeviceInterface>& device,
+                std::shared_ptr<PotentialSource<FP>>           source
+            ) {
+                auto cfg = device->getTaskConfigurator<FP>();
+                cfg->setHardwareConfig(std::make_shared<HardwareConfig<FP>>(2001, 8, 1024 * 1024))
+                    .setAlgorithmConfig(std::make_shared<VibwaAlgorithmConfig<FP>>(
+                        87.62, 87.62, 0.0045, 0.1, 0, 19
+                    ))
+                    .setPotentialSource(std::move(source));
+
+                auto handle = device->submitTask(cfg);
+                handle->startWorker();
+                handle->wait();
+                return handle->getLevelEnergies();
+            }
+
+            template <typename FP>
+            void checkMorseGeneratedOnDeviceMatchesHostCurves(
+                const std::shared_ptr<ComputeDeviceInterface>& device, double tolerance
+            ) {
+                std::vector<MorsePotentialConfig<FP>> configurations{};
+                for (uint32_t i = 0; i < 20; i++) {
+                    configurations.emplace_back(
+                        5000.0 + 50.0 * i, 2.0 + 0.01 * i, 1.0, 1.0, 10.0, 2001
+                    );
+                }
+                auto generator =
+                    std::make_shared<MorsePotentialGenerator<FP>>(std::move(configurations));
+                // Same curves evaluated on host.
+                auto curves = generator->get_potential_buffer();
+
+                const auto generated = runMorseTask<FP>(device, generator);
+                const auto uploaded  = runMorseTask<FP>(device, curves);
+                ASSERT_EQ(generated.size(), uploaded.size());
+                for (size_t i = 0; i < generated.size(); i++) {
+                    if (std::isnan(uploaded[i])) {
+                        EXPECT_TRUE(std::isnan(generated[i])) << "level " << i;
+                        continue;
+                    }
+                    EXPECT_NEAR(generated[i], uploaded[i], tolerance) << "level " << i;
+                }
+            }
+
+            TEST_F(LibGPUTest, MorseGeneratedOnDeviceMatchesHostCurves) {
+                auto ctx = ComputeContext::create();
+
+                auto device_info_vector = ctx->getPhysicalDevicesInfo();
+                auto first_device =
+                    ctx->getDeviceInterface(device_info_vector[0].deviceProperties.deviceID);
+
+                // exp() of device and host may differ in last bits of float.
+                checkMorseGeneratedOnDeviceMatchesHostCurves<float>(first_device, 0.05);
+                checkMorseGeneratedOnDeviceMatchesHostCurves<double>(first_device, 1e-6);
+            }
+
+            TEST_F(LibGPUTest, DedicatedTransferQueueFamilyIsTransferOnly) {
+                auto ctx = ComputeContext::create();
+
+                auto device_info_vector = ctx->getPhysicalDevicesInfo();
+                auto first_device_info  = device_info_vector[0];
+                auto first_device =
+                    ctx->getDeviceInterface(first_device_info.deviceProperties.deviceID);
+
+                auto device_context = first_device->getDeviceContext();
+                auto families = first_device->getPhysicalDevice().getQueueFamilyProperties();
+
+                const auto transfer_family = device_context->getTransferQueueFamilyIndex();
+                ASSERT_LT(transfer_family, families.size());
+                ASSERT_TRUE(families[transfer_family].queueFlags & vk::QueueFlagBits::eTransfer);
+
+                if (device_context->hasDedicatedTransferQueue()) {
+                    ASSERT_NE(transfer_family, device_context->getQueueFamilyIndex());
+                    ASSERT_FALSE(
+                        families[transfer_family].queueFlags & vk::QueueFlagBits::eCompute
+                    );
+                } else {
+                    ASSERT_EQ(transfer_family, device_context->getQueueFamilyIndex());
+                }
+            }
+
+            TEST_F(LibGPUTest, BufferDeviceAddressEnabledWhenSupported) {
+                auto ctx = ComputeContext::create();
+
+                auto device_info_vector = ctx->getPhysicalDevicesInfo();
+                auto first_device_info  = device_info_vector[0];
+                auto first_device =
+                    ctx->getDeviceInterface(first_device_info.deviceProperties.deviceID);
+
+                const auto& physical_device = first_device->getPhysicalDevice();
+                const auto  extensions = physical_device.enumerateDeviceExtensionProperties();
+                const bool  has_extension =
+                    std::any_of(extensions.begin(), extensions.end(), [](const auto& extension) {
+                        return std::string_view{extension.extensionName} ==
+                               VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME;
+                    });
+                const bool supported =
+                    has_extension &&
+                    physical_device
+                        .getFeatures2<
+                            vk::PhysicalDeviceFeatures2,
+                            vk::PhysicalDeviceBufferDeviceAddressFeatures>()
+                        .get<vk::PhysicalDeviceBufferDeviceAddressFeatures>()
+                        .bufferDeviceAddress;
+
+                ASSERT_EQ(
+                    first_device->getDeviceContext()->isBufferDeviceAddressEnabled(), supported
+                );
+            }
+
+            TEST_F(LibGPUTest, PackedBuffersKeepPotentialsApart) {
+                auto ctx = ComputeContext::create();
+
+                auto device_info_vector = ctx->getPhysicalDevicesInfo();
+                auto first_device_info  = device_info_vector[0];
+                auto first_device =
+                    ctx->getDeviceInterface(first_device_info.deviceProperties.deviceID);
+
+                // 3 batches, last one partially filled, suballocated from 1 MiB blocks.
+                std::vector<MorsePotentialConfig<float>> potentials{};
+                for (uint32_t i = 0; i < 40; i++) {
+                    potentials.emplace_back(5000.0F + 50.0F * i, 2.0, 1.0, 1.0, 10.0, 1001);
+                }
+                auto cfg = first_device->getTaskConfigurator<float>();
+                cfg->setHardwareConfig(
+                       std::make_shared<HardwareConfig<float>>(1001, 16, 1024 * 1024)
+                )
+                    .setAlgorithmConfig(std::make_shared<VibwaAlgorithmConfig<float>>(
+                        87.62, 87.62, 0.009, 0.1, 0, 2
+                    ))
+                    .setPotentialSource(std::make_shared<MorsePotentialGenerator<float>>(potentials
+                    ));
+
+                auto handle = first_device->submitTask(cfg);
+                handle->startWorker();
+                handle->wait();
+
+                ASSERT_EQ(handle->getPotentialCount(), 40);
+                // Deeper wells have higher levels, any mix-up of offsets breaks ordering.
+                for (uint32_t i = 1; i < 40; i++) {
+                    const auto previous = handle->getPotentialLevelEnergies(i - 1);
+                    const auto current  = handle->getPotentialLevelEnergies(i);
+                    for (uint32_t v = 0; v < current.size(); v++) {
+                        EXPECT_GT(current[v], previous[v]) << "potential " << i << " level " << v;
+                    }
+                }
+            }
+
+            TEST_F(LibGPUTest, PlanIsAvailableBeforeExecution) {
+                auto ctx = ComputeContext::create();
+
+                auto device_info_vector = ctx->getPhysicalDevicesInfo();
+                auto first_device_info  = device_info_vector[0];
+                auto first_device =
+                    ctx->getDeviceInterface(first_device_info.deviceProperties.deviceID);
+
+                std::vector<MorsePotentialConfig<float>> potentials(
+                    40, MorsePotentialConfig<float>(5000.0, 2.0, 1.0, 1.0, 10.0, 1001)
+                );
+                auto cfg = first_device->getTaskConfigurator<float>();
+                cfg->setHardwareConfig(
+                       std::make_shared<HardwareConfig<float>>(1001, 16, 1024 * 1024)
+                )
+                    .setAlgorithmConfig(std::make_shared<VibwaAlgorithmConfig<float>>(
+                        87.62, 87.62, 0.009, 0.1, 0, 2
+                    ))
+                    .setPotentialSource(std::make_shared<MorsePotentialGenerator<float>>(
+                        std::move(potentials)
+                    ));
+
+                const auto plan = VibwaAlgorithm<float>::planTask(
+                    first_device->getPhysicalDevice(), *first_device->getDeviceContext(), *cfg
+                );
+                ASSERT_EQ(plan.potentialsPerBatch, 16);
+                ASSERT_EQ(plan.batchCount, 3);
+                ASSERT_EQ(plan.slotCount, VibwaAlgorithm<float>::batchesInFlight);
+                ASSERT_GT(plan.deviceLocalBytes, 0);
+                ASSERT_GT(plan.hostVisibleBytes, 0);
+
+                auto handle = first_device->submitTask(cfg);
+                handle->startWorker();
+                handle->wait();
+                ASSERT_EQ(handle->getPotentialCount(), 40);
+            }
+
+            TEST_F(LibGPUTest, Float16StorageMatchesFloat32) {
+                auto ctx = ComputeContext::create();
+
+                auto device_info_vector = ctx->getPhysicalDevicesInfo();
+                auto first_device_info  = device_info_vector[0];
+                auto first_device =
+                    ctx->getDeviceInterface(first_device_info.deviceProperties.deviceID);
+
+                auto configure = [&first_device](PrecisionType storage_precision) {
+                    std::vector<MorsePotentialConfig<float>> potentials{};
+                    for (uint32_t i = 0; i < 4; i++) {
+                        potentials.emplace_back(5000.0F + 500.0F * i, 2.0, 1.0, 1.0, 10.0, 4001);
+                    }
+                    auto cfg = first_device->getTaskConfigurator<float>();
+                    cfg->setHardwareConfig(
+                           std::make_shared<HardwareConfig<float>>(4001, 4, 1024 * 1024)
+                    )
+                        .setAlgorithmConfig(std::make_shared<VibwaAlgorithmConfig<float>>(
+                            87.62, 87.62, 0.00225, 0.1, 0, 4
+                        ))
+                        .setPotentialSource(std::make_shared<MorsePotentialGenerator<float>>(
+                            std::move(potentials)
+                        ))
+                        .setStoragePrecision(storage_precision);
+                    return cfg;
+                };
+                auto cfg_float32 = configure(PrecisionType::Float32);
+                auto cfg_float16 = configure(PrecisionType::Float16);
+
+                // GPU only buffers are half as large, output buffers still hold floats.
+                const auto plan_float32 = VibwaAlgorithm<float>::planTask(
+                    first_device->getPhysicalDevice(),
+                    *first_device->getDeviceContext(),
+                    *cfg_float32
+                );
+                const auto plan_float16 = VibwaAlgorithm<float>::planTask(
+                    first_device->getPhysicalDevice(),
+                    *first_device->getDeviceContext(),
+                    *cfg_float16
+                );
+                ASSERT_EQ(plan_float16.potentialsPerBatch, plan_float32.potentialsPerBatch);
+                ASSERT_EQ(plan_float16.deviceLocalBytes * 2, plan_float32.deviceLocalBytes);
+
+                if (!first_device->getDeviceContext()->isFloat16StorageEnabled()) {
+                    GTEST_SKIP() << "Device doesn't support 16 bit storage buffers.";
+                }
+
+                auto handle_float32 = first_device->submitTask(cfg_float32);
+                auto handle_float16 = first_device->submitTask(cfg_float16);
+                handle_float32->startWorker();
+                handle_float16->startWorker();
+                handle_float32->wait();
+                handle_float16->wait();
+
+                const auto& expected = handle_float32->getLevelEnergies();
+                const auto& actual   = handle_float16->getLevelEnergies();
+                ASSERT_EQ(actual.size(), expected.size());
+                for (size_t i = 0; i < expected.size(); i++) {
+                    ASSERT_FALSE(std::isnan(expected[i])) << "index " << i;
+                    EXPECT_NEAR(actual[i], expected[i], 2e-3 * std::abs(expected[i]))
+                        << "index " << i;
+                }
+            }
+
+            TEST_F(LibGPUTest, EmulatedFloat64MatchesFloat64) {
+                auto ctx = ComputeContext::create();
+
+                auto device_info_vector = ctx->getPhysicalDevicesInfo();
+                auto first_device_info  = device_info_vector[0];
+                auto first_device =
+                    ctx->getDeviceInterface(first_device_info.deviceProperties.deviceID);
+
+                const double   dissociation_energy = 5500.0;
+                const double   well_width          = 1.0;
+                const double   mass                = 87.62;
+                const uint32_t max_level           = 4;
+
+                auto configure = [&](PrecisionType storage_precision) {
+                    auto cfg = first_device->getTaskConfigurator<double>();
+                    cfg->setHardwareConfig(
+                           std::make_shared<HardwareConfig<double>>(9001, 100, 16 * 1024 * 1024)
+                    )
+                        .setAlgorithmConfig(std::make_shared<VibwaAlgorithmConfig<double>>(
+                            mass, mass, 0.001, 0.1, 0, max_level
+                        ))
+                        .setPotentialSource(std::make_shared<MorsePotentialGenerator<double>>(
+                            std::vector<MorsePotentialConfig<double>>{
+                                MorsePotentialConfig<double>(
+                                    dissociation_energy, 2.0, well_width, 1.0, 10.0, 9001
+                                )
+                            }
+                        ))
+                        .setStoragePrecision(storage_precision);
+                    return cfg;
+                };
+
+                auto handle_emulated = first_device->submitTask(
+                    configure(PrecisionType::Float64Emulated)
+                );
+                handle_emulated->startWorker();
+                handle_emulated->wait();
+
+                const auto& emulated = handle_emulated->getLevelEnergies();
+                ASSERT_EQ(emulated.size(), max_level + 1);
+
+                const double rotational_constant = 16.857629206 / (mass / 2);
+                const double we =
+                    2 * well_width * std::sqrt(rotational_constant * dissociation_energy);
+                const double wexe = well_width * well_width * rotational_constant;
+                for (uint32_t v = 0; v <= max_level; v++) {
+                    const double expected = we * (v + 0.5) - wexe * (v + 0.5) * (v + 0.5);
+                    EXPECT_NEAR(emulated[v], expected, 0.05) << "level " << v;
+                }
+
+                if (!first_device->getDeviceContext()->getEnabledFeatures().shaderFloat64) {
+                    GTEST_SKIP() << "Device doesn't support Float64 in shaders.";
+                }
+
+                auto handle_native = first_device->submitTask(configure(PrecisionType::Float64));
+                handle_native->startWorker();
+                handle_native->wait();
+
+                // Double-float carries about 48 bits of mantissa, far below error of
+                // Numerov discretization, which is same for both.
+                const auto& native = handle_native->getLevelEnergies();
+                ASSERT_EQ(native.size(), emulated.size());
+                for (size_t i = 0; i < native.size(); i++) {
+                    EXPECT_NEAR(emulated[i], native[i], 1e-8 * std::abs(native[i]))
+                        << "index " << i;
+                }
+            }
+
+            TEST_F(LibGPUTest, ConcurrentTasksShareDeviceContext) {
+                auto ctx = ComputeContext::create();
+
+                auto device_info_vector = ctx->getPhysicalDevicesInfo();
+                auto first_device_info  = device_info_vector[0];
+                auto first_device =
+                    ctx->getDeviceInterface(first_device_info.deviceProperties.deviceID);
+
+                auto device_context = first_device->getDeviceContext();
+                ASSERT_EQ(device_context, first_device->getDeviceContext());
+
+                std::vector<std::shared_ptr<TaskHandle<float>>> handles{};
+                for (uint32_t i = 0; i < 4; i++) {
+                    auto cfg = first_device->getTaskConfigurator<float>();
+                    cfg->setHardwareConfig(
+                           std::make_shared<HardwareConfig<float>>(500, 10, 16 * 1024 * 1024)
+                    )
+                        .setAlgorithmConfig(std::make_shared<VibwaAlgorithmConfig<float>>(
+                            87.62, 87.62, 0.1, 0.1, 0, 0
+                        ))
+                        .setPotentialSource(std::make_shared<MorsePotentialGenerator<float>>(
+                            std::vector<MorsePotentialConfig<float>>(
+                                16, MorsePotentialConfig<float>(5500.0, 0.6, 10, 0.0, 10.0, 500)
+                            )
+                        ));
+                    handles.push_back(first_device->submitTask(cfg));
+                    handles.back()->startWorker();
+                }
+                for (auto& handle : handles) {
+                    handle->wait();
+                    ASSERT_EQ(handle->getPotentialCount(), 16);
+                }
+                ASSERT_EQ(device_context, first_device->getDeviceContext());
+            }
+
+            TEST_F(LibGPUTest, TimingsCoverAllBatches) {
+                auto ctx = ComputeContext::create();
+
+                auto device_info_vector = ctx->getPhysicalDevicesInfo();
+                auto first_device_info  = device_info_vector[0];
+                auto first_device =
+                    ctx->getDeviceInterface(first_device_info.deviceProperties.deviceID);
+
+                std::vector<MorsePotentialConfig<float>> potentials(
+                    40, MorsePotentialConfig<float>(5000.0, 2.0, 1.0, 1.0, 10.0, 1001)
+                );
+                auto cfg = first_device->getTaskConfigurator<float>();
+                cfg->setHardwareConfig(
+                       std::make_shared<HardwareConfig<float>>(1001, 16, 1024 * 1024)
+                )
+                    .setAlgorithmConfig(std::make_shared<VibwaAlgorithmConfig<float>>(
+                        87.62, 87.62, 0.009, 0.1, 0, 2
+                    ))
+                    .setPotentialSource(std::make_shared<MorsePotentialGenerator<float>>(
+                        std::move(potentials)
+                    ));
+
+                auto handle = first_device->submitTask(cfg);
+                handle->startWorker();
+                handle->wait();
+                ASSERT_EQ(handle->getPotentialCount(), 40);
+
+                const auto& timings = handle->getTimings();
+                ASSERT_EQ(timings.batchCount, 3);
+                ASSERT_EQ(timings.total, handle->getElapsedTime());
+                // Host phases are sequential parts of worker thread.
+                ASSERT_LE(
+                    timings.potentialGeneration + timings.deviceSetup + timings.resourceSetup +
+                        timings.pipelineSetup + timings.stagingWrite + timings.deviceWait +
+                        timings.readBack,
+                    timings.total
+                );
+
+                const auto families = first_device->getPhysicalDevice().getQueueFamilyProperties();
+                const auto device   = first_device->getDeviceContext();
+                if (families[device->getQueueFamilyIndex()].timestampValidBits == 0) {
+                    GTEST_SKIP() << "Compute queue doesn't support timestamps.";
+                }
+                ASSERT_TRUE(timings.deviceCompute.has_value());
+                ASSERT_GT(timings.deviceCompute->count(), 0.0);
+                ASSERT_LE(*timings.deviceCompute, timings.total);
+                if (timings.deviceUpload) {
+                    ASSERT_LE(*timings.deviceUpload, timings.total);
+                }
+            }
+
+            TEST_F(LibGPUTest, CancelledTaskKeepsPartialResults) {
+                auto ctx = ComputeContext::create();
+
+                auto device_info_vector = ctx->getPhysicalDevicesInfo();
+                auto first_device_info  = device_info_vector[0];
+                auto first_device =
+                    ctx->getDeviceInterface(first_device_info.deviceProperties.deviceID);
+
+                // Far more work than is done before cancellation, in many chunks.
+                std::vector<MorsePotentialConfig<float>> potentials(
+                    4096, MorsePotentialConfig<float>(5000.0, 2.0, 1.0, 1.0, 10.0, 4001)
+                );
+                auto cfg = first_device->getTaskConfigurator<float>();
+                cfg->setHardwareConfig(
+                       std::make_shared<HardwareConfig<float>>(4001, 1024, 16 * 1024 * 1024)
+                )
+                    .setAlgorithmConfig(std::make_shared<VibwaAlgorithmConfig<float>>(
+                        87.62, 87.62, 0.00225, 0.1, 0, 40
+                    ))
+                    .setPotentialSource(std::make_shared<MorsePotentialGenerator<float>>(
+                        std::move(potentials)
+                    ));
+
+                auto handle = first_device->submitTask(cfg);
+                handle->startWorker();
+                std::this_thread::sleep_for(std::chrono::milliseconds{200});
+                handle->cancel();
+                handle->wait();
+
+                // Cancellation is not an error, finished chunks are readable and the rest
+                // stays NaN.
+                ASSERT_EQ(handle->getPotentialCount(), 4096);
+                const auto& levels   = handle->getLevelEnergies();
+                const auto& timings  = handle->getTimings();
+                const auto  computed = std::count_if(levels.begin(), levels.end(), [](float e) {
+                    return !std::isnan(e);
+                });
+                ASSERT_GE(timings.dispatchCount, 1);
+                ASSERT_LE(timings.batchCount, 4);
+                if (timings.batchCount < 4) {
+                    ASSERT_LT(computed, static_cast<std::ptrdiff_t>(levels.size()));
+                }
+                // Every dispatched chunk was read back, so device counters match results.
+                ASSERT_EQ(handle->getProgress().levelsFound, static_cast<uint64_t>(computed));
+            }
+
+            TEST_F(LibGPUTest, RunningTaskCanBeDestroyed) {
+                auto ctx = ComputeContext::create();
+
+                auto device_info_vector = ctx->getPhysicalDevicesInfo();
+                auto first_device =
+                    ctx->getDeviceInterface(device_info_vector[0].deviceProperties.deviceID);
+
+                std::vector<MorsePotentialConfig<float>> potentials(
+                    4096, MorsePotentialConfig<float>(5000.0, 2.0, 1.0, 1.0, 10.0, 4001)
+                );
+                auto cfg = first_device->getTaskConfigurator<float>();
+                cfg->setHardwareConfig(
+                       std::make_shared<HardwareConfig<float>>(4001, 1024, 16 * 1024 * 1024)
+                )
+                    .setAlgorithmConfig(std::make_shared<VibwaAlgorithmConfig<float>>(
+                        87.62, 87.62, 0.00225, 0.1, 0, 40
+                    ))
+                    .setPotentialSource(std::make_shared<MorsePotentialGenerator<float>>(
+                        std::move(potentials)
+                    ));
+
+                // Both with results kept by handle and with results streamed nobody reads.
+                for (const bool streaming : {false, true}) {
+                    auto handle = first_device->submitTask(cfg);
+                    if (streaming) {
+                        handle->enableResultStream(1);
+                    }
+                    handle->startWorker();
+                    std::this_thread::sleep_for(std::chrono::milliseconds{100});
+                    // Destructor stops worker before results it writes are freed.
+                    handle.reset();
+                }
+            }
+
+            TEST_F(LibGPUTest, ProgressMatchesResults) {
+                auto ctx = ComputeContext::create();
+
+                auto device_info_vector = ctx->getPhysicalDevicesInfo();
+                auto first_device_info  = device_info_vector[0];
+                auto first_device =
+                    ctx->getDeviceInterface(first_device_info.deviceProperties.deviceID);
+
+                std::vector<MorsePotentialConfig<float>> potentials(
+                    40, MorsePotentialConfig<float>(5000.0, 2.0, 1.0, 1.0, 10.0, 1001)
+                );
+                // Well holds about 114 levels, ones above dissociation energy are not found.
+                auto cfg = first_device->getTaskConfigurator<float>();
+                cfg->setHardwareConfig(
+                       std::make_shared<HardwareConfig<float>>(1001, 16, 1024 * 1024)
+                )
+                    .setAlgorithmConfig(std::make_shared<VibwaAlgorithmConfig<float>>(
+                        87.62, 87.62, 0.009, 0.1, 0, 159
+                    ))
+                    .setPotentialSource(std::make_shared<MorsePotentialGenerator<float>>(
+                        std::move(potentials)
+                    ));
+
+                auto handle = first_device->submitTask(cfg);
+                ASSERT_EQ(handle->getProgress().phase, TaskPhase::Pending);
+                handle->startWorker();
+                handle->wait();
+
+                const auto& levels   = handle->getLevelEnergies();
+                const auto  progress = handle->getProgress();
+                const auto  computed = std::count_if(levels.begin(), levels.end(), [](float e) {
+                    return !std::isnan(e);
+                });
+                ASSERT_LT(computed, static_cast<std::ptrdiff_t>(levels.size()));
+                ASSERT_EQ(progress.phase, TaskPhase::Finished);
+                ASSERT_EQ(progress.potentialCount, 40);
+                ASSERT_EQ(progress.potentialsCompleted, 40);
+                ASSERT_EQ(progress.levelsFound, static_cast<uint64_t>(computed));
+                // Morse potentials are generated on device, only their parameters are
+                // uploaded.
+                ASSERT_EQ(
+                    progress.bytesUploaded,
+                    40 * VibwaAlgorithm<float>::morseParameterCount * sizeof(float)
+                );
+                ASSERT_EQ(progress.bytesReadBack, 40 * 160 * sizeof(float));
+            }
         } // namespace cpp
     }     // namespace gpu
 } // namespace epseon
@@ -0,0 +1,88 @@
+#include "epseon/morse_evaluator.hpp"
+#include <cmath>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <limits>
+#include <vector>
+
+namespace epseon::cpp {
+    template <typename FP>
+    class MorseEvaluatorTest : public ::testing::Test {
+      protected:
+        // Relative error allowed for exp(), a few ulp.
+        static constexpr FP tolerance = 4 * std::numeric_limits<FP>::epsilon();
+
+        static std::vector<FP> evaluate(const std::vector<FP>& values) {
+            std::vector<FP> output(values.size());
+            evaluateExp<FP>(values, output);
+            return output;
+        }
+    };
+
+    using FloatingPointTypes = ::testing::Types<float, double>;
+    TYPED_TEST_SUITE(MorseEvaluatorTest, FloatingPointTypes);
+
+    TYPED_TEST(MorseEvaluatorTest, ExpMatchesStandardLibrary) {
+        // Range where results are normal numbers, count is not multiple of lane count.
+        const double minValue = std::log(std::numeric_limits<TypeParam>::min()) + 1;
+        const double maxValue = std::log(std::numeric_limits<TypeParam>::max()) - 1;
+        const size_t count    = 100003;
+
+        std::vector<TypeParam> values(count);
+        for (size_t i = 0; i < count; i++) {
+            values[i] =
+                static_cast<TypeParam>(minValue + (maxValue - minValue) * i / (count - 1));
+        }
+        const auto output = this->evaluate(values);
+        for (size_t i = 0; i < count; i++) {
+            const long double expected = std::exp(static_cast<long double>(values[i]));
+            ASSERT_LE(std::fabs((output[i] - expected) / expected), this->tolerance)
+                << "exp(" << values[i] << ")";
+        }
+    }
+
+    TYPED_TEST(MorseEvaluatorTest, ExpSaturatesOutsideRange) {
+        constexpr auto infinity = std::numeric_limits<TypeParam>::infinity();
+
+        const auto output = this->evaluate(
+            {-infinity, -1e6, 0, 1e6, infinity, std::numeric_limits<TypeParam>::quiet_NaN()}
+        );
+        EXPECT_EQ(output[0], TypeParam{0});
+        EXPECT_EQ(output[1], TypeParam{0});
+        EXPECT_EQ(output[2], TypeParam{1});
+        EXPECT_EQ(output[3], infinity);
+        EXPECT_EQ(output[4], infinity);
+        EXPECT_TRUE(std::isnan(output[5]));
+    }
+
+    TYPED_TEST(MorseEvaluatorTest, PaddingIsZeroed) {
+        std::vector<TypeParam> output(13, TypeParam{-1});
+
+        const MorseCurveSpec<TypeParam> spec{
+            .dissociationEnergy      = 5000,
+            .equilibriumBondDistance = 2,
+            .wellWidth               = 1,
+            .minR                    = 1,
+            .step                    = 1,
+            .pointCount              = 10,
+            .paddingCount            = 3,
+            .output                  = output.data()
+        };
+        evaluateMorseCurves<TypeParam>({&spec, 1}, 1);
+        EXPECT_NEAR(output[1], TypeParam{0}, 1e-3);
+        EXPECT_EQ(output[10], TypeParam{0});
+        EXPECT_EQ(output[12], TypeParam{0});
+    }
+
+    TYPED_TEST(MorseEvaluatorTest, RowStrideKeepsRowsAligned) {
+        constexpr size_t valuesPerAlignment = potentialMemoryAlignment / sizeof(TypeParam);
+
+        EXPECT_EQ(getAlignedRowStride<TypeParam>(0), 0u);
+        EXPECT_EQ(getAlignedRowStride<TypeParam>(1), valuesPerAlignment);
+        EXPECT_EQ(getAlignedRowStride<TypeParam>(valuesPerAlignment), valuesPerAlignment);
+        EXPECT_EQ(getAlignedRowStride<TypeParam>(valuesPerAlignment + 1), 2 * valuesPerAlignment);
+
+        const auto memory = allocatePotentialMemory<TypeParam>(3 * valuesPerAlignment);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(memory.get()) % potentialMemoryAlignment, 0u);
+    }
+} // namespace epseon::cpp
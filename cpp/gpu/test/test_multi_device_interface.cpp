@@ -0,0 +1,129 @@
+#include "epseon/gpu/compute_context.hpp"
+#include "epseon/gpu/multi_device_interface.hpp"
+#include "epseon/task_configurator/algorithm_config.hpp"
+#include "epseon/task_configurator/hardware_config.hpp"
+#include "epseon/task_configurator/potential_source.hpp"
+#include <chrono>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+namespace epseon::gpu::cpp {
+    class MultiDeviceInterfaceTest : public ::testing::Test {
+      protected:
+        std::shared_ptr<ComputeContext> ctx = ComputeContext::create();
+
+        uint32_t getFirstDeviceId() {
+            return ctx->getPhysicalDevicesInfo()[0].deviceProperties.deviceID;
+        }
+
+        static std::shared_ptr<TaskConfigurator<float>> configure(
+            std::shared_ptr<TaskConfigurator<float>> cfg, uint32_t potentialCount
+        ) {
+            std::vector<MorsePotentialConfig<float>> potentials{};
+            for (uint32_t i = 0; i < potentialCount; i++) {
+                potentials.emplace_back(5000.0F + 50.0F * i, 2.0, 1.0, 1.0, 10.0, 1001);
+            }
+            cfg->setHardwareConfig(std::make_shared<HardwareConfig<float>>(1001, 8, 1024 * 1024))
+                .setAlgorithmConfig(
+                    std::make_shared<VibwaAlgorithmConfig<float>>(87.62, 87.62, 0.009, 0.1, 0, 2)
+                )
+                .setPotentialSource(
+                    std::make_shared<MorsePotentialGenerator<float>>(std::move(potentials))
+                );
+            return cfg;
+        }
+    };
+
+    TEST_F(MultiDeviceInterfaceTest, ShardsOfRepeatedDeviceMatchSingleDevice) {
+        const auto deviceId = getFirstDeviceId();
+
+        auto single       = ctx->getDeviceInterface(deviceId);
+        auto singleHandle = single->submitTask(configure(single->getTaskConfigurator<float>(), 30));
+        singleHandle->startWorker();
+        singleHandle->wait();
+
+        auto multi = ctx->getMultiDeviceInterface({deviceId, deviceId, deviceId});
+        ASSERT_EQ(multi->getDevices().size(), 3);
+
+        auto multiHandle = multi->submitTask(configure(multi->getTaskConfigurator<float>(), 30));
+        multiHandle->startWorker();
+        multiHandle->wait();
+
+        ASSERT_EQ(multiHandle->getPotentialCount(), 30);
+        ASSERT_EQ(multiHandle->getLevelCount(), singleHandle->getLevelCount());
+
+        const auto& expected = singleHandle->getLevelEnergies();
+        const auto& actual   = multiHandle->getLevelEnergies();
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); i++) {
+            if (std::isnan(expected[i])) {
+                EXPECT_TRUE(std::isnan(actual[i])) << "index " << i;
+            } else {
+                EXPECT_FLOAT_EQ(actual[i], expected[i]) << "index " << i;
+            }
+        }
+
+        for (const auto throughput : multi->getThroughput()) {
+            EXPECT_GT(throughput, 0.0);
+        }
+    }
+
+    TEST_F(MultiDeviceInterfaceTest, ShardsOfCurveBufferMatchMorseShards) {
+        const auto deviceId = getFirstDeviceId();
+        auto       multi    = ctx->getMultiDeviceInterface({deviceId, deviceId});
+
+        auto morseConfig = configure(multi->getTaskConfigurator<float>(), 20);
+        // Same curves evaluated on host, shards slice one buffer instead of generating them.
+        auto curveConfig = std::make_shared<TaskConfigurator<float>>(*morseConfig);
+        curveConfig->setPotentialSource(morseConfig->getPotentialSource()->get_potential_buffer());
+
+        auto morseHandle = multi->submitTask(morseConfig);
+        morseHandle->startWorker();
+        morseHandle->wait();
+        auto curveHandle = multi->submitTask(curveConfig);
+        curveHandle->startWorker();
+        curveHandle->wait();
+
+        ASSERT_EQ(curveHandle->getPotentialCount(), 20);
+        const auto& expected = morseHandle->getLevelEnergies();
+        const auto& actual   = curveHandle->getLevelEnergies();
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); i++) {
+            if (std::isnan(expected[i])) {
+                EXPECT_TRUE(std::isnan(actual[i])) << "index " << i;
+            } else {
+                // exp() of device and host may differ in last bits of float.
+                EXPECT_NEAR(actual[i], expected[i], 0.05F) << "index " << i;
+            }
+        }
+    }
+
+    TEST_F(MultiDeviceInterfaceTest, EmptyTaskHasNoResults) {
+        const auto deviceId = getFirstDeviceId();
+
+        auto multi  = ctx->getMultiDeviceInterface({deviceId, deviceId});
+        auto handle = multi->submitTask(configure(multi->getTaskConfigurator<float>(), 0));
+        handle->startWorker();
+        handle->wait();
+
+        ASSERT_EQ(handle->getPotentialCount(), 0);
+        ASSERT_TRUE(handle->getLevelEnergies().empty());
+    }
+
+    TEST_F(MultiDeviceInterfaceTest, ShardsFollowMeasuredThroughput) {
+        const auto deviceId = getFirstDeviceId();
+
+        auto multi = ctx->getMultiDeviceInterface({deviceId, deviceId, deviceId});
+        // No measurements yet - equal shares, remainder goes to first devices.
+        ASSERT_EQ(multi->planShards(10), (std::vector<size_t>{4, 3, 3}));
+
+        multi->recordThroughput(0, 300, std::chrono::duration<double>(1.0));
+        multi->recordThroughput(1, 100, std::chrono::duration<double>(1.0));
+        // Unmeasured device is assumed to be average of measured ones.
+        ASSERT_EQ(multi->planShards(12), (std::vector<size_t>{6, 2, 4}));
+        ASSERT_EQ(multi->planShards(1), (std::vector<size_t>{1, 0, 0}));
+        ASSERT_EQ(multi->planShards(0), (std::vector<size_t>{0, 0, 0}));
+    }
+} // namespace epseon::gpu::cpp
@@ -0,0 +1,91 @@
+#include "epseon/gpu/compute_context.hpp"
+#include "epseon/gpu/device_interface.hpp"
+#include "epseon/gpu/pipeline_cache.hpp"
+#include "epseon/task_configurator/algorithm_config.hpp"
+#include "epseon/task_configurator/hardware_config.hpp"
+#include "epseon/task_configurator/potential_source.hpp"
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+namespace epseon::gpu::cpp {
+    class PipelineCacheTest : public ::testing::Test {
+      protected:
+        std::filesystem::path directory =
+            std::filesystem::temp_directory_path() / "epseon_gpu_pipeline_cache_test";
+
+        void SetUp() override {
+            std::filesystem::remove_all(directory);
+        }
+
+        void TearDown() override {
+            std::filesystem::remove_all(directory);
+        }
+
+        std::shared_ptr<ComputeDeviceInterface> getFirstDevice() {
+            auto ctx = ComputeContext::create(VK_MAKE_API_VERSION(0, 0, 1, 0), directory);
+
+            auto device_info_vector = ctx->getPhysicalDevicesInfo();
+            return ctx->getDeviceInterface(device_info_vector[0].deviceProperties.deviceID);
+        }
+
+        static void runTask(const std::shared_ptr<ComputeDeviceInterface>& device) {
+            auto cfg = device->getTaskConfigurator<float>();
+            cfg->setHardwareConfig(std::make_shared<HardwareConfig<float>>(500, 10, 1024 * 1024))
+                .setAlgorithmConfig(
+                    std::make_shared<VibwaAlgorithmConfig<float>>(87.62, 87.62, 0.1, 0.1, 0, 0)
+                )
+                .setPotentialSource(std::make_shared<MorsePotentialGenerator<float>>(
+                    std::vector<MorsePotentialConfig<float>>{
+                        MorsePotentialConfig<float>(5500.0, 0.6, 10, 0.0, 10.0, 500)
+                    }
+                ));
+
+            auto handle = device->submitTask(cfg);
+            handle->startWorker();
+            handle->wait();
+        }
+    };
+
+    TEST_F(PipelineCacheTest, CacheFileIsNamedAfterPipelineCacheUUID) {
+        auto device = getFirstDevice();
+
+        const auto& path = device->getPipelineCache().getPath();
+        ASSERT_EQ(path.parent_path(), directory);
+        ASSERT_EQ(
+            path.filename().string(),
+            PipelineCache::getFileName(device->getPhysicalDevice().getProperties())
+        );
+        ASSERT_TRUE(device->getPipelineCache().getData().empty());
+    }
+
+    TEST_F(PipelineCacheTest, CacheIsSavedAndLoadedByNextContext) {
+        auto device = getFirstDevice();
+        runTask(device);
+
+        const auto saved = device->getPipelineCache().getData();
+        ASSERT_TRUE(std::filesystem::exists(device->getPipelineCache().getPath()));
+        ASSERT_TRUE(device->getPipelineCache().isCompatible(saved));
+
+        auto reopened = getFirstDevice();
+        ASSERT_EQ(reopened->getPipelineCache().getData(), saved);
+        runTask(reopened);
+    }
+
+    TEST_F(PipelineCacheTest, IncompatibleCacheIsIgnored) {
+        auto path = getFirstDevice()->getPipelineCache().getPath();
+        std::filesystem::create_directories(directory);
+        {
+            std::ofstream file{path, std::ios::binary};
+            file << "definitely not a pipeline cache, but long enough to contain header";
+        }
+        auto device = getFirstDevice();
+        ASSERT_TRUE(device->getPipelineCache().getData().empty());
+
+        runTask(device);
+        ASSERT_TRUE(device->getPipelineCache().isCompatible(device->getPipelineCache().getData()
+        ));
+    }
+} // namespace epseon::gpu::cpp
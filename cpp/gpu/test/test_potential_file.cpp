@@ -0,0 +1,252 @@
+#include "epseon/potential_file.hpp"
+#include "epseon/task_configurator/potential_source.hpp"
+#include "fmt/format.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <ios>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace epseon::cpp {
+    template <typename FP>
+    class PotentialFileTest : public ::testing::Test {
+      protected:
+        // Values are exact in both precisions, so that converted curves compare equal.
+        std::vector<std::vector<FP>> curves    = {{0.5, 1.5, 2.5, 3.5}, {-1, -2, -3, -4}};
+        std::filesystem::path        directory = {};
+
+        void SetUp() override {
+            const auto* test = ::testing::UnitTest::GetInstance()->current_test_info();
+            // Names of typed test suites contain slashes.
+            std::string name =
+                std::string{"epseon_"} + test->test_suite_name() + "_" + test->name();
+            std::ranges::replace(name, '/', '_');
+            this->directory = std::filesystem::temp_directory_path() / name;
+            std::filesystem::create_directories(this->directory);
+        }
+
+        void TearDown() override {
+            std::filesystem::remove_all(this->directory);
+        }
+
+        template <typename Stored = FP>
+        std::string writeCurves(const std::string& name, double rMin = 1, double rMax = 4) {
+            std::vector<Stored> stored{};
+            for (const auto& curve : this->curves) {
+                stored.insert(stored.end(), curve.begin(), curve.end());
+            }
+            const size_t pointCount = this->curves.front().size();
+            const auto   path       = (this->directory / name).string();
+            writePotentialFile<Stored>(
+                path,
+                PotentialView<Stored>{stored.data(), this->curves.size(), pointCount, pointCount},
+                rMin,
+                rMax
+            );
+            return path;
+        }
+
+        std::string writeText(const std::string& name, const std::string& text) {
+            const auto    path = (this->directory / name).string();
+            std::ofstream file{path, std::ios::binary};
+            file << text;
+            return path;
+        }
+
+        // Text file holding curve of pointCount points on grid r = 0.001 * i.
+        std::string writeTextCurve(const std::string& name, size_t pointCount) {
+            std::string text = "# r V\n";
+            for (size_t i = 0; i < pointCount; i++) {
+                text += fmt::format("{:.6f} {:.9e}\n", 0.001 * i, 0.5 * i);
+            }
+            return this->writeText(name, text);
+        }
+
+        static std::vector<FP> parseText(const MappedFile& file, uint32_t threadCount) {
+            const auto      layout = scanPotentialTextFile(file, threadCount);
+            std::vector<FP> values(layout.info.pointCount);
+
+            const PotentialTextSpec<FP> spec{
+                .file = &file, .layout = &layout, .output = values.data()
+            };
+            parsePotentialTextFiles<FP>({&spec, 1}, threadCount);
+            return values;
+        }
+
+        // Overwrite size bytes of file at offset.
+        static void
+        patchFile(const std::string& path, size_t offset, const void* data, size_t size) {
+            std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+            file.seekp(static_cast<std::streamoff>(offset));
+            file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        }
+    };
+
+    using FloatingPointTypes = ::testing::Types<float, double>;
+    TYPED_TEST_SUITE(PotentialFileTest, FloatingPointTypes);
+
+    TYPED_TEST(PotentialFileTest, HeaderRoundTrips) {
+        const MappedFile file{this->template writeCurves<TypeParam>("curves.pot", 0.25, 8)};
+        const auto       info = readPotentialFileInfo(file);
+
+        EXPECT_EQ(info.precision, getPrecisionType<TypeParam>());
+        EXPECT_EQ(info.pointCount, 4);
+        EXPECT_EQ(info.curveCount, 2);
+        EXPECT_EQ(info.rMin, 0.25);
+        EXPECT_EQ(info.rMax, 8);
+        EXPECT_EQ(info.dataOffset % PotentialFileHeader::dataAlignment, 0);
+        EXPECT_EQ(file.getBytes().size(), info.dataOffset + 8 * sizeof(TypeParam));
+    }
+
+    TYPED_TEST(PotentialFileTest, MatchingPrecisionIsNotCopied) {
+        const PotentialFileLoader<TypeParam> loader{
+            std::vector<std::string>{this->template writeCurves<TypeParam>("curves.pot")}
+        };
+        const auto buffer = loader.get_potential_buffer();
+        const auto view   = buffer->getView();
+        ASSERT_EQ(view.size(), this->curves.size());
+        for (size_t i = 0; i < this->curves.size(); i++) {
+            EXPECT_TRUE(std::ranges::equal(view[i], this->curves[i]));
+        }
+        // Curves are read through mapping, which is kept alive by buffer.
+        const MappedFile file{this->directory / "curves.pot"};
+        EXPECT_EQ(
+            std::memcmp(
+                view.getData(),
+                file.getBytes().data() + PotentialFileHeader::dataAlignment,
+                8 * sizeof(TypeParam)
+            ),
+            0
+        );
+    }
+
+    TYPED_TEST(PotentialFileTest, OtherPrecisionIsConverted) {
+        using Other = std::conditional_t<std::is_same_v<TypeParam, float>, double, float>;
+
+        PotentialFileLoader<TypeParam> loader{
+            std::vector<std::string>{this->template writeCurves<Other>("curves.pot")}
+        };
+        EXPECT_EQ(loader.get_potential_data(), this->curves);
+    }
+
+    TYPED_TEST(PotentialFileTest, DifferentGridsAreRejected) {
+        const PotentialFileLoader<TypeParam> loader{std::vector<std::string>{
+            this->template writeCurves<TypeParam>("first.pot", 1, 4),
+            this->template writeCurves<TypeParam>("second.pot", 1, 5)
+        }};
+        EXPECT_THROW(static_cast<void>(loader.get_potential_buffer()), std::runtime_error);
+    }
+
+    TYPED_TEST(PotentialFileTest, TruncatedFileIsRejected) {
+        const auto path = this->template writeCurves<TypeParam>("curves.pot");
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+
+        const MappedFile file{path};
+        EXPECT_THROW(readPotentialFileInfo(file), std::runtime_error);
+    }
+
+    TYPED_TEST(PotentialFileTest, CorruptedHeaderIsRejected) {
+        const auto path = this->template writeCurves<TypeParam>("curves.pot");
+        {
+            const char magic[] = "NOTCURVE";
+            this->patchFile(path, 0, magic, 8);
+            const MappedFile file{path};
+            EXPECT_THROW(readPotentialFileInfo(file), std::runtime_error);
+        }
+        this->template writeCurves<TypeParam>("curves.pot");
+        {
+            const uint32_t valueBits = 16;
+            this->patchFile(path, 12, &valueBits, sizeof(valueBits));
+            const MappedFile file{path};
+            EXPECT_THROW(readPotentialFileInfo(file), std::runtime_error);
+        }
+        this->template writeCurves<TypeParam>("curves.pot");
+        {
+            // Product of counts overflows 64 bits.
+            const uint64_t curveCount = uint64_t{1} << 62;
+            this->patchFile(path, 24, &curveCount, sizeof(curveCount));
+            const MappedFile file{path};
+            EXPECT_THROW(readPotentialFileInfo(file), std::runtime_error);
+        }
+    }
+
+    TYPED_TEST(PotentialFileTest, EmptyFileIsRejected) {
+        const auto path = (this->directory / "empty.pot").string();
+        std::ofstream{path}.close();
+
+        const MappedFile file{path};
+        EXPECT_TRUE(file.getBytes().empty());
+        EXPECT_THROW(readPotentialFileInfo(file), std::runtime_error);
+    }
+
+    TYPED_TEST(PotentialFileTest, TextFileIsParsed) {
+        const MappedFile file{this->writeText(
+            "curve.txt",
+            "# r V(r)\n"
+            "\n"
+            "  1.0\t0.5\r\n"
+            "2.0, 1.5\n"
+            "# comment between points\n"
+            "3.0 2.5e0  \n"
+            "4 3.5"
+        )};
+        EXPECT_FALSE(isPotentialFile(file));
+
+        const auto layout = scanPotentialTextFile(file);
+        EXPECT_EQ(layout.info.pointCount, 4);
+        EXPECT_EQ(layout.info.curveCount, 1);
+        EXPECT_EQ(layout.info.rMin, 1);
+        EXPECT_EQ(layout.info.rMax, 4);
+        EXPECT_EQ(this->parseText(file, 0), this->curves[0]);
+    }
+
+    TYPED_TEST(PotentialFileTest, TextFileDoesntDependOnThreadCount) {
+        // Several chunks of text, so that they are parsed by multiple threads.
+        const size_t     pointCount = 200000;
+        const MappedFile file{this->writeTextCurve("curve.txt", pointCount)};
+        ASSERT_GT(scanPotentialTextFile(file).chunks.size(), 2);
+
+        const auto values = this->parseText(file, 1);
+        ASSERT_EQ(values.size(), pointCount);
+        for (size_t i = 0; i < pointCount; i++) {
+            ASSERT_EQ(values[i], static_cast<TypeParam>(0.5 * i));
+        }
+        EXPECT_EQ(this->parseText(file, 4), values);
+    }
+
+    TYPED_TEST(PotentialFileTest, NonUniformGridIsRejected) {
+        const MappedFile file{this->writeText("curve.txt", "1 0\n2 0\n2.5 0\n4 0\n")};
+        EXPECT_THROW(this->parseText(file, 0), std::runtime_error);
+    }
+
+    TYPED_TEST(PotentialFileTest, MalformedTextIsRejected) {
+        for (const auto* text : {"1 0\n2\n3 0\n", "1 0\n2 0 0\n3 0\n", "1 0\n2 x\n3 0\n"}) {
+            const MappedFile file{this->writeText("curve.txt", text)};
+            EXPECT_THROW(this->parseText(file, 0), std::runtime_error) << text;
+        }
+        const MappedFile empty{this->writeText("empty.txt", "# no points\n")};
+        EXPECT_THROW(scanPotentialTextFile(empty), std::runtime_error);
+    }
+
+    TYPED_TEST(PotentialFileTest, TextAndBinaryFilesAreConcatenated) {
+        // Curves of binary file share grid r = 1, 2, 3, 4 with curve of text file.
+        PotentialFileLoader<TypeParam> loader{std::vector<std::string>{
+            this->writeText("curve.txt", "1 4\n2 3\n3 2\n4 1\n"),
+            this->template writeCurves<TypeParam>("curves.pot")
+        }};
+        EXPECT_EQ(loader.get_potential_count(), 3);
+
+        const auto data = loader.get_potential_data();
+        ASSERT_EQ(data.size(), 3);
+        EXPECT_EQ(data[0], (std::vector<TypeParam>{4, 3, 2, 1}));
+        EXPECT_EQ(data[1], this->curves[0]);
+        EXPECT_EQ(data[2], this->curves[1]);
+    }
+} // namespace epseon::cpp
@@ -0,0 +1,95 @@
+#include "epseon/gpu/result_stream.hpp"
+#include <gtest/gtest.h>
+#include <optional>
+#include <stdexcept>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace epseon::gpu::cpp {
+    class ResultStreamTest : public ::testing::Test {
+      protected:
+        static BatchResult<float> makeBatch(size_t firstPotential) {
+            return BatchResult<float>{
+                .firstPotential = firstPotential,
+                .levelCount     = 2,
+                .levelEnergies  = {1.0F, 2.0F, 3.0F, 4.0F}
+            };
+        }
+    };
+
+    TEST_F(ResultStreamTest, ResultsArePoppedInOrder) {
+        ResultStream<float> stream{4};
+        std::stop_source    stop{};
+
+        ASSERT_TRUE(stream.push(makeBatch(0), stop.get_token()));
+        ASSERT_TRUE(stream.push(makeBatch(16), stop.get_token()));
+        stream.close();
+
+        auto first = stream.pop();
+        ASSERT_TRUE(first.has_value());
+        ASSERT_EQ(first->firstPotential, 0);
+        ASSERT_EQ(first->getPotentialCount(), 2);
+        ASSERT_EQ(stream.pop()->firstPotential, 16);
+        ASSERT_FALSE(stream.pop().has_value());
+        ASSERT_TRUE(stream.isDrained());
+    }
+
+    TEST_F(ResultStreamTest, TryPopNeverBlocks) {
+        ResultStream<float> stream{1};
+        std::stop_source    stop{};
+
+        ASSERT_FALSE(stream.tryPop().has_value());
+        ASSERT_TRUE(stream.push(makeBatch(0), stop.get_token()));
+        ASSERT_EQ(stream.tryPop()->firstPotential, 0);
+        ASSERT_FALSE(stream.tryPop().has_value());
+    }
+
+    TEST_F(ResultStreamTest, FullStreamBlocksUntilStopped) {
+        ResultStream<float> stream{1};
+        std::stop_source    stop{};
+        ASSERT_TRUE(stream.push(makeBatch(0), stop.get_token()));
+
+        bool         pushed = true;
+        std::jthread producer{[&]() { pushed = stream.push(makeBatch(1), stop.get_token()); }};
+        stop.request_stop();
+        producer.join();
+
+        ASSERT_FALSE(pushed);
+        ASSERT_EQ(stream.tryPop()->firstPotential, 0);
+        ASSERT_FALSE(stream.tryPop().has_value());
+    }
+
+    TEST_F(ResultStreamTest, FullStreamResumesWhenConsumed) {
+        ResultStream<float> stream{1};
+        std::stop_source    stop{};
+
+        std::jthread producer{[&]() {
+            for (size_t i = 0; i < 8; i++) {
+                stream.push(makeBatch(i), stop.get_token());
+            }
+            stream.close();
+        }};
+        std::vector<size_t> received{};
+        while (auto batch = stream.pop()) {
+            received.push_back(batch->firstPotential);
+        }
+        ASSERT_EQ(received, (std::vector<size_t>{0, 1, 2, 3, 4, 5, 6, 7}));
+    }
+
+    TEST_F(ResultStreamTest, ErrorIsRethrownAfterDrain) {
+        ResultStream<float> stream{2};
+        std::stop_source    stop{};
+
+        ASSERT_TRUE(stream.push(makeBatch(0), stop.get_token()));
+        stream.close(std::make_exception_ptr(std::runtime_error("Device lost.")));
+        ASSERT_FALSE(stream.push(makeBatch(1), stop.get_token()));
+
+        ASSERT_EQ(stream.pop()->firstPotential, 0);
+        ASSERT_THROW(stream.pop(), std::runtime_error);
+    }
+
+    TEST_F(ResultStreamTest, ZeroCapacityIsRejected) {
+        ASSERT_THROW(ResultStream<float>{0}, std::runtime_error);
+    }
+} // namespace epseon::gpu::cpp
@@ -0,0 +1,269 @@
+#include "epseon/gpu/algorithms/vibwa.hpp"
+#include "epseon/potential_file.hpp"
+#include "epseon/task_configurator/algorithm_config.hpp"
+#include "epseon/task_configurator/hardware_config.hpp"
+#include "epseon/task_configurator/potential_source.hpp"
+#include "epseon/task_configurator/task_configurator.hpp"
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace epseon::gpu::cpp {
+    class VibwaBatchPlanTest : public ::testing::Test {
+      protected:
+        using Vibwa = VibwaAlgorithm<double>;
+
+        static constexpr vk::DeviceSize GiB = vk::DeviceSize{1} << 30U;
+
+        // Discrete GPU with 8 GiB of free VRAM and descriptor arrays of 4 buffers.
+        static VibwaDeviceLimits getLimits() {
+            return VibwaDeviceLimits{
+                .maxStorageBufferRange   = vk::DeviceSize{1} << 27U,
+                .maxMemoryAllocationSize = 4 * GiB,
+                .deviceLocalBudget       = 8 * GiB,
+                .hostVisibleBudget       = 16 * GiB,
+                .sharedHeap              = false,
+                .maxWorkGroupCount       = 65535,
+                .maxBufferSetCount       = 4
+            };
+        }
+
+        static ShaderBuffersRequirements<double> getRequirements(uint32_t pointCount) {
+            return ShaderBuffersRequirements<double>{
+                .stagingBuffersCount               = 1,
+                .stagingBuffersElementCount        = pointCount,
+                .gpuOnlyStorageBuffersCount        = Vibwa::gpuOnlyBufferCount,
+                .gpuOnlyStorageBuffersElementCount = pointCount,
+                .outputBuffersCount                = 1,
+                .outputBuffersElementCount         = 20
+            };
+        }
+
+        /* Stride of potential slots task with given source and potential buffer size would
+         * use, as chosen in VibwaAlgorithm::run(). */
+        static uint32_t getSlotStride(
+            const std::shared_ptr<PotentialSource<double>>& source,
+            const PotentialView<double>&                    potentials,
+            uint32_t                                        potentialBufferSize
+        ) {
+            const TaskConfigurator<double> configurator{
+                std::make_shared<HardwareConfig<double>>(potentialBufferSize, 4, 0),
+                source,
+                std::make_shared<VibwaAlgorithmConfig<double>>()
+            };
+            const auto requirements = Vibwa::getShaderBufferRequirements(configurator);
+            return Vibwa::getPotentialSlotStride(
+                potentials,
+                requirements.front().gpuOnlyStorageBuffersElementCount,
+                PrecisionType::Float64
+            );
+        }
+
+        static void expectWithinLimits(
+            const VibwaBatchPlan&                    plan,
+            const VibwaDeviceLimits&                 limits,
+            const ShaderBuffersRequirements<double>& requirements,
+            size_t                                   groupSize,
+            size_t                                   potentialCount
+        ) {
+            ASSERT_GT(plan.potentialsPerBatch, 0);
+            ASSERT_GT(plan.potentialsPerBuffer, 0);
+            EXPECT_LE(plan.potentialsPerBatch, groupSize);
+            EXPECT_LE(plan.potentialsPerBatch, limits.maxWorkGroupCount);
+            EXPECT_LE(plan.potentialsPerBuffer, plan.potentialsPerBatch);
+            EXPECT_LE(plan.bufferSetCount, limits.maxBufferSetCount);
+            EXPECT_GE(
+                vk::DeviceSize{plan.bufferSetCount} * plan.potentialsPerBuffer,
+                plan.potentialsPerBatch
+            );
+
+            const vk::DeviceSize bufferBytes = vk::DeviceSize{plan.potentialsPerBuffer} *
+                                               requirements.gpuOnlyStorageBuffersElementCount *
+                                               sizeof(double);
+            EXPECT_LE(bufferBytes, limits.maxStorageBufferRange);
+            EXPECT_LE(bufferBytes, limits.maxMemoryAllocationSize);
+
+            // Batches cover all potentials, last one may be partial.
+            EXPECT_GE(plan.batchCount * plan.potentialsPerBatch, potentialCount);
+            EXPECT_LT((plan.batchCount - 1) * plan.potentialsPerBatch, potentialCount);
+
+            const auto maxUsage = [](vk::DeviceSize budget) {
+                return static_cast<double>(budget) * Vibwa::maxBudgetUsage;
+            };
+            if (limits.sharedHeap) {
+                EXPECT_LE(
+                    static_cast<double>(plan.deviceLocalBytes + plan.hostVisibleBytes),
+                    maxUsage(limits.deviceLocalBudget)
+                );
+            } else {
+                EXPECT_LE(
+                    static_cast<double>(plan.deviceLocalBytes), maxUsage(limits.deviceLocalBudget)
+                );
+                EXPECT_LE(
+                    static_cast<double>(plan.hostVisibleBytes), maxUsage(limits.hostVisibleBudget)
+                );
+            }
+        }
+    };
+
+    TEST_F(VibwaBatchPlanTest, RequirementSizesDontOverflow) {
+        const auto requirements = getRequirements(300'000'000);
+
+        EXPECT_EQ(requirements.getStagingBuffersSizeBytes(), uint64_t{2'400'000'000});
+        EXPECT_EQ(requirements.getGpuOnlyStorageBufferSizeBytes(), uint64_t{4'800'000'000});
+    }
+
+    TEST_F(VibwaBatchPlanTest, MillionsOfPotentialsAreSplitIntoBatches) {
+        const auto   limits         = getLimits();
+        const auto   requirements   = getRequirements(10'000);
+        const size_t groupSize      = size_t{1} << 20U;
+        const size_t potentialCount = 3'000'000;
+
+        const auto plan = Vibwa::planBatches(limits, requirements, groupSize, potentialCount);
+        expectWithinLimits(plan, limits, requirements, groupSize, potentialCount);
+        EXPECT_GT(plan.batchCount, 1);
+        EXPECT_EQ(plan.slotCount, Vibwa::batchesInFlight);
+        // Descriptor arrays are the limiting factor here.
+        EXPECT_EQ(plan.bufferSetCount, limits.maxBufferSetCount);
+    }
+
+    TEST_F(VibwaBatchPlanTest, BufferDeviceAddressIsLimitedByMemory) {
+        auto limits              = getLimits();
+        limits.maxBufferSetCount = UINT32_MAX;
+
+        const auto   requirements   = getRequirements(10'000);
+        const size_t groupSize      = size_t{1} << 20U;
+        const size_t potentialCount = 3'000'000;
+
+        const auto plan = Vibwa::planBatches(limits, requirements, groupSize, potentialCount);
+        expectWithinLimits(plan, limits, requirements, groupSize, potentialCount);
+
+        const auto descriptorPlan =
+            Vibwa::planBatches(getLimits(), requirements, groupSize, potentialCount);
+        EXPECT_GT(plan.potentialsPerBatch, descriptorPlan.potentialsPerBatch);
+        // Batches in flight take nearly all of VRAM task may use.
+        EXPECT_GT(
+            static_cast<double>(plan.deviceLocalBytes),
+            0.99 * static_cast<double>(limits.deviceLocalBudget) * Vibwa::maxBudgetUsage
+        );
+    }
+
+    TEST_F(VibwaBatchPlanTest, SharedHeapBudgetHoldsAllBuffers) {
+        auto limits              = getLimits();
+        limits.sharedHeap        = true;
+        limits.deviceLocalBudget = GiB;
+        limits.hostVisibleBudget = GiB;
+        limits.maxBufferSetCount = UINT32_MAX;
+
+        const auto requirements = getRequirements(10'000);
+        const auto plan         = Vibwa::planBatches(limits, requirements, 100'000, 100'000);
+        expectWithinLimits(plan, limits, requirements, 100'000, 100'000);
+    }
+
+    TEST_F(VibwaBatchPlanTest, SmallTaskIsSingleBatch) {
+        const auto limits       = getLimits();
+        const auto requirements = getRequirements(1'000);
+
+        const auto plan = Vibwa::planBatches(limits, requirements, 64, 10);
+        expectWithinLimits(plan, limits, requirements, 64, 10);
+        EXPECT_EQ(plan.potentialsPerBatch, 10);
+        EXPECT_EQ(plan.potentialsPerBuffer, 10);
+        EXPECT_EQ(plan.bufferSetCount, 1);
+        EXPECT_EQ(plan.batchCount, 1);
+        EXPECT_EQ(plan.slotCount, 1);
+    }
+
+    TEST_F(VibwaBatchPlanTest, PotentialLargerThanDeviceLimitsThrows) {
+        const auto limits = getLimits();
+
+        // Single potential buffer would exceed maxStorageBufferRange.
+        EXPECT_THROW(
+            Vibwa::planBatches(limits, getRequirements(20'000'000), 1, 1), std::runtime_error
+        );
+
+        auto tinyBudget              = getLimits();
+        tinyBudget.deviceLocalBudget = 1024;
+        EXPECT_THROW(
+            Vibwa::planBatches(tinyBudget, getRequirements(1'000), 1, 1), std::runtime_error
+        );
+        EXPECT_THROW(
+            Vibwa::planBatches(limits, getRequirements(1'000), 0, 1), std::runtime_error
+        );
+    }
+
+    TEST_F(VibwaBatchPlanTest, ChunkSizeScalesTowardsTargetDuration) {
+        using std::chrono::milliseconds;
+        const auto target = Vibwa::targetChunkDuration;
+
+        EXPECT_EQ(Vibwa::getNextChunkSize(64, target, 1024), 64);
+        EXPECT_EQ(Vibwa::getNextChunkSize(64, target * 2, 1024), 32);
+        EXPECT_EQ(Vibwa::getNextChunkSize(64, target / 2, 1024), 128);
+        // Changes are limited to four times per chunk.
+        EXPECT_EQ(Vibwa::getNextChunkSize(64, milliseconds{0}, 1024), 256);
+        EXPECT_EQ(Vibwa::getNextChunkSize(64, target * 100, 1024), 16);
+        // Chunks never exceed batch and never become empty.
+        EXPECT_EQ(Vibwa::getNextChunkSize(512, target / 4, 1024), 1024);
+        EXPECT_EQ(Vibwa::getNextChunkSize(1, target * 4, 1024), 1);
+    }
+
+    TEST_F(VibwaBatchPlanTest, GeneratedPotentialsAreCopiedAtOnce) {
+        // Point count which is not multiple of row alignment, so rows are padded.
+        const uint32_t                     pointCount = 1'001;
+        const MorsePotentialConfig<double> config{1.0, 2.0, 3.0, 0.1, 5.0, pointCount};
+        const auto                         generator =
+            std::make_shared<MorsePotentialGenerator<double>>(std::vector{config, config, config});
+        const auto buffer     = generator->get_potential_buffer();
+        const auto potentials = buffer->getView();
+        ASSERT_NE(potentials.getRowStride(), pointCount);
+
+        for (const uint32_t potentialBufferSize : {pointCount, 4 * pointCount}) {
+            const uint32_t stride = getSlotStride(generator, potentials, potentialBufferSize);
+            EXPECT_EQ(stride, potentials.getRowStride());
+            EXPECT_TRUE(
+                Vibwa::canCopyPotentialsAtOnce(potentials, stride, PrecisionType::Float64)
+            );
+        }
+    }
+
+    TEST_F(VibwaBatchPlanTest, FilePotentialsAreCopiedAtOnce) {
+        const auto path =
+            std::filesystem::temp_directory_path() / "epseon_VibwaBatchPlanTest_file.pot";
+        const std::vector<double> values(3 * 1'001, 1.0);
+        writePotentialFile<double>(path, {values.data(), 3, 1'001, 1'001}, 1, 2);
+
+        const auto loader = std::make_shared<PotentialFileLoader<double>>(
+            std::vector<std::string>{path.string()}
+        );
+        const auto buffer     = loader->get_potential_buffer();
+        const auto potentials = buffer->getView();
+        // Mapped file is used in place, its rows are not padded.
+        EXPECT_EQ(potentials.getRowStride(), 1'001);
+
+        const uint32_t stride = getSlotStride(loader, potentials, 2'000);
+        EXPECT_EQ(stride, 1'001);
+        EXPECT_TRUE(Vibwa::canCopyPotentialsAtOnce(potentials, stride, PrecisionType::Float64));
+        std::filesystem::remove(path);
+    }
+
+    TEST_F(VibwaBatchPlanTest, ConvertedPotentialsAreCopiedOneByOne) {
+        const std::vector<double>   values(3 * 100, 1.0);
+        const PotentialView<double> potentials{values.data(), 3, 100, 100};
+
+        // Slots keep stride of potential buffer size and curves are converted one by one.
+        EXPECT_EQ(Vibwa::getPotentialSlotStride(potentials, 128, PrecisionType::Float16), 128);
+        EXPECT_FALSE(Vibwa::canCopyPotentialsAtOnce(potentials, 128, PrecisionType::Float16));
+        // Curves spread further apart than slots, e.g. columns of wider NumPy array.
+        const PotentialView<double> spread{values.data(), 3, 50, 100};
+        EXPECT_EQ(Vibwa::getPotentialSlotStride(spread, 64, PrecisionType::Float64), 64);
+        EXPECT_FALSE(Vibwa::canCopyPotentialsAtOnce(spread, 64, PrecisionType::Float64));
+        // Single curve is copied at once whatever the stride.
+        EXPECT_TRUE(Vibwa::canCopyPotentialsAtOnce(
+            potentials.subview(0, 1), 128, PrecisionType::Float64
+        ));
+    }
+} // namespace epseon::gpu::cpp
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "epseon/libepseon.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#define PrecisionTypeAssertValueCount(count)                      \
+    static_assert(                                                \
+        static_cast<int>(epseon::cpp::PrecisionType::_Last) == 4, \
+        "The number of PrecisionTypes has changed."               \
+    );
+
+namespace epseon::cpp {
+
+    enum class PrecisionType {
+        Float32,
+        Float64,
+        // Potentials stored in half precision, computation in Float32. Tasks still use
+        // float on host side, see TaskConfigurator::setStoragePrecision(). GPU only.
+        Float16,
+        // Float64 emulated with pairs of floats on devices without shaderFloat64. Tasks
+        // use double on host side, selected automatically when Float64 is not supported.
+        // GPU only.
+        Float64Emulated,
+        // If it is necessary to add new value, add it here, before _Last.
+        _Last // Marker for last enum value.
+    };
+
+    class InvalidPrecisionTypeString : public std::exception {
+      private:
+        std::string message;
+
+      public:
+        InvalidPrecisionTypeString(std::string_view);
+        const char* what() const noexcept override;
+    };
+
+    std::string   toString(PrecisionType);
+    PrecisionType toPrecisionType(std::string_view prec);
+
+    /* Size in bytes of single value stored with given precision. */
+    size_t getSizeBytes(PrecisionType);
+
+    template <typename FP>
+    PrecisionType getPrecisionType() {
+        PrecisionTypeAssertValueCount(4);
+        assert(false); // See template specializations in `enums.cpp`.
+    };
+
+    template <>
+    PrecisionType getPrecisionType<float>();
+
+    template <>
+    PrecisionType getPrecisionType<double>();
+} // namespace epseon::cpp
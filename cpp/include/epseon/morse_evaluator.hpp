@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+
+namespace epseon::cpp {
+
+    // Alignment in bytes of memory curves are generated into, enough for widest SIMD
+    // registers and a cache line.
+    constexpr size_t potentialMemoryAlignment = 64;
+
+    /* Morse curve V(r) = De (1 - exp(-a (r - re)))^2 sampled at r_i = minR + i * step. */
+    template <typename FP>
+    struct MorseCurveSpec {
+        FP       dissociationEnergy      = {};
+        FP       equilibriumBondDistance = {};
+        FP       wellWidth               = {};
+        FP       minR                    = {};
+        FP       step                    = {};
+        uint32_t pointCount              = {};
+        // Zeros written after curve values, so that padding of rows isn't left uninitialized.
+        uint32_t paddingCount            = {};
+        // pointCount + paddingCount values are written here.
+        FP*      output                  = nullptr;
+    };
+
+    /* Evaluate curves on threadCount threads, hardware concurrency if it is 0. Points of
+     * each curve are evaluated with SIMD instructions of host CPU, as fixed-width blocks
+     * of lanes with exp() computed by range reduction and polynomial, accurate to a few
+     * ulp. Results don't depend on thread count. */
+    template <typename FP>
+    void evaluateMorseCurves(std::span<const MorseCurveSpec<FP>> curves, uint32_t threadCount);
+
+    template <>
+    void evaluateMorseCurves<float>(
+        std::span<const MorseCurveSpec<float>> curves, uint32_t threadCount
+    );
+
+    template <>
+    void evaluateMorseCurves<double>(
+        std::span<const MorseCurveSpec<double>> curves, uint32_t threadCount
+    );
+
+    /* exp() used by evaluateMorseCurves(), applied to each of values, results are
+     * written to output of the same size. Underflows to 0 and overflows to infinity. */
+    template <typename FP>
+    void evaluateExp(std::span<const FP> values, std::span<FP> output);
+
+    template <>
+    void evaluateExp<float>(std::span<const float> values, std::span<float> output);
+
+    template <>
+    void evaluateExp<double>(std::span<const double> values, std::span<double> output);
+
+    /* Uninitialized memory for valueCount values aligned to potentialMemoryAlignment,
+     * released when last owner is gone. Memory isn't touched here, so that its pages are
+     * placed near threads which fill them. */
+    template <typename FP>
+    std::shared_ptr<FP> allocatePotentialMemory(size_t valueCount) {
+        auto* memory = static_cast<FP*>(
+            ::operator new(valueCount * sizeof(FP), std::align_val_t{potentialMemoryAlignment})
+        );
+        return std::shared_ptr<FP>(memory, [](FP* pointer) {
+            ::operator delete(pointer, std::align_val_t{potentialMemoryAlignment});
+        });
+    }
+
+    /* Distance in values between starts of rows of pointCount values, rounded up so that
+     * every row starts aligned to potentialMemoryAlignment. */
+    template <typename FP>
+    constexpr size_t getAlignedRowStride(size_t pointCount) {
+        constexpr size_t valuesPerAlignment = potentialMemoryAlignment / sizeof(FP);
+        return (pointCount + valuesPerAlignment - 1) / valuesPerAlignment * valuesPerAlignment;
+    }
+} // namespace epseon::cpp
@@ -0,0 +1,230 @@
+#pragma once
+
+#include "epseon/predecl.hpp"
+
+#include "epseon/enums.hpp"
+#include "fmt/format.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace epseon::cpp {
+
+    /* Header of binary container of potential curves sampled on the same grid. Integers
+     * and floats are stored little endian, header is followed by curve matrix - curveCount
+     * rows of pointCount values each, without padding, starting at dataOffset.
+     *
+     *  offset  size  field
+     *       0     8  magic, "EPSEONPT"
+     *       8     4  format version, 1
+     *      12     4  bits per value, 32 or 64
+     *      16     4  point count of each curve
+     *      20     4  reserved, 0
+     *      24     8  curve count
+     *      32     8  r_min, first point of grid
+     *      40     8  r_max, last point of grid
+     *      48     8  offset of curve matrix from start of file
+     *      56     8  reserved, 0
+     */
+    struct PotentialFileHeader {
+        static constexpr std::array<char, 8> expectedMagic = {
+            'E', 'P', 'S', 'E', 'O', 'N', 'P', 'T'
+        };
+        static constexpr uint32_t            currentVersion = 1;
+        // Curve matrix offset is multiple of this, so that mapped values are aligned.
+        static constexpr uint64_t            dataAlignment  = 64;
+
+        std::array<char, 8> magic      = expectedMagic;
+        uint32_t            version    = currentVersion;
+        uint32_t            valueBits  = {};
+        uint32_t            pointCount = {};
+        uint32_t            reserved0  = {};
+        uint64_t            curveCount = {};
+        double              rMin       = {};
+        double              rMax       = {};
+        uint64_t            dataOffset = {};
+        uint64_t            reserved1  = {};
+    };
+
+    static_assert(sizeof(PotentialFileHeader) == 64, "Potential file header must be 64 bytes.");
+
+    /* Validated contents of potential file header. */
+    struct PotentialFileInfo {
+        PrecisionType precision  = PrecisionType::Float64;
+        uint32_t      pointCount = {};
+        uint64_t      curveCount = {};
+        double        rMin       = {};
+        double        rMax       = {};
+        uint64_t      dataOffset = {};
+
+        [[nodiscard]] uint64_t getValueCount() const {
+            return this->curveCount * this->pointCount;
+        }
+    };
+
+    /* Read-only memory mapping of whole file. Nothing is read up front, pages are served
+     * from page cache when they are first accessed. */
+    class MappedFile {
+      private: /* Private members. */
+        std::filesystem::path path = {};
+        const std::byte*      data = nullptr;
+        size_t                size = {};
+
+      public: /* Public constructors. */
+        explicit MappedFile(std::filesystem::path path_);
+
+        // Copy constructor.
+        MappedFile(const MappedFile&) = delete;
+
+        // Copy assignment operator.
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // Move constructor.
+        MappedFile(MappedFile&&) = delete;
+
+        // Move assignment operator.
+        MappedFile& operator=(MappedFile&&) = delete;
+
+      public: /* Public destructor. */
+        ~MappedFile();
+
+      public: /* Public methods. */
+        [[nodiscard]] std::span<const std::byte> getBytes() const {
+            return {this->data, this->size};
+        }
+
+        [[nodiscard]] const std::filesystem::path& getPath() const {
+            return this->path;
+        }
+    };
+
+    /* Parse and validate header of mapped potential file, raises std::runtime_error if
+     * file is not a potential file or is truncated. */
+    PotentialFileInfo readPotentialFileInfo(const MappedFile& file);
+
+    /* Write curves of view and their grid to potential file, replacing existing one. All
+     * curves must have the same point count. */
+    template <typename FP>
+    void writePotentialFile(
+        const std::filesystem::path& path,
+        const PotentialView<FP>&     potentials,
+        double                       rMin,
+        double                       rMax
+    );
+
+    template <>
+    void writePotentialFile<float>(
+        const std::filesystem::path& path,
+        const PotentialView<float>&  potentials,
+        double                       rMin,
+        double                       rMax
+    );
+
+    template <>
+    void writePotentialFile<double>(
+        const std::filesystem::path& path,
+        const PotentialView<double>& potentials,
+        double                       rMin,
+        double                       rMax
+    );
+
+    /* Whether mapped file starts with magic of binary potential file, other files are
+     * read as text potential files. */
+    bool isPotentialFile(const MappedFile& file);
+
+    /* Lines of text potential file parsed by one thread, [begin, end) bytes of file
+     * holding points starting from firstPoint. */
+    struct PotentialTextChunk {
+        size_t begin      = {};
+        size_t end        = {};
+        size_t firstPoint = {};
+    };
+
+    /* Text potential file split into chunks, with point count and grid read from its
+     * first and last point. */
+    struct PotentialTextLayout {
+        PotentialFileInfo               info   = {};
+        std::vector<PotentialTextChunk> chunks = {};
+    };
+
+    /* Split text potential file, holding one curve as two columns of r and V(r) separated
+     * by whitespace or comma, into chunks ending at line ends and count points of chunks
+     * on threadCount threads (hardware concurrency if 0). Blank lines and lines starting
+     * with '#' are skipped. */
+    PotentialTextLayout scanPotentialTextFile(const MappedFile& file, uint32_t threadCount = 0);
+
+    // Deviation of r from uniform grid allowed in text potential files, fraction of step.
+    constexpr double gridTolerance = 1e-2;
+
+    /* Scanned text potential file and where its values are written. */
+    template <typename FP>
+    struct PotentialTextSpec {
+        const MappedFile*          file   = nullptr;
+        const PotentialTextLayout* layout = nullptr;
+        // layout->info.pointCount values are written here.
+        FP*                        output = nullptr;
+    };
+
+    /* Parse chunks of all files on threadCount threads (hardware concurrency if 0),
+     * values are written straight to outputs. Raises std::runtime_error if line is
+     * malformed or its r is off uniform grid spanning from first to last point by more
+     * than gridTolerance of step. */
+    template <typename FP>
+    void
+    parsePotentialTextFiles(std::span<const PotentialTextSpec<FP>> files, uint32_t threadCount);
+
+    template <>
+    void parsePotentialTextFiles<float>(
+        std::span<const PotentialTextSpec<float>> files, uint32_t threadCount
+    );
+
+    template <>
+    void parsePotentialTextFiles<double>(
+        std::span<const PotentialTextSpec<double>> files, uint32_t threadCount
+    );
+
+    /* Curve matrix of mapped file, valid as long as file is mapped. FP must match
+     * precision of file. */
+    template <typename FP>
+    std::span<const FP> getCurveMatrix(const MappedFile& file, const PotentialFileInfo& info) {
+        if (info.precision != getPrecisionType<FP>()) {
+            throw std::runtime_error(fmt::format(
+                "Potential file {} stores {} values, not {}.",
+                file.getPath().string(),
+                toString(info.precision),
+                toString(getPrecisionType<FP>())
+            ));
+        }
+        // Mapping is page aligned and offset is multiple of dataAlignment.
+        return {
+            reinterpret_cast<const FP*>(file.getBytes().data() + info.dataOffset),
+            static_cast<size_t>(info.getValueCount())
+        };
+    }
+
+    /* Copy curve matrix of mapped file to rows of output rowStride values apart,
+     * converting values to FP. */
+    template <typename FP>
+    void readCurveMatrix(
+        const MappedFile& file, const PotentialFileInfo& info, FP* output, size_t rowStride
+    ) {
+        auto copyRows = [&](auto matrix) {
+            for (size_t i = 0; i < info.curveCount; i++) {
+                std::ranges::copy(
+                    matrix.subspan(i * info.pointCount, info.pointCount), output + i * rowStride
+                );
+            }
+        };
+        if (info.precision == PrecisionType::Float32) {
+            copyRows(getCurveMatrix<float>(file, info));
+        } else {
+            copyRows(getCurveMatrix<double>(file, info));
+        }
+    }
+} // namespace epseon::cpp
@@ -0,0 +1,50 @@
+#pragma once
+
+/* Task configuration, potential sources and potential files are shared by GPU and CPU
+ * backends, both of them bring this namespace into their own. */
+namespace epseon::cpp {
+
+    template <typename FP>
+    struct HardwareConfig;
+
+    template <typename FP>
+    class PotentialView;
+
+    template <typename FP>
+    class PotentialSpan;
+
+    template <typename FP>
+    class PotentialSource;
+
+    template <typename FP>
+    class PotentialFileLoader;
+
+    template <typename FP>
+    class MorsePotentialConfig;
+
+    template <typename FP>
+    class MorsePotentialGenerator;
+
+    template <typename FP>
+    class PotentialBuffer;
+
+    struct PotentialFileHeader;
+    struct PotentialFileInfo;
+    struct PotentialTextChunk;
+    struct PotentialTextLayout;
+
+    template <typename FP>
+    struct PotentialTextSpec;
+
+    class MappedFile;
+
+    template <typename FP>
+    class AlgorithmConfig;
+
+    template <typename FP>
+    class VibwaAlgorithmConfig;
+
+    template <typename FP>
+    class TaskConfigurator;
+
+} // namespace epseon::cpp
@@ -1,41 +1,19 @@
 
 #pragma once
 
-#include "epseon/gpu/predecl.hpp"
+#include "epseon/predecl.hpp"
 
-#include "epseon/gpu/algorithms/algorithm.hpp"
-#include "epseon/gpu/algorithms/vibwa.hpp"
+#include "fmt/format.h"
 #include <cstdint>
+#include <limits>
 #include <memory>
+#include <stdexcept>
 #include <type_traits>
-#include <vector>
 
-namespace epseon::gpu::cpp {
-
-    template <typename FP>
-    struct ShaderBuffersRequirements {
-        uint32_t stagingBuffersCount        = {};
-        uint32_t stagingBuffersElementCount = {};
-
-        [[nodiscard]] uint32_t getStagingBuffersSizeBytes() const {
-            return stagingBuffersCount * stagingBuffersElementCount * sizeof(FP);
-        }
-
-        uint32_t gpuOnlyStorageBuffersCount        = {};
-        uint32_t gpuOnlyStorageBuffersElementCount = {};
-
-        [[nodiscard]] uint32_t getGpuOnlyStorageBufferSizeBytes() const {
-            return gpuOnlyStorageBuffersCount * gpuOnlyStorageBuffersElementCount * sizeof(FP);
-        }
-
-        uint32_t outputBuffersCount        = {};
-        uint32_t outputBuffersElementCount = {};
-
-        [[nodiscard]] uint32_t getOutputBufferSizeBytes() const {
-            return outputBuffersCount * outputBuffersElementCount * sizeof(FP);
-        }
-    };
+namespace epseon::cpp {
 
+    /* Parameters of algorithm run by task, backends pick their implementation of
+     * algorithm by type of configuration. */
     template <typename FP>
     class AlgorithmConfig : public std::enable_shared_from_this<AlgorithmConfig<FP>> {
         static_assert(std::is_floating_point<FP>::value, "FP must be an floating-point type.");
@@ -61,17 +39,11 @@ namespace epseon::gpu::cpp {
         virtual ~AlgorithmConfig() = default;
 
       public: /* Public methods. */
-        virtual bool equals(const AlgorithmConfig<FP>& other) const                          = 0;
-        [[nodiscard]] virtual std::shared_ptr<Algorithm<FP>>       getImplementation() const = 0;
-        [[nodiscard]] virtual std::shared_ptr<AlgorithmConfig<FP>> shared_clone() const      = 0;
-        [[nodiscard]] virtual std::unique_ptr<AlgorithmConfig<FP>> unique_clone() const      = 0;
-        virtual std::vector<ShaderBuffersRequirements<FP>>
-        getShaderBufferRequirements(const TaskConfigurator<FP>& config) const = 0;
+        virtual bool equals(const AlgorithmConfig<FP>& other) const                     = 0;
+        [[nodiscard]] virtual std::shared_ptr<AlgorithmConfig<FP>> shared_clone() const = 0;
+        [[nodiscard]] virtual std::unique_ptr<AlgorithmConfig<FP>> unique_clone() const = 0;
     };
 
-    template <typename FP>
-    class VibwaAlgorithm;
-
     template <typename FP>
     class VibwaAlgorithmConfig : public AlgorithmConfig<FP> {
       private: /* Private members. */
@@ -96,7 +68,23 @@ namespace epseon::gpu::cpp {
             integration_step(integration_step_),
             min_distance_to_asymptote(min_distance_to_asymptote_),
             min_level(min_level_),
-            max_level(max_level_) {}
+            max_level(max_level_) {
+            if (this->max_level < this->min_level) {
+                throw std::runtime_error(fmt::format(
+                    "Max level ({}) must not be lower than min level ({}).",
+                    this->max_level,
+                    this->min_level
+                ));
+            }
+            // Level count has to fit uint32_t, as do sizes of output buffers derived from it.
+            if (this->max_level - this->min_level == std::numeric_limits<uint32_t>::max()) {
+                throw std::runtime_error(fmt::format(
+                    "Levels from {} to {} are too many to compute.",
+                    this->min_level,
+                    this->max_level
+                ));
+            }
+        }
 
         // Default constructor.
         VibwaAlgorithmConfig() noexcept = default;
@@ -133,10 +121,6 @@ namespace epseon::gpu::cpp {
             return false;
         }
 
-        [[nodiscard]] std::shared_ptr<Algorithm<FP>> getImplementation() const override {
-            return std::dynamic_pointer_cast<Algorithm<FP>>(std::make_shared<VibwaAlgorithm<FP>>());
-        }
-
         [[nodiscard]] std::shared_ptr<AlgorithmConfig<FP>> shared_clone() const override {
             return std::make_shared<VibwaAlgorithmConfig<FP>>(*this);
         }
@@ -170,31 +154,9 @@ namespace epseon::gpu::cpp {
             return max_level;
         }
 
-        virtual std::vector<ShaderBuffersRequirements<FP>>
-        getShaderBufferRequirements(const TaskConfigurator<FP>& config) const {
-            uint32_t group_size         = config.getHardwareConfig()->getGroupSize();
-            uint32_t bufferElementCount = config.getHardwareConfig()->getPotentialBufferSize();
-            uint32_t level_count        = (this->max_level - this->min_level) + 1;
-
-            const uint32_t stagingBuffersCount        = 1;
-            const uint32_t gpuOnlyStorageBuffersCount = 5;
-            const uint32_t outputBuffersCount         = 1;
-
-            auto shaderRequirements = ShaderBuffersRequirements<FP>{
-                .stagingBuffersCount               = stagingBuffersCount,
-                .stagingBuffersElementCount        = bufferElementCount,
-                .gpuOnlyStorageBuffersCount        = gpuOnlyStorageBuffersCount,
-                .gpuOnlyStorageBuffersElementCount = bufferElementCount,
-                .outputBuffersCount                = outputBuffersCount,
-                .outputBuffersElementCount         = level_count
-            };
-
-            std::vector<ShaderBuffersRequirements<FP>> requirements{group_size};
-
-            for (uint32_t i = 0; i < group_size; i++) {
-                requirements[i] = shaderRequirements;
-            }
-            return std::move(requirements);
+        /* Number of levels from min level to max level, inclusive. */
+        [[nodiscard]] uint32_t getLevelCount() const {
+            return (this->max_level - this->min_level) + 1;
         }
     };
 
@@ -207,4 +169,4 @@ namespace epseon::gpu::cpp {
     bool operator==(const VibwaAlgorithmConfig<FP>& lhs, const VibwaAlgorithmConfig<FP>& rhs) {
         return lhs.equals(rhs);
     }
-} // namespace epseon::gpu::cpp
+} // namespace epseon::cpp
@@ -1,13 +1,23 @@
 
 #pragma once
 
-#include "epseon/gpu/predecl.hpp"
+#include "epseon/predecl.hpp"
 
 #include <cstdint>
 #include <memory>
-
-namespace epseon::gpu::cpp {
-
+#include <type_traits>
+
+namespace epseon::cpp {
+
+    /* Hardware configuration of compute task, the same values are accepted by GPU and
+     * CPU backends so task configurations can be moved between them unchanged.
+     *
+     * potential_buffer_size - maximal number of points in single potential curve.
+     * group_size            - number of potentials computed together, by one batch on
+     *                         GPU or by one worker thread on CPU.
+     * allocation_block_size - not used by CPU backend.
+     * workgroup_size        - not used by CPU backend.
+     */
     template <typename FP>
     struct HardwareConfig : public std::enable_shared_from_this<HardwareConfig<FP>> {
         static_assert(std::is_floating_point<FP>::value, "FP must be an floating-point type.");
@@ -16,14 +26,21 @@ namespace epseon::gpu::cpp {
         uint32_t potential_buffer_size = {};
         uint32_t group_size            = {};
         uint32_t allocation_block_size = {};
+        // Invocations per workgroup of compute shaders, 0 selects default clamped to
+        // device limits.
+        uint32_t workgroup_size        = {};
 
       public:
         HardwareConfig(
-            uint32_t potential_buffer_size_, uint32_t group_size_, uint32_t allocation_block_size_
+            uint32_t potential_buffer_size_,
+            uint32_t group_size_,
+            uint32_t allocation_block_size_,
+            uint32_t workgroup_size_ = 0
         ) :
             potential_buffer_size(potential_buffer_size_),
             group_size(group_size_),
-            allocation_block_size(allocation_block_size_) {}
+            allocation_block_size(allocation_block_size_),
+            workgroup_size(workgroup_size_) {}
 
         // Default constructor.
         HardwareConfig() = default;
@@ -49,7 +66,8 @@ namespace epseon::gpu::cpp {
             return (
                 this->potential_buffer_size == other.potential_buffer_size &&
                 this->group_size == other.group_size &&
-                this->allocation_block_size == other.allocation_block_size
+                this->allocation_block_size == other.allocation_block_size &&
+                this->workgroup_size == other.workgroup_size
             );
         }
 
@@ -73,5 +91,9 @@ namespace epseon::gpu::cpp {
         [[nodiscard]] uint32_t getAllocationBlockSize() const {
             return this->allocation_block_size;
         }
+
+        [[nodiscard]] uint32_t getWorkgroupSize() const {
+            return this->workgroup_size;
+        }
     };
-} // namespace epseon::gpu::cpp
+} // namespace epseon::cpp
@@ -0,0 +1,730 @@
+
+#pragma once
+
+#include "epseon/predecl.hpp"
+
+#include "epseon/enums.hpp"
+#include "epseon/morse_evaluator.hpp"
+#include "epseon/potential_file.hpp"
+#include "fmt/format.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace epseon::cpp {
+
+    /* Read-only view of potential curves stored contiguously, pointCount values each and
+     * rowStride values apart, values between rows are padding. It doesn't own curves,
+     * whoever created it keeps them alive. */
+    template <typename FP>
+    class PotentialView {
+      private: /* Private members. */
+        const FP* data           = nullptr;
+        size_t    potentialCount = {};
+        size_t    pointCount     = {};
+        size_t    rowStride      = {};
+
+      public: /* Public constructors. */
+        // Member-wise constructor.
+        PotentialView(
+            const FP* data_, size_t potentialCount_, size_t pointCount_, size_t rowStride_
+        ) :
+            data(data_),
+            potentialCount(potentialCount_),
+            pointCount(pointCount_),
+            rowStride(rowStride_) {}
+
+        // Default constructor.
+        PotentialView() = default;
+
+      public: /* Public methods. */
+        [[nodiscard]] size_t size() const {
+            return this->potentialCount;
+        }
+
+        [[nodiscard]] bool empty() const {
+            return this->potentialCount == 0;
+        }
+
+        [[nodiscard]] std::span<const FP> operator[](size_t index) const {
+            return {this->data + index * this->rowStride, this->pointCount};
+        }
+
+        [[nodiscard]] const FP* getData() const {
+            return this->data;
+        }
+
+        [[nodiscard]] size_t getPointCount() const {
+            return this->pointCount;
+        }
+
+        [[nodiscard]] size_t getRowStride() const {
+            return this->rowStride;
+        }
+
+        /* View of count curves starting at first. */
+        [[nodiscard]] PotentialView<FP> subview(size_t first, size_t count) const {
+            return {this->data + first * this->rowStride, count, this->pointCount, this->rowStride};
+        }
+    };
+
+    /* Writable counterpart of PotentialView, memory sources write their curves to. */
+    template <typename FP>
+    class PotentialSpan {
+      private: /* Private members. */
+        FP*    data           = nullptr;
+        size_t potentialCount = {};
+        size_t pointCount     = {};
+        size_t rowStride      = {};
+
+      public: /* Public constructors. */
+        // Member-wise constructor.
+        PotentialSpan(FP* data_, size_t potentialCount_, size_t pointCount_, size_t rowStride_) :
+            data(data_),
+            potentialCount(potentialCount_),
+            pointCount(pointCount_),
+            rowStride(rowStride_) {}
+
+      public: /* Public methods. */
+        [[nodiscard]] size_t size() const {
+            return this->potentialCount;
+        }
+
+        [[nodiscard]] std::span<FP> operator[](size_t index) const {
+            return {this->data + index * this->rowStride, this->pointCount};
+        }
+
+        [[nodiscard]] FP* getData() const {
+            return this->data;
+        }
+
+        [[nodiscard]] size_t getPointCount() const {
+            return this->pointCount;
+        }
+
+        [[nodiscard]] size_t getRowStride() const {
+            return this->rowStride;
+        }
+
+        operator PotentialView<FP>() const { // NOLINT(hicpp-explicit-conversions)
+            return {this->data, this->potentialCount, this->pointCount, this->rowStride};
+        }
+    };
+
+    template <typename FP>
+    class PotentialSource : public std::enable_shared_from_this<PotentialSource<FP>> {
+        static_assert(std::is_floating_point<FP>::value, "FP must be an floating-point type.");
+
+      public: /* Public constructors. */
+        // Default constructor.
+        PotentialSource() noexcept = default;
+
+        // Copy constructor.
+        PotentialSource(const PotentialSource&) noexcept = default;
+
+        // Copy assignment operator.
+        PotentialSource& operator=(const PotentialSource&) noexcept = default;
+
+        // Move constructor.
+        PotentialSource(PotentialSource&&) noexcept = default;
+
+        // Move assignment operator.
+        PotentialSource& operator=(PotentialSource&&) noexcept = default;
+
+      public: /* Public destructor. */
+        // Virtual destructor.
+        virtual ~PotentialSource() = default;
+
+      public: /* Public methods. */
+        virtual bool equals(const PotentialSource<FP>& other) const                     = 0;
+        [[nodiscard]] virtual std::shared_ptr<PotentialSource<FP>> shared_clone() const = 0;
+        [[nodiscard]] virtual std::unique_ptr<PotentialSource<FP>> unique_clone() const = 0;
+
+        /* Number of potential curves. */
+        virtual size_t get_potential_count() const = 0;
+
+        /* Number of points of each curve, all curves of source have the same. */
+        [[nodiscard]] virtual size_t get_point_count() const = 0;
+
+        /* Write curves to output of get_potential_count() rows of get_point_count()
+         * values, padding between rows is left alone. */
+        virtual void fill_potentials(const PotentialSpan<FP>& output) const = 0;
+
+        /* Curves in single block of memory, filled in place by fill_potentials(), every
+         * row starts aligned to potentialMemoryAlignment and is padded with zeros. Sources
+         * which keep curves in contiguous memory already return it without copying.
+         * Buffer stays valid when source is gone. */
+        [[nodiscard]] virtual std::shared_ptr<PotentialBuffer<FP>> get_potential_buffer() const {
+            return makePotentialBuffer(
+                this->get_potential_count(),
+                this->get_point_count(),
+                [this](const PotentialSpan<FP>& output) { this->fill_potentials(output); }
+            );
+        }
+
+        /* Copy of curves as separate vectors, for callers which need them so. */
+        [[nodiscard]] std::vector<std::vector<FP>> get_potential_data() const {
+            const auto                   buffer = this->get_potential_buffer();
+            const auto                   view   = buffer->getView();
+            std::vector<std::vector<FP>> curves{};
+            curves.reserve(view.size());
+            for (size_t i = 0; i < view.size(); i++) {
+                curves.emplace_back(view[i].begin(), view[i].end());
+            }
+            return curves;
+        }
+
+      protected: /* Protected methods. */
+        /* Buffer of potentialCount aligned rows of pointCount values written by fill,
+         * padding of rows is zeroed afterwards. */
+        template <typename Fill>
+        static std::shared_ptr<PotentialBuffer<FP>>
+        makePotentialBuffer(size_t potentialCount, size_t pointCount, const Fill& fill) {
+            const size_t rowStride = getAlignedRowStride<FP>(pointCount);
+            auto         memory    = allocatePotentialMemory<FP>(potentialCount * rowStride);
+
+            const PotentialSpan<FP> output{memory.get(), potentialCount, pointCount, rowStride};
+            fill(output);
+            for (size_t i = 0; i < potentialCount && rowStride != pointCount; i++) {
+                std::fill_n(output[i].data() + pointCount, rowStride - pointCount, FP{0});
+            }
+            return std::make_shared<PotentialBuffer<FP>>(
+                std::move(memory), potentialCount, pointCount, rowStride
+            );
+        }
+    };
+
+    template <typename FP>
+    class PotentialFileLoader : public PotentialSource<FP> {
+      private:
+        std::vector<std::string> file_names = {};
+
+      public: /* Public constructors. */
+        // File paths constructor.
+        PotentialFileLoader( // NOLINT(hicpp-explicit-conversions)
+            const std::span<const std::string> file_names
+        ) :
+            file_names([file_names]() {
+                std::vector<std::string> local_file_names(file_names.size());
+                for (uint64_t i = 0; i < file_names.size(); i++) {
+                    local_file_names[i] = file_names[i];
+                }
+                return std::move(local_file_names);
+            }()) {}
+
+        // Default constructor.
+        PotentialFileLoader() noexcept = default;
+
+        // Copy constructor.
+        PotentialFileLoader(const PotentialFileLoader&) noexcept = default;
+
+        // Copy assignment operator.
+        PotentialFileLoader& operator=(const PotentialFileLoader&) noexcept = default;
+
+        // Move constructor.
+        PotentialFileLoader(PotentialFileLoader&&) noexcept = default;
+
+        // Move assignment operator.
+        PotentialFileLoader& operator=(PotentialFileLoader&&) noexcept = default;
+
+      public: /* Public destructor. */
+        // Virtual destructor.
+        virtual ~PotentialFileLoader() = default;
+
+      public: /* Public methods. */
+        bool equals(const PotentialSource<FP>& other) const override {
+            const auto* otherCasted = dynamic_cast<const PotentialFileLoader<FP>*>(&other);
+            if (otherCasted) {
+                return this->file_names == otherCasted->file_names;
+            }
+            return false;
+        }
+
+        /* Sum of curve counts from headers, curves themselves are not read. Text potential
+         * files hold one curve each. */
+        size_t get_potential_count() const override {
+            size_t count = 0;
+            for (const auto& file_name : this->file_names) {
+                const MappedFile file{file_name};
+                count += isPotentialFile(file) ? readPotentialFileInfo(file).curveCount : 1;
+            }
+            return count;
+        }
+
+        size_t get_point_count() const override {
+            return this->loadFiles().pointCount;
+        }
+
+        void fill_potentials(const PotentialSpan<FP>& output) const override {
+            this->readFiles(this->loadFiles(), output);
+        }
+
+        /* Curves of all files, in order of files. Curves of single binary file of
+         * precision matching FP are used straight from its mapping, pages are read from
+         * page cache when curves are staged for upload. Curves of multiple files, of other
+         * precision or of text files are copied into one block of memory, text files are
+         * parsed in parallel straight into it. */
+        [[nodiscard]] std::shared_ptr<PotentialBuffer<FP>> get_potential_buffer() const override {
+            const auto loaded = this->loadFiles();
+            if (loaded.files.empty()) {
+                return std::make_shared<PotentialBuffer<FP>>();
+            }
+            if (loaded.files.size() == 1 && !loaded.layouts.front() &&
+                loaded.infos.front().precision == getPrecisionType<FP>()) {
+                const auto matrix = getCurveMatrix<FP>(*loaded.files.front(), loaded.infos.front());
+                return std::make_shared<PotentialBuffer<FP>>(
+                    std::shared_ptr<const FP>(loaded.files.front(), matrix.data()),
+                    loaded.curveCount,
+                    loaded.pointCount
+                );
+            }
+            return PotentialSource<FP>::makePotentialBuffer(
+                loaded.curveCount,
+                loaded.pointCount,
+                [&loaded](const PotentialSpan<FP>& output) { readFiles(loaded, output); }
+            );
+        }
+
+        std::shared_ptr<PotentialSource<FP>> shared_clone() const override {
+            return std::make_shared<PotentialFileLoader<FP>>(*this);
+        }
+
+        std::unique_ptr<PotentialSource<FP>> unique_clone() const override {
+            return std::make_unique<PotentialFileLoader<FP>>(*this);
+        }
+
+      private: /* Private methods. */
+        /* Mapped files with validated headers, text files are scanned but not parsed. */
+        struct LoadedFiles {
+            std::vector<std::shared_ptr<const MappedFile>>  files      = {};
+            std::vector<PotentialFileInfo>                  infos      = {};
+            // Present for text files only.
+            std::vector<std::optional<PotentialTextLayout>> layouts    = {};
+            size_t                                          curveCount = {};
+            size_t                                          pointCount = {};
+        };
+
+        [[nodiscard]] LoadedFiles loadFiles() const {
+            LoadedFiles loaded{};
+            loaded.files.reserve(this->file_names.size());
+            loaded.infos.reserve(this->file_names.size());
+            loaded.layouts.reserve(this->file_names.size());
+
+            for (const auto& file_name : this->file_names) {
+                const auto& file = loaded.files.emplace_back(
+                    std::make_shared<const MappedFile>(file_name)
+                );
+                if (isPotentialFile(*file)) {
+                    loaded.infos.push_back(readPotentialFileInfo(*file));
+                    loaded.layouts.emplace_back();
+                } else {
+                    loaded.layouts.emplace_back(scanPotentialTextFile(*file));
+                    loaded.infos.push_back(loaded.layouts.back()->info);
+                }
+                // Curves of all files are stored together, so they must share grid.
+                const auto& info = loaded.infos.back();
+                if (info.pointCount != loaded.infos.front().pointCount ||
+                    info.rMin != loaded.infos.front().rMin ||
+                    info.rMax != loaded.infos.front().rMax) {
+                    throw std::runtime_error(fmt::format(
+                        "Potential file {} has different grid than {}.",
+                        file_name,
+                        this->file_names.front()
+                    ));
+                }
+                loaded.curveCount += info.curveCount;
+            }
+            loaded.pointCount = loaded.infos.empty() ? 0 : loaded.infos.front().pointCount;
+            return loaded;
+        }
+
+        static void readFiles(const LoadedFiles& loaded, const PotentialSpan<FP>& output) {
+            // Text files are parsed together, so that their chunks are spread over threads.
+            std::vector<PotentialTextSpec<FP>> texts{};
+            size_t                             row = 0;
+            for (size_t i = 0; i < loaded.files.size(); i++) {
+                if (loaded.layouts[i]) {
+                    texts.push_back({
+                        .file   = loaded.files[i].get(),
+                        .layout = &*loaded.layouts[i],
+                        .output = output[row].data()
+                    });
+                } else {
+                    readCurveMatrix<FP>(
+                        *loaded.files[i],
+                        loaded.infos[i],
+                        output[row].data(),
+                        output.getRowStride()
+                    );
+                }
+                row += loaded.infos[i].curveCount;
+            }
+            parsePotentialTextFiles<FP>(texts, 0);
+        }
+    };
+
+    template <typename FP>
+    class MorsePotentialConfig {
+        static_assert(std::is_floating_point<FP>::value, "FP must be an floating-point type.");
+
+      private:
+        FP       dissociation_energy       = {};
+        FP       equilibrium_bond_distance = {};
+        FP       well_width                = {};
+        FP       min_r                     = {};
+        FP       max_r                     = {};
+        uint32_t point_count               = {};
+
+      public: /* Public constructors. */
+        // Member-wise constructor.
+        MorsePotentialConfig(
+            FP       dissociation_energy_,
+            FP       equilibrium_bond_distance_,
+            FP       well_width_,
+            FP       min_r_,
+            FP       max_r_,
+            uint32_t point_count_
+        ) :
+            dissociation_energy(dissociation_energy_),
+            equilibrium_bond_distance(equilibrium_bond_distance_),
+            well_width(well_width_),
+            min_r(min_r_),
+            max_r(max_r_),
+            point_count(point_count_) {}
+
+        // Default constructor.
+        MorsePotentialConfig() = default;
+
+        // Copy constructor.
+        MorsePotentialConfig(const MorsePotentialConfig&) = default;
+
+        // Copy assignment operator.
+        MorsePotentialConfig& operator=(const MorsePotentialConfig&) = default;
+
+        // Move constructor.
+        MorsePotentialConfig(MorsePotentialConfig&&) noexcept = default;
+
+        // Move assignment operator.
+        MorsePotentialConfig& operator=(MorsePotentialConfig&&) noexcept = default;
+
+      public: /* Public destructor. */
+        // Virtual destructor.
+        virtual ~MorsePotentialConfig() = default;
+
+      public: /* Public methods. */
+        bool operator==(const MorsePotentialConfig<FP>& other) const {
+            return (
+                (this->dissociation_energy == other.dissociation_energy) &&
+                (this->equilibrium_bond_distance == other.equilibrium_bond_distance) &&
+                (this->well_width == other.well_width) && (this->min_r == other.min_r) &&
+                (this->max_r == other.max_r) && (this->point_count == other.point_count)
+            );
+        }
+
+        FP getDissociationEnergy() const {
+            return this->dissociation_energy;
+        }
+
+        FP getEquilibriumBondDistance() const {
+            return this->equilibrium_bond_distance;
+        }
+
+        FP getWellWidth() const {
+            return this->well_width;
+        }
+
+        FP getMinR() const {
+            return this->min_r;
+        }
+
+        FP getMaxR() const {
+            return this->max_r;
+        }
+
+        [[nodiscard]] uint32_t getPointCount() const {
+            return this->point_count;
+        }
+
+        /* Evaluate V(r) = De (1 - exp(-a (r - re)))^2 on uniform grid spanning from min_r
+         * to max_r (inclusive). */
+        [[nodiscard]] std::vector<FP> getPotentialCurve() const {
+            std::vector<FP>          curve(this->point_count);
+            const MorseCurveSpec<FP> spec = this->getCurveSpec(curve.data());
+            evaluateMorseCurves<FP>({&spec, 1}, 1);
+            return curve;
+        }
+
+        /* Description of curve for evaluateMorseCurves(), values are written to output
+         * and followed by paddingCount zeros. */
+        [[nodiscard]] MorseCurveSpec<FP> getCurveSpec(FP* output, uint32_t paddingCount = 0) const {
+            const FP step =
+                this->point_count > 1 ? (this->max_r - this->min_r) / (this->point_count - 1) : 0;
+
+            return MorseCurveSpec<FP>{
+                .dissociationEnergy      = this->dissociation_energy,
+                .equilibriumBondDistance = this->equilibrium_bond_distance,
+                .wellWidth               = this->well_width,
+                .minR                    = this->min_r,
+                .step                    = step,
+                .pointCount              = this->point_count,
+                .paddingCount            = paddingCount,
+                .output                  = output
+            };
+        }
+    };
+
+    template <typename FP>
+    class MorsePotentialGenerator : public PotentialSource<FP> {
+      public:
+        std::vector<MorsePotentialConfig<FP>> configurations = {};
+
+      public: /* Public constructors. */
+        // Member-wise constructor.
+        explicit MorsePotentialGenerator(std::vector<MorsePotentialConfig<FP>>&& configurations_) :
+            configurations(configurations_) {}
+
+        // Default constructor.
+        MorsePotentialGenerator() = default;
+
+        // Copy constructor.
+        MorsePotentialGenerator(const MorsePotentialGenerator&) = default;
+
+        // Copy assignment operator.
+        MorsePotentialGenerator& operator=(const MorsePotentialGenerator&) = default;
+
+        // Move constructor.
+        MorsePotentialGenerator(MorsePotentialGenerator&&) noexcept = default;
+
+        // Move assignment operator.
+        MorsePotentialGenerator& operator=(MorsePotentialGenerator&&) noexcept = default;
+
+      public: /* Public destructor. */
+        // Virtual destructor.
+        virtual ~MorsePotentialGenerator() = default;
+
+      public: /* Public methods. */
+        bool equals(const PotentialSource<FP>& other) const override {
+            const auto* otherCasted = dynamic_cast<const MorsePotentialGenerator<FP>*>(&other);
+            if (otherCasted) {
+                return this->configurations == otherCasted->configurations;
+            }
+            return false;
+        }
+
+        size_t get_potential_count() const override {
+            return this->configurations.size();
+        }
+
+        /* Common point count of configurations, raises std::runtime_error if they differ. */
+        size_t get_point_count() const override {
+            if (!this->hasUniformPointCount()) {
+                throw std::runtime_error(
+                    "All Morse potentials stored in one buffer must have same point count."
+                );
+            }
+            return this->configurations.empty() ? 0
+                                                : this->configurations.front().getPointCount();
+        }
+
+        /* Curves are evaluated in parallel on all hardware threads. */
+        void fill_potentials(const PotentialSpan<FP>& output) const override {
+            this->fillPotentials(output, 0);
+        }
+
+        /* All configurations have the same point count, as required for curves stored in
+         * one buffer. */
+        [[nodiscard]] bool hasUniformPointCount() const {
+            return std::ranges::all_of(this->configurations, [this](const auto& configuration) {
+                return configuration.getPointCount() ==
+                       this->configurations.front().getPointCount();
+            });
+        }
+
+        /* get_potential_buffer() with curves evaluated on threadCount threads (hardware
+         * concurrency if 0). */
+        [[nodiscard]] std::shared_ptr<PotentialBuffer<FP>>
+        generatePotentialBuffer(uint32_t threadCount = 0) const {
+            return PotentialSource<FP>::makePotentialBuffer(
+                this->get_potential_count(),
+                this->get_point_count(),
+                [this, threadCount](const PotentialSpan<FP>& output) {
+                    this->fillPotentials(output, threadCount);
+                }
+            );
+        }
+
+        std::shared_ptr<PotentialSource<FP>> shared_clone() const override {
+            return std::make_shared<MorsePotentialGenerator<FP>>(*this);
+        }
+
+        std::unique_ptr<PotentialSource<FP>> unique_clone() const override {
+            return std::make_unique<MorsePotentialGenerator<FP>>(*this);
+        }
+
+      private: /* Private methods. */
+        void fillPotentials(const PotentialSpan<FP>& output, uint32_t threadCount) const {
+            std::vector<MorseCurveSpec<FP>> specs{};
+            specs.reserve(this->configurations.size());
+            for (size_t i = 0; i < this->configurations.size(); i++) {
+                specs.push_back(this->configurations[i].getCurveSpec(output[i].data()));
+            }
+            evaluateMorseCurves<FP>(specs, threadCount);
+        }
+    };
+
+    /* Potential curves in contiguous row-major memory owned by someone else, e.g. NumPy
+     * array, uploaded to device straight from that memory. Curves must not be modified
+     * while tasks using them run. */
+    template <typename FP>
+    class PotentialBuffer : public PotentialSource<FP> {
+      private:
+        // Points into memory kept alive by its deleter, shared by copies and slices.
+        std::shared_ptr<const FP> data            = {};
+        size_t                    potential_count = {};
+        size_t                    point_count     = {};
+        size_t                    row_stride      = {};
+
+      public: /* Public constructors. */
+        // Member-wise constructor, row_stride is distance between starts of consecutive
+        // curves in values.
+        PotentialBuffer(
+            std::shared_ptr<const FP> data_,
+            size_t                    potential_count_,
+            size_t                    point_count_,
+            size_t                    row_stride_
+        ) :
+            data(std::move(data_)),
+            potential_count(potential_count_),
+            point_count(point_count_),
+            row_stride(row_stride_) {
+            if (this->row_stride < this->point_count) {
+                throw std::runtime_error(fmt::format(
+                    "Potential row stride {} is smaller than point count {}.",
+                    this->row_stride,
+                    this->point_count
+                ));
+            }
+            if (!this->data && this->potential_count != 0) {
+                throw std::runtime_error("Potential buffer without data can't hold curves.");
+            }
+        }
+
+        // Densely packed curves constructor.
+        PotentialBuffer(
+            std::shared_ptr<const FP> data_, size_t potential_count_, size_t point_count_
+        ) :
+            PotentialBuffer(std::move(data_), potential_count_, point_count_, point_count_) {}
+
+        // Default constructor.
+        PotentialBuffer() = default;
+
+        // Copy constructor, memory is shared between copies.
+        PotentialBuffer(const PotentialBuffer&) = default;
+
+        // Copy assignment operator.
+        PotentialBuffer& operator=(const PotentialBuffer&) = default;
+
+        // Move constructor.
+        PotentialBuffer(PotentialBuffer&&) noexcept = default;
+
+        // Move assignment operator.
+        PotentialBuffer& operator=(PotentialBuffer&&) noexcept = default;
+
+      public: /* Public destructor. */
+        // Virtual destructor.
+        virtual ~PotentialBuffer() = default;
+
+      public: /* Public methods. */
+        bool equals(const PotentialSource<FP>& other) const override {
+            const auto* otherCasted = dynamic_cast<const PotentialBuffer<FP>*>(&other);
+            if (!otherCasted || this->potential_count != otherCasted->potential_count ||
+                this->point_count != otherCasted->point_count) {
+                return false;
+            }
+            const auto view      = this->getView();
+            const auto otherView = otherCasted->getView();
+            for (size_t i = 0; i < this->potential_count; i++) {
+                if (!std::ranges::equal(view[i], otherView[i])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        size_t get_potential_count() const override {
+            return this->potential_count;
+        }
+
+        size_t get_point_count() const override {
+            return this->point_count;
+        }
+
+        void fill_potentials(const PotentialSpan<FP>& output) const override {
+            const auto view = this->getView();
+            for (size_t i = 0; i < this->potential_count; i++) {
+                std::ranges::copy(view[i], output[i].begin());
+            }
+        }
+
+        /* Copy of this source, sharing its memory. */
+        [[nodiscard]] std::shared_ptr<PotentialBuffer<FP>> get_potential_buffer() const override {
+            return std::make_shared<PotentialBuffer<FP>>(*this);
+        }
+
+        [[nodiscard]] PotentialView<FP> getView() const {
+            return {this->data.get(), this->potential_count, this->point_count, this->row_stride};
+        }
+
+        /* Source of count curves starting at first, sharing memory with this one. */
+        [[nodiscard]] std::shared_ptr<PotentialBuffer<FP>> slice(size_t first, size_t count) const {
+            if (first + count > this->potential_count) {
+                throw std::runtime_error(fmt::format(
+                    "Slice of potentials [{}, {}) exceeds potential count {}.",
+                    first,
+                    first + count,
+                    this->potential_count
+                ));
+            }
+            return std::make_shared<PotentialBuffer<FP>>(
+                std::shared_ptr<const FP>(this->data, this->data.get() + first * this->row_stride),
+                count,
+                this->point_count,
+                this->row_stride
+            );
+        }
+
+        std::shared_ptr<PotentialSource<FP>> shared_clone() const override {
+            return std::make_shared<PotentialBuffer<FP>>(*this);
+        }
+
+        std::unique_ptr<PotentialSource<FP>> unique_clone() const override {
+            return std::make_unique<PotentialBuffer<FP>>(*this);
+        }
+    };
+
+    template <typename FP>
+    bool operator==(const PotentialSource<FP>& lhs, const PotentialSource<FP>& rhs) {
+        return lhs.equals(rhs);
+    }
+
+    template <typename FP>
+    bool operator==(const PotentialFileLoader<FP>& lhs, const PotentialFileLoader<FP>& rhs) {
+        return lhs.equals(rhs);
+    }
+
+    template <typename FP>
+    bool
+    operator==(const MorsePotentialGenerator<FP>& lhs, const MorsePotentialGenerator<FP>& rhs) {
+        return lhs.equals(rhs);
+    }
+
+} // namespace epseon::cpp
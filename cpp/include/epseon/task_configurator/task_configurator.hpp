@@ -0,0 +1,168 @@
+
+#pragma once
+
+#include "epseon/predecl.hpp"
+
+#include "epseon/enums.hpp"
+#include "epseon/task_configurator/algorithm_config.hpp"
+#include "epseon/task_configurator/hardware_config.hpp"
+#include "epseon/task_configurator/potential_source.hpp"
+#include "fmt/format.h"
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+namespace epseon::cpp {
+
+    /* Builder for configuring compute task, used by GPU and CPU backends. */
+    template <typename FP>
+    class TaskConfigurator : public std::enable_shared_from_this<TaskConfigurator<FP>> {
+        static_assert(std::is_floating_point<FP>::value, "FP must be an floating-point type.");
+
+      private:
+        std::shared_ptr<HardwareConfig<FP>>  hardware_config   = {};
+        std::shared_ptr<PotentialSource<FP>> potential_source  = {};
+        std::shared_ptr<AlgorithmConfig<FP>> algorithm_config  = {};
+        // Precision of potentials in GPU buffers, computation is always done in FP.
+        PrecisionType                        storage_precision = getPrecisionType<FP>();
+
+      public: /* Public constructors. */
+        // Parametrized constructor
+        TaskConfigurator(
+            std::shared_ptr<HardwareConfig<FP>>  hardware_config_,
+            std::shared_ptr<PotentialSource<FP>> potential_source_,
+            std::shared_ptr<AlgorithmConfig<FP>> algorithm_config_
+
+        ) :
+            hardware_config(hardware_config_),
+            potential_source(potential_source_),
+            algorithm_config(algorithm_config_){};
+
+        // Default constructor
+        TaskConfigurator() = default;
+        // Move constructor
+        TaskConfigurator(TaskConfigurator&& other) noexcept :
+            hardware_config(std::move(other.hardware_config)),
+            potential_source(std::move(other.potential_source)),
+            algorithm_config(std::move(other.algorithm_config)),
+            storage_precision(other.storage_precision){};
+
+        // Move assignment operator
+        TaskConfigurator& operator=(TaskConfigurator&& other) noexcept {
+            if (this != &other) {
+                hardware_config   = std::move(other.hardware_config);
+                potential_source  = std::move(other.potential_source);
+                algorithm_config  = std::move(other.algorithm_config);
+                storage_precision = other.storage_precision;
+            }
+            return *this;
+        };
+
+        // Copy constructor (deleted)
+        TaskConfigurator(const TaskConfigurator& other) :
+            hardware_config(
+                other.hardware_config ? std::move(other.hardware_config->shared_clone()) : nullptr
+            ),
+            potential_source(
+                other.potential_source ? std::move(other.potential_source->shared_clone()) : nullptr
+            ),
+            algorithm_config(
+                other.algorithm_config ? std::move(other.algorithm_config->shared_clone()) : nullptr
+            ),
+            storage_precision(other.storage_precision) {}
+
+        // Copy assignment operator
+        TaskConfigurator& operator=(const TaskConfigurator& other) {
+            if (this != &other) {
+                hardware_config   = other.hardware_config
+                                      ? std::move(other.hardware_config->shared_clone())
+                                      : nullptr;
+                potential_source  = other.potential_source
+                                      ? std::move(other.potential_source->shared_clone())
+                                      : nullptr;
+                algorithm_config  = other.algorithm_config
+                                      ? std::move(other.algorithm_config->shared_clone())
+                                      : nullptr;
+                storage_precision = other.storage_precision;
+            }
+            return *this;
+        }
+
+      public: /* Public destructor. */
+        ~TaskConfigurator() = default;
+
+      public: /* Public methods. */
+        /* Set hardware configuration for a compute task. */
+        TaskConfigurator& setHardwareConfig(std::shared_ptr<HardwareConfig<FP>> cfg) {
+            this->hardware_config = cfg->shared_clone();
+            return *this;
+        };
+
+        /* Get hardware configuration for a compute task. */
+        [[nodiscard]] std::shared_ptr<HardwareConfig<FP>> getHardwareConfig() const {
+            return this->hardware_config;
+        };
+
+        /* Set potential data source configuration for compute task. */
+        TaskConfigurator& setPotentialSource(std::shared_ptr<PotentialSource<FP>> ps) {
+            this->potential_source = ps->shared_clone();
+            return *this;
+        };
+
+        /* Get potential data source configuration for compute task. */
+        [[nodiscard]] std::shared_ptr<PotentialSource<FP>> getPotentialSource() const {
+            return this->potential_source;
+        };
+
+        /* Set algorithm configuration for a compute task. */
+        TaskConfigurator& setAlgorithmConfig(std::shared_ptr<AlgorithmConfig<FP>> ac) {
+            this->algorithm_config = ac->shared_clone();
+            return *this;
+        };
+
+        /* Get algorithm configuration for a compute task. */
+        [[nodiscard]] std::shared_ptr<AlgorithmConfig<FP>> getAlgorithmConfig() const {
+            return this->algorithm_config;
+        };
+
+        /* Set precision of potentials stored in GPU buffers. Float16 halves memory
+         * traffic and buffer sizes of Float32 tasks at the cost of roughly 1e-3 relative
+         * accuracy of level energies. Float64Emulated forces double-float arithmetic on
+         * Float64 tasks, it is also selected automatically on devices without
+         * shaderFloat64. Other precisions must match FP. CPU backend supports only
+         * storage matching FP. */
+        TaskConfigurator& setStoragePrecision(PrecisionType precision) {
+            const bool halfStorage = precision == PrecisionType::Float16 &&
+                                     getPrecisionType<FP>() == PrecisionType::Float32;
+            const bool emulated    = precision == PrecisionType::Float64Emulated &&
+                                     getPrecisionType<FP>() == PrecisionType::Float64;
+            if (precision != getPrecisionType<FP>() && !halfStorage && !emulated) {
+                throw std::runtime_error(fmt::format(
+                    "{} storage can't be used by {} task.",
+                    toString(precision),
+                    toString(getPrecisionType<FP>())
+                ));
+            }
+            this->storage_precision = precision;
+            return *this;
+        };
+
+        /* Get precision of potentials stored in GPU buffers. */
+        [[nodiscard]] PrecisionType getStoragePrecision() const {
+            return this->storage_precision;
+        };
+
+        /* Check if this instance is fully configured, i.e. it has been assigned
+         * a valid hardware configuration, potential source and algorithm
+         * config.
+         */
+        [[nodiscard]] bool isConfigured() const {
+            return static_cast<bool>(this->hardware_config) &&
+                   static_cast<bool>(this->potential_source) &&
+                   static_cast<bool>(this->algorithm_config);
+        };
+    };
+
+    template class TaskConfigurator<float>;
+    template class TaskConfigurator<double>;
+} // namespace epseon::cpp
@@ -0,0 +1,96 @@
+#include "epseon/enums.hpp"
+#include "fmt/format.h"
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace epseon {
+    namespace cpp {
+
+        InvalidPrecisionTypeString::InvalidPrecisionTypeString(std::string_view sv) :
+            message(fmt::format("Invalid PrecisionType literal in string: \"{}\"", sv)) {}
+
+        const char* InvalidPrecisionTypeString::what() const noexcept {
+            return this->message.c_str();
+        };
+
+        std::string toString(PrecisionType prec) {
+
+            PrecisionTypeAssertValueCount(4);
+            switch (prec) {
+                using enum PrecisionType;
+                case Float32:
+                    return "Float32";
+                case Float64:
+                    return "Float64";
+                case Float16:
+                    return "Float16";
+                case Float64Emulated:
+                    return "Float64Emulated";
+                default:
+                    throw std::runtime_error("Unreachable");
+            }
+        }
+
+        PrecisionType toPrecisionType(std::string_view precision) {
+            std::string precision_lower_case(precision.begin(), precision.end());
+            std::transform(
+                precision.begin(),
+                precision.end(),
+                precision_lower_case.begin(),
+                [](unsigned char c) {
+                    return std::tolower(c);
+                }
+            );
+
+            PrecisionTypeAssertValueCount(4);
+            if (precision_lower_case == "float32") {
+                return PrecisionType::Float32;
+            } else if (precision_lower_case == "float64") {
+                return PrecisionType::Float64;
+            } else if (precision_lower_case == "float16") {
+                return PrecisionType::Float16;
+            } else if (precision_lower_case == "float64-emulated" ||
+                       precision_lower_case == "float64emulated") {
+                return PrecisionType::Float64Emulated;
+            } else {
+                throw InvalidPrecisionTypeString(precision_lower_case);
+            }
+        }
+
+        size_t getSizeBytes(PrecisionType prec) {
+
+            PrecisionTypeAssertValueCount(4);
+            switch (prec) {
+                using enum PrecisionType;
+                case Float32:
+                    return sizeof(float);
+                case Float64:
+                    return sizeof(double);
+                case Float16:
+                    return sizeof(uint16_t);
+                case Float64Emulated:
+                    return 2 * sizeof(float);
+                default:
+                    throw std::runtime_error("Unreachable");
+            }
+        }
+
+        template <>
+        PrecisionType getPrecisionType<float>() {
+            PrecisionTypeAssertValueCount(4);
+            return PrecisionType::Float32;
+        }
+
+        template <>
+        PrecisionType getPrecisionType<double>() {
+            PrecisionTypeAssertValueCount(4);
+            return PrecisionType::Float64;
+        }
+    } // namespace cpp
+} // namespace epseon
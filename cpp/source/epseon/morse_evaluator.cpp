@@ -0,0 +1,250 @@
+#include "epseon/morse_evaluator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Functions evaluating blocks of lanes are cloned for wider instruction sets and loader
+// picks clone supported by host CPU. Elsewhere compiler vectorizes them only for baseline
+// instruction set of target.
+#if defined(__linux__) && (defined(__x86_64__) || defined(__i386__)) && defined(__has_attribute)
+    #if __has_attribute(target_clones)
+        #define EPSEON_SIMD_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+    #endif
+#endif
+#ifndef EPSEON_SIMD_CLONES
+    #define EPSEON_SIMD_CLONES
+#endif
+
+namespace epseon::cpp {
+
+    namespace {
+        // Values evaluated together, as many as fit into widest SIMD register.
+        template <typename FP>
+        constexpr uint32_t laneCount = potentialMemoryAlignment / sizeof(FP);
+
+        // Curves are not split between threads, threads which would get fewer points than
+        // this cost more to start than they save.
+        constexpr size_t minPointsPerThread = size_t{1} << 16;
+
+        template <typename FP>
+        struct ExpConstants;
+
+        template <>
+        struct ExpConstants<float> {
+            using Bits = uint32_t;
+
+            static constexpr int32_t mantissaBits = 23;
+            static constexpr int32_t exponentBias = 127;
+            // Arguments are clamped, so that halves of 2^k are normal numbers, results
+            // still underflow to 0 and overflow to infinity.
+            static constexpr float   minArgument  = -104.0F;
+            static constexpr float   maxArgument  = 89.0F;
+            // 1.5 * 2^23, adding and subtracting it rounds to nearest integer.
+            static constexpr float   shifter      = 12582912.0F;
+            static constexpr float   log2e        = 1.44269504088896341F;
+            // ln(2) split into value exactly multiplied by k and remainder.
+            static constexpr float   ln2High      = 0.693359375F;
+            static constexpr float   ln2Low       = -2.12194440e-4F;
+            static constexpr int32_t degree       = 7;
+        };
+
+        template <>
+        struct ExpConstants<double> {
+            using Bits = uint64_t;
+
+            static constexpr int32_t mantissaBits = 52;
+            static constexpr int32_t exponentBias = 1023;
+            static constexpr double  minArgument  = -746.0;
+            static constexpr double  maxArgument  = 710.0;
+            // 1.5 * 2^52.
+            static constexpr double  shifter      = 6755399441055744.0;
+            static constexpr double  log2e        = 1.44269504088896340736;
+            static constexpr double  ln2High      = 6.93147180369123816490e-01;
+            static constexpr double  ln2Low       = 1.90821492927058770002e-10;
+            static constexpr int32_t degree       = 13;
+        };
+
+        /* Taylor series coefficients of exp(r), 1 / n!, truncation error for
+         * |r| <= ln(2) / 2 is below half ulp. */
+        template <typename FP>
+        constexpr auto getExpCoefficients() {
+            std::array<FP, ExpConstants<FP>::degree + 1> coefficients{};
+
+            double factorial = 1.0;
+            for (int32_t n = 0; n <= ExpConstants<FP>::degree; n++) {
+                factorial       *= n == 0 ? 1.0 : static_cast<double>(n);
+                coefficients[n]  = static_cast<FP>(1.0 / factorial);
+            }
+            return coefficients;
+        }
+
+        template <typename FP>
+        constexpr auto expCoefficients = getExpCoefficients<FP>();
+
+        /* Horner scheme written out without loop, loops nested in loops evaluating lanes
+         * prevent their vectorization. */
+        template <typename FP, size_t... index>
+        inline FP evaluateExpPolynomial(FP r, std::index_sequence<index...> /*unused*/) {
+            FP polynomial = 0;
+            ((polynomial = polynomial * r + expCoefficients<FP>[ExpConstants<FP>::degree - index]),
+             ...);
+            return polynomial;
+        }
+
+        // 2^n for n for which result is normal number.
+        template <typename FP>
+        inline FP pow2(int32_t n) {
+            using C = ExpConstants<FP>;
+            return std::bit_cast<FP>(static_cast<typename C::Bits>(n + C::exponentBias)
+                                     << C::mantissaBits);
+        }
+
+        /* exp(value) as exp(r) 2^k, where value = k ln(2) + r. Branch free, so that loops
+         * calling it are vectorized. */
+        template <typename FP>
+        inline FP expLane(FP value) {
+            using C = ExpConstants<FP>;
+
+            FP x = value > C::minArgument ? value : C::minArgument;
+            x    = x < C::maxArgument ? x : C::maxArgument;
+
+            const FP k = (x * C::log2e + C::shifter) - C::shifter;
+            const FP r = (x - k * C::ln2High) - k * C::ln2Low;
+
+            const FP polynomial =
+                evaluateExpPolynomial<FP>(r, std::make_index_sequence<C::degree + 1>{});
+            // 2^k split into two factors, both are normal numbers for whole argument range.
+            const auto    exponent = static_cast<int32_t>(k);
+            const int32_t half     = exponent >> 1;
+            const FP      result   = polynomial * pow2<FP>(half) * pow2<FP>(exponent - half);
+            // NaN was clamped above.
+            return value != value ? value : result; // NOLINT(misc-redundant-expression)
+        }
+
+        /* Evaluate laneCount points of curve starting from first into output. Parameters
+         * are copied to locals, as output could alias curve otherwise. */
+        template <typename FP>
+        inline void evaluateBlock(const MorseCurveSpec<FP>& curve, uint32_t first, FP* output) {
+            const FP firstIndex              = static_cast<FP>(first);
+            const FP minR                    = curve.minR;
+            const FP step                    = curve.step;
+            const FP wellWidth               = curve.wellWidth;
+            const FP equilibriumBondDistance = curve.equilibriumBondDistance;
+            const FP dissociationEnergy      = curve.dissociationEnergy;
+
+            for (uint32_t lane = 0; lane < laneCount<FP>; lane++) {
+                const FP r           = minR + step * (firstIndex + static_cast<FP>(lane));
+                const FP exponential = expLane<FP>(-wellWidth * (r - equilibriumBondDistance));
+                output[lane]         = dissociationEnergy * (1 - exponential) * (1 - exponential);
+            }
+        }
+
+        template <typename FP>
+        EPSEON_SIMD_CLONES void evaluateCurve(const MorseCurveSpec<FP>& curve) {
+            constexpr uint32_t lanes = laneCount<FP>;
+
+            const uint32_t blockCount = curve.pointCount / lanes;
+            for (uint32_t block = 0; block < blockCount; block++) {
+                evaluateBlock(curve, block * lanes, curve.output + block * lanes);
+            }
+            // Last partial block is evaluated into temporary, so that nothing is written
+            // past curve.
+            const uint32_t first = blockCount * lanes;
+            if (first != curve.pointCount) {
+                alignas(potentialMemoryAlignment) std::array<FP, lanes> tail{};
+                evaluateBlock(curve, first, tail.data());
+                std::copy_n(tail.begin(), curve.pointCount - first, curve.output + first);
+            }
+            std::fill_n(curve.output + curve.pointCount, curve.paddingCount, FP{0});
+        }
+
+        template <typename FP>
+        EPSEON_SIMD_CLONES void
+        evaluateExpLanes(std::span<const FP> values, std::span<FP> output) {
+            constexpr uint32_t lanes = laneCount<FP>;
+
+            for (size_t first = 0; first < values.size(); first += lanes) {
+                const size_t count = std::min<size_t>(lanes, values.size() - first);
+
+                alignas(potentialMemoryAlignment) std::array<FP, lanes> block{};
+                std::copy_n(values.begin() + first, count, block.begin());
+                for (uint32_t lane = 0; lane < lanes; lane++) {
+                    block[lane] = expLane<FP>(block[lane]);
+                }
+                std::copy_n(block.begin(), count, output.begin() + first);
+            }
+        }
+
+        template <typename FP>
+        void evaluateCurves(std::span<const MorseCurveSpec<FP>> curves, uint32_t threadCount) {
+            if (curves.empty()) {
+                return;
+            }
+            if (threadCount == 0) {
+                threadCount = std::max(std::thread::hardware_concurrency(), 1U);
+            }
+            size_t pointCount = 0;
+            for (const auto& curve : curves) {
+                pointCount += curve.pointCount;
+            }
+            const size_t usefulThreadCount = std::min<size_t>(
+                {threadCount, curves.size(), (pointCount / minPointsPerThread) + 1}
+            );
+
+            std::atomic<size_t> nextCurve{0};
+            auto                worker = [&]() {
+                for (size_t index = nextCurve.fetch_add(1, std::memory_order_relaxed);
+                     index < curves.size();
+                     index = nextCurve.fetch_add(1, std::memory_order_relaxed)) {
+                    evaluateCurve<FP>(curves[index]);
+                }
+            };
+
+            std::vector<std::jthread> threads{};
+            threads.reserve(usefulThreadCount - 1);
+            try {
+                for (size_t i = 1; i < usefulThreadCount; i++) {
+                    threads.emplace_back(worker);
+                }
+            } catch (const std::system_error&) {
+                // Curves are distributed dynamically, threads which were started evaluate
+                // all of them.
+            }
+            // Calling thread takes part in evaluation too.
+            worker();
+        }
+    } // namespace
+
+    template <>
+    void evaluateMorseCurves<float>(
+        std::span<const MorseCurveSpec<float>> curves, uint32_t threadCount
+    ) {
+        evaluateCurves<float>(curves, threadCount);
+    }
+
+    template <>
+    void evaluateMorseCurves<double>(
+        std::span<const MorseCurveSpec<double>> curves, uint32_t threadCount
+    ) {
+        evaluateCurves<double>(curves, threadCount);
+    }
+
+    template <>
+    void evaluateExp<float>(std::span<const float> values, std::span<float> output) {
+        evaluateExpLanes<float>(values, output.first(values.size()));
+    }
+
+    template <>
+    void evaluateExp<double>(std::span<const double> values, std::span<double> output) {
+        evaluateExpLanes<double>(values, output.first(values.size()));
+    }
+} // namespace epseon::cpp
@@ -0,0 +1,537 @@
+#include "epseon/potential_file.hpp"
+
+#include "epseon/enums.hpp"
+#include "epseon/task_configurator/potential_source.hpp"
+#include "fmt/format.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <limits>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace epseon::cpp {
+
+    namespace {
+        [[noreturn]] void throwMappingError(const std::filesystem::path& path, int error) {
+            throw std::runtime_error(fmt::format(
+                "Failed to map potential file {}: {}",
+                path.string(),
+                std::system_category().message(error)
+            ));
+        }
+
+        void checkByteOrder() {
+            if constexpr (std::endian::native != std::endian::little) {
+                throw std::runtime_error(
+                    "Potential files are supported on little endian hosts only."
+                );
+            }
+        }
+
+        uint32_t getValueBits(PrecisionType precision) {
+            return static_cast<uint32_t>(getSizeBytes(precision) * 8);
+        }
+
+        // Text files are split into chunks of about this many bytes, large enough for
+        // thread to spend most of its time parsing rather than picking up next chunk.
+        constexpr size_t textChunkSize = size_t{1} << 20;
+
+        /* Call task(index) for every index below taskCount on threadCount threads
+         * (hardware concurrency if 0), calling thread included. First exception thrown
+         * by task stops remaining tasks and is rethrown once all threads finish. */
+        template <typename Task>
+        void runTasks(size_t taskCount, uint32_t threadCount, const Task& task) {
+            if (threadCount == 0) {
+                threadCount = std::max(std::thread::hardware_concurrency(), 1U);
+            }
+            std::atomic<size_t> nextTask{0};
+            std::mutex          errorMutex{};
+            std::exception_ptr  error{};
+            auto                worker = [&]() {
+                for (size_t index = nextTask.fetch_add(1, std::memory_order_relaxed);
+                     index < taskCount;
+                     index = nextTask.fetch_add(1, std::memory_order_relaxed)) {
+                    try {
+                        task(index);
+                    } catch (...) {
+                        const std::lock_guard lock{errorMutex};
+                        if (!error) {
+                            error = std::current_exception();
+                        }
+                        nextTask.store(taskCount, std::memory_order_relaxed);
+                    }
+                }
+            };
+            {
+                std::vector<std::jthread> threads{};
+                const size_t usefulThreadCount = std::min<size_t>(threadCount, taskCount);
+                threads.reserve(usefulThreadCount > 0 ? usefulThreadCount - 1 : 0);
+                try {
+                    for (size_t i = 1; i < usefulThreadCount; i++) {
+                        threads.emplace_back(worker);
+                    }
+                } catch (const std::system_error&) {
+                    // Tasks are distributed dynamically, threads which were started run
+                    // all of them.
+                }
+                worker();
+            }
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        bool isBlank(char character) {
+            return character == ' ' || character == '\t' || character == '\r';
+        }
+
+        const char* skipBlanks(const char* first, const char* last) {
+            while (first != last && isBlank(*first)) {
+                first++;
+            }
+            return first;
+        }
+
+        /* Call visit(first, last) with data of every line of [first, last) which is not
+         * blank or comment, line ends are not included. */
+        template <typename Visit>
+        void forEachDataLine(const char* first, const char* last, const Visit& visit) {
+            while (first != last) {
+                const auto* lineEnd = static_cast<const char*>(
+                    std::memchr(first, '\n', static_cast<size_t>(last - first))
+                );
+                if (lineEnd == nullptr) {
+                    lineEnd = last;
+                }
+                const char* data = skipBlanks(first, lineEnd);
+                if (data != lineEnd && *data != '#') {
+                    visit(data, lineEnd);
+                }
+                first = lineEnd == last ? last : lineEnd + 1;
+            }
+        }
+
+        template <typename FP>
+        struct TextPoint {
+            double r     = {};
+            FP     value = {};
+        };
+
+        /* Parse r and V(r) of line, pointIndex is used only in error message. */
+        template <typename FP>
+        TextPoint<FP>
+        parseTextPoint(std::string_view line, const MappedFile& file, size_t pointIndex) {
+            const char*   first = line.data();
+            const char*   last  = line.data() + line.size();
+            TextPoint<FP> point{};
+            auto [next, error] = std::from_chars(first, last, point.r);
+            if (error == std::errc{}) {
+                next = skipBlanks(next, last);
+                if (next != last && *next == ',') {
+                    next = skipBlanks(next + 1, last);
+                }
+                const auto [valueEnd, valueError] = std::from_chars(next, last, point.value);
+                next                              = skipBlanks(valueEnd, last);
+                error                             = valueError;
+            }
+            if (error != std::errc{} || next != last) {
+                throw std::runtime_error(fmt::format(
+                    "Point {} of potential file {} is not a pair of numbers: '{}'.",
+                    pointIndex,
+                    file.getPath().string(),
+                    line
+                ));
+            }
+            return point;
+        }
+
+        template <typename FP>
+        void parseChunk(
+            const PotentialTextSpec<FP>& spec, const PotentialTextChunk& chunk
+        ) {
+            const auto&  info  = spec.layout->info;
+            const auto*  bytes = reinterpret_cast<const char*>(spec.file->getBytes().data());
+            const double step =
+                info.pointCount > 1 ? (info.rMax - info.rMin) / (info.pointCount - 1) : 0.0;
+            const double tolerance = gridTolerance * std::fabs(step);
+
+            size_t index = chunk.firstPoint;
+            forEachDataLine(bytes + chunk.begin, bytes + chunk.end, [&](auto* first, auto* last) {
+                const auto   point    = parseTextPoint<FP>({first, last}, *spec.file, index);
+                const double expected = info.rMin + step * static_cast<double>(index);
+                if (!(std::fabs(point.r - expected) <= tolerance)) {
+                    throw std::runtime_error(fmt::format(
+                        "Point {} of potential file {} has r = {}, but uniform grid from {} "
+                        "to {} has r = {} there.",
+                        index,
+                        spec.file->getPath().string(),
+                        point.r,
+                        info.rMin,
+                        info.rMax,
+                        expected
+                    ));
+                }
+                spec.output[index++] = point.value;
+            });
+        }
+
+        template <typename FP>
+        void parseTextFiles(std::span<const PotentialTextSpec<FP>> files, uint32_t threadCount) {
+            struct Task {
+                const PotentialTextSpec<FP>* spec  = nullptr;
+                const PotentialTextChunk*    chunk = nullptr;
+            };
+            std::vector<Task> tasks{};
+            for (const auto& spec : files) {
+                for (const auto& chunk : spec.layout->chunks) {
+                    tasks.push_back({.spec = &spec, .chunk = &chunk});
+                }
+            }
+            runTasks(tasks.size(), threadCount, [&tasks](size_t index) {
+                parseChunk<FP>(*tasks[index].spec, *tasks[index].chunk);
+            });
+        }
+    } // namespace
+
+#if defined(_WIN32)
+    MappedFile::MappedFile(std::filesystem::path path_) :
+        path(std::move(path_)) {
+        HANDLE file = CreateFileW(
+            this->path.c_str(),
+            GENERIC_READ,
+            FILE_SHARE_READ,
+            nullptr,
+            OPEN_EXISTING,
+            FILE_FLAG_SEQUENTIAL_SCAN,
+            nullptr
+        );
+        if (file == INVALID_HANDLE_VALUE) {
+            throwMappingError(this->path, static_cast<int>(GetLastError()));
+        }
+        LARGE_INTEGER fileSize{};
+        if (!GetFileSizeEx(file, &fileSize)) {
+            const auto error = static_cast<int>(GetLastError());
+            CloseHandle(file);
+            throwMappingError(this->path, error);
+        }
+        this->size = static_cast<size_t>(fileSize.QuadPart);
+        if (this->size == 0) {
+            // Empty files can't be mapped, there is nothing to read anyway.
+            CloseHandle(file);
+            return;
+        }
+        // View keeps mapping alive, both handles can be closed once it is created.
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        const auto error = static_cast<int>(GetLastError());
+        CloseHandle(file);
+        if (mapping == nullptr) {
+            throwMappingError(this->path, error);
+        }
+        this->data = static_cast<const std::byte*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        const auto viewError = static_cast<int>(GetLastError());
+        CloseHandle(mapping);
+        if (this->data == nullptr) {
+            throwMappingError(this->path, viewError);
+        }
+    }
+
+    MappedFile::~MappedFile() {
+        if (this->data != nullptr) {
+            UnmapViewOfFile(this->data);
+        }
+    }
+#else
+    MappedFile::MappedFile(std::filesystem::path path_) :
+        path(std::move(path_)) {
+        const int descriptor = ::open(this->path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (descriptor < 0) {
+            throwMappingError(this->path, errno);
+        }
+        struct stat status {};
+        if (::fstat(descriptor, &status) != 0) {
+            const int error = errno;
+            ::close(descriptor);
+            throwMappingError(this->path, error);
+        }
+        this->size = static_cast<size_t>(status.st_size);
+        if (this->size == 0) {
+            // Empty files can't be mapped, there is nothing to read anyway.
+            ::close(descriptor);
+            return;
+        }
+        // Mapping stays valid after descriptor is closed.
+        void*     mapping = ::mmap(nullptr, this->size, PROT_READ, MAP_SHARED, descriptor, 0);
+        const int error   = errno;
+        ::close(descriptor);
+        if (mapping == MAP_FAILED) {
+            throwMappingError(this->path, error);
+        }
+        // Curves are read front to back when batches are staged, let kernel read ahead.
+        ::madvise(mapping, this->size, MADV_SEQUENTIAL);
+        this->data = static_cast<const std::byte*>(mapping);
+    }
+
+    MappedFile::~MappedFile() {
+        if (this->data != nullptr) {
+            ::munmap(const_cast<std::byte*>(this->data), this->size); // NOLINT
+        }
+    }
+#endif
+
+    PotentialFileInfo readPotentialFileInfo(const MappedFile& file) {
+        checkByteOrder();
+
+        const auto          bytes = file.getBytes();
+        PotentialFileHeader header{};
+        if (bytes.size() < sizeof(header)) {
+            throw std::runtime_error(fmt::format(
+                "Potential file {} is too short to hold header.", file.getPath().string()
+            ));
+        }
+        std::memcpy(&header, bytes.data(), sizeof(header));
+
+        if (header.magic != PotentialFileHeader::expectedMagic) {
+            throw std::runtime_error(
+                fmt::format("File {} is not a potential file.", file.getPath().string())
+            );
+        }
+        if (header.version != PotentialFileHeader::currentVersion) {
+            throw std::runtime_error(fmt::format(
+                "Potential file {} has unsupported version {}.",
+                file.getPath().string(),
+                header.version
+            ));
+        }
+        PotentialFileInfo info{
+            .pointCount = header.pointCount,
+            .curveCount = header.curveCount,
+            .rMin       = header.rMin,
+            .rMax       = header.rMax,
+            .dataOffset = header.dataOffset
+        };
+        if (header.valueBits == getValueBits(PrecisionType::Float32)) {
+            info.precision = PrecisionType::Float32;
+        } else if (header.valueBits == getValueBits(PrecisionType::Float64)) {
+            info.precision = PrecisionType::Float64;
+        } else {
+            throw std::runtime_error(fmt::format(
+                "Potential file {} has unsupported value size of {} bits.",
+                file.getPath().string(),
+                header.valueBits
+            ));
+        }
+        if (info.dataOffset < sizeof(header) ||
+            info.dataOffset % PotentialFileHeader::dataAlignment != 0) {
+            throw std::runtime_error(fmt::format(
+                "Potential file {} has invalid curve matrix offset {}.",
+                file.getPath().string(),
+                info.dataOffset
+            ));
+        }
+        // Checked by division, so that huge counts in corrupted header can't overflow.
+        const uint64_t valueSize = getSizeBytes(info.precision);
+        const uint64_t available = bytes.size() > info.dataOffset ? bytes.size() - info.dataOffset
+                                                                  : 0;
+        if (info.pointCount != 0 && info.curveCount > available / valueSize / info.pointCount) {
+            throw std::runtime_error(fmt::format(
+                "Potential file {} is truncated, {} curves of {} points don't fit in {} bytes.",
+                file.getPath().string(),
+                info.curveCount,
+                info.pointCount,
+                bytes.size()
+            ));
+        }
+        return info;
+    }
+
+    bool isPotentialFile(const MappedFile& file) {
+        const auto bytes = file.getBytes();
+        return bytes.size() >= PotentialFileHeader::expectedMagic.size() &&
+               std::memcmp(
+                   bytes.data(),
+                   PotentialFileHeader::expectedMagic.data(),
+                   PotentialFileHeader::expectedMagic.size()
+               ) == 0;
+    }
+
+    PotentialTextLayout scanPotentialTextFile(const MappedFile& file, uint32_t threadCount) {
+        const auto  bytes = file.getBytes();
+        const auto* text  = reinterpret_cast<const char*>(bytes.data());
+
+        // Chunks end right after line end, so that no line is split between them.
+        PotentialTextLayout layout{};
+        for (size_t begin = 0; begin < bytes.size();) {
+            size_t end = std::min(begin + textChunkSize, bytes.size());
+            if (end != bytes.size()) {
+                const auto* lineEnd = static_cast<const char*>(
+                    std::memchr(text + end, '\n', bytes.size() - end)
+                );
+                end = lineEnd == nullptr ? bytes.size() : (lineEnd - text) + 1;
+            }
+            layout.chunks.push_back({.begin = begin, .end = end});
+            begin = end;
+        }
+        std::vector<size_t> pointCounts(layout.chunks.size());
+        runTasks(layout.chunks.size(), threadCount, [&](size_t index) {
+            const auto& chunk = layout.chunks[index];
+            forEachDataLine(text + chunk.begin, text + chunk.end, [&](auto*, auto*) {
+                pointCounts[index]++;
+            });
+        });
+
+        size_t pointCount = 0;
+        for (size_t i = 0; i < layout.chunks.size(); i++) {
+            layout.chunks[i].firstPoint  = pointCount;
+            pointCount                  += pointCounts[i];
+        }
+        if (pointCount == 0) {
+            throw std::runtime_error(
+                fmt::format("Potential file {} holds no points.", file.getPath().string())
+            );
+        }
+        if (pointCount > std::numeric_limits<uint32_t>::max()) {
+            throw std::runtime_error(fmt::format(
+                "Potential file {} holds {} points, more than curve can have.",
+                file.getPath().string(),
+                pointCount
+            ));
+        }
+        // Grid spans from first to last point, only chunks holding them are read again.
+        const auto firstChunk = std::ranges::find_if(pointCounts, [](size_t count) {
+            return count != 0;
+        });
+        const auto lastChunk = std::ranges::find_if(
+            pointCounts.rbegin(), pointCounts.rend(), [](size_t count) { return count != 0; }
+        );
+        std::string_view firstLine{};
+        std::string_view lastLine{};
+        const auto&      first = layout.chunks[firstChunk - pointCounts.begin()];
+        forEachDataLine(text + first.begin, text + first.end, [&](auto* begin, auto* end) {
+            if (firstLine.data() == nullptr) {
+                firstLine = {begin, end};
+            }
+        });
+        const auto& last = layout.chunks[pointCounts.rend() - lastChunk - 1];
+        forEachDataLine(text + last.begin, text + last.end, [&](auto* begin, auto* end) {
+            lastLine = {begin, end};
+        });
+
+        layout.info = PotentialFileInfo{
+            .precision  = PrecisionType::Float64,
+            .pointCount = static_cast<uint32_t>(pointCount),
+            .curveCount = 1,
+            .rMin       = parseTextPoint<double>(firstLine, file, 0).r,
+            .rMax       = parseTextPoint<double>(lastLine, file, pointCount - 1).r
+        };
+        return layout;
+    }
+
+    template <>
+    void parsePotentialTextFiles<float>(
+        std::span<const PotentialTextSpec<float>> files, uint32_t threadCount
+    ) {
+        parseTextFiles<float>(files, threadCount);
+    }
+
+    template <>
+    void parsePotentialTextFiles<double>(
+        std::span<const PotentialTextSpec<double>> files, uint32_t threadCount
+    ) {
+        parseTextFiles<double>(files, threadCount);
+    }
+
+    namespace {
+        template <typename FP>
+        void writeFile(
+            const std::filesystem::path& path,
+            const PotentialView<FP>&     potentials,
+            double                       rMin,
+            double                       rMax
+        ) {
+            checkByteOrder();
+
+            const size_t pointCount = potentials.empty() ? 0 : potentials[0].size();
+            for (size_t i = 0; i < potentials.size(); i++) {
+                if (potentials[i].size() != pointCount) {
+                    throw std::runtime_error(fmt::format(
+                        "All potentials must have same point count, got {} and {}.",
+                        pointCount,
+                        potentials[i].size()
+                    ));
+                }
+            }
+            const PotentialFileHeader header{
+                .valueBits  = getValueBits(getPrecisionType<FP>()),
+                .pointCount = static_cast<uint32_t>(pointCount),
+                .curveCount = potentials.size(),
+                .rMin       = rMin,
+                .rMax       = rMax,
+                .dataOffset = sizeof(PotentialFileHeader)
+            };
+            std::ofstream file{path, std::ios::binary | std::ios::trunc};
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            for (size_t i = 0; i < potentials.size() && file; i++) {
+                const auto curve = potentials[i];
+                file.write(
+                    reinterpret_cast<const char*>(curve.data()),
+                    static_cast<std::streamsize>(curve.size_bytes())
+                );
+            }
+            file.close();
+            if (!file) {
+                throw std::runtime_error(
+                    fmt::format("Failed to write potential file {}.", path.string())
+                );
+            }
+        }
+    } // namespace
+
+    template <>
+    void writePotentialFile<float>(
+        const std::filesystem::path& path,
+        const PotentialView<float>&  potentials,
+        double                       rMin,
+        double                       rMax
+    ) {
+        writeFile<float>(path, potentials, rMin, rMax);
+    }
+
+    template <>
+    void writePotentialFile<double>(
+        const std::filesystem::path& path,
+        const PotentialView<double>& potentials,
+        double                       rMin,
+        double                       rMax
+    ) {
+        writeFile<double>(path, potentials, rMin, rMax);
+    }
+} // namespace epseon::cpp
@@ -1,7 +1,123 @@
 from __future__ import annotations
 
+from typing import Literal
+
 def greet() -> None:
     """Show greeting to stdout.
 
     This is a temporary example function.
     """
+
+class MorsePotentialConfig:
+    """Configuration of single Morse potential curve."""
+
+    def __init__(  # noqa: PLR0913
+        self,
+        dissociation_energy: float,
+        equilibrium_bond_distance: float,
+        well_width: float,
+        min_r: float,
+        max_r: float,
+        point_count: int,
+    ) -> None:
+        """Create instance of MorsePotentialConfig class."""
+
+class TaskConfigurator:
+    """Builder for CPU compute task."""
+
+    def set_hardware_config(
+        self,
+        potential_buffer_size: int,
+        group_size: int,
+        allocation_block_size: int,
+    ) -> _PartialConfig1:
+        """Set hardware configuration for CPU compute task.
+
+        `group_size` is number of potentials in batch processed by single worker
+        thread at a time, `allocation_block_size` is ignored by CPU backend.
+        """
+
+class _PartialConfig1:
+    """Partially finished configuration on stage 1.
+
+    Includes configuration for hardware.
+    """
+
+    def set_morse_potential(
+        self,
+        __configs: list[MorsePotentialConfig],
+    ) -> _PartialConfig2:
+        """Set potential data source configuration.
+
+        Raises
+        ------
+        RuntimeError when MorsePotentialConfigs with different point counts are used.
+        """
+
+class _PartialConfig2:
+    """Partially finished configuration on stage 2.
+
+    Includes configuration for hardware and for potential source.
+    """
+
+    def set_vibwa_algorithm(  # noqa: PLR0913
+        self,
+        mass_atom_0: float,
+        mass_atom_1: float,
+        integration_step: float,
+        min_distance_to_asymptote: float,
+        min_level: int,
+        max_level: int,
+    ) -> TaskConfig:
+        """Set task algorithm configuration."""
+
+class TaskConfig:
+    """Finalized task configuration object."""
+
+class TaskHandle:
+    """Handle object for referencing CPU compute task."""
+
+    def is_done(self) -> bool:
+        """Check if task has finished."""
+    def is_running(self) -> bool:
+        """Check if task is running."""
+    def cancel(self) -> None:
+        """Request task to stop, levels which were not computed stay NaN."""
+    def wait(self) -> None:
+        """Wait for task to finish."""
+    def get_results(self) -> list[list[float]]:
+        """Get energies of vibrational levels, one list per potential.
+
+        Levels which could not be found are NaN. Raises RuntimeError if task is not
+        finished or if it failed.
+        """
+
+class EpseonComputeContext:
+    """Interface to computations on CPU.
+
+    VIBWA kernels use widest SIMD instruction set supported by CPU, unless one is
+    requested explicitly, and potentials are distributed between worker threads.
+    """
+
+    @staticmethod
+    def create(
+        thread_count: int = 0,
+        instruction_set: Literal["scalar", "avx2", "avx512"] | None = None,
+    ) -> EpseonComputeContext:
+        """Create new instance of EpseonComputeContext type.
+
+        `thread_count` equal to 0 means one thread per hardware thread. Raises
+        ValueError for unknown instruction set name and RuntimeError for instruction
+        set not supported by CPU.
+        """
+    def get_instruction_set(self) -> Literal["scalar", "avx2", "avx512"]:
+        """Get name of instruction set used by VIBWA kernels."""
+    def get_thread_count(self) -> int:
+        """Get number of worker threads used by tasks."""
+    def get_task_configurator(
+        self,
+        __precision: Literal["float32", "float64"],
+    ) -> TaskConfigurator:
+        """Get new task configurator instance."""
+    def submit_task(self, __config: TaskConfig) -> TaskHandle:
+        """Submit task for execution."""
@@ -1,6 +1,9 @@
 from __future__ import annotations
 
-from typing import Iterable, Literal, Protocol
+from typing import Any, Iterable, Iterator, Literal, Protocol
+
+import numpy as np
+import numpy.typing as npt
 
 class PhysicalDeviceSparseProperties(Protocol):
     """Sparse resources properties retrieved from Vulkan API."""
@@ -86,8 +89,12 @@ class TaskConfigurator:
         potential_buffer_size: int,
         group_size: int,
         allocation_block_size: int,
+        workgroup_size: int = 0,
     ) -> _PartialConfig1:
-        """Set hardware configuration for GPU compute task."""
+        """Set hardware configuration for GPU compute task.
+
+        Workgroup size 0 selects default one, clamped to device limits.
+        """
 
 class MorsePotentialConfig:
     """Configuration of single Morse potential curve."""
@@ -119,6 +126,36 @@ class _PartialConfig1:
         ------
         RuntimeError when MorsePotentialConfigs with different point counts are used.
         """
+    def set_potential_array(
+        self,
+        array: npt.NDArray[np.floating[Any]],
+    ) -> _PartialConfig2:
+        """Set potential curves given as values on grid, one row per potential.
+
+        Array must be C-contiguous, 2D and have dtype matching precision of task, it is
+        not copied but uploaded to device straight from its memory, so it must not be
+        modified while tasks using it run.
+
+        Raises
+        ------
+        TypeError when array is not C-contiguous or has other dtype.
+        RuntimeError when array is not 2D.
+        """
+    def set_potential_files(
+        self,
+        file_names: list[str],
+    ) -> _PartialConfig2:
+        """Set potential curves stored in binary potential files.
+
+        Curves of all files are used in order of files. Files are memory mapped and
+        curves are read from page cache when task runs, without copying them when file
+        stores values of precision of task.
+
+        Raises
+        ------
+        RuntimeError when file can't be opened, is not a potential file or files have
+        different grids.
+        """
 
 class _PartialConfig2:
     """Partially finished configuration on stage 2.
@@ -140,15 +177,106 @@ class _PartialConfig2:
 class TaskConfig:
     """Finalized task configuration object."""
 
+class TaskTimings(Protocol):
+    """Time spent by GPU compute task in each of its phases, in seconds.
+
+    Device durations are None when device doesn't support timestamp queries on queue
+    used. Uploads overlap with computation, so phases don't add up to total.
+    """
+
+    potential_generation: float
+    device_setup: float
+    resource_setup: float
+    pipeline_setup: float
+    staging_write: float
+    device_wait: float
+    read_back: float
+    total: float
+    device_upload: float | None
+    device_compute: float | None
+    batch_count: int
+    dispatch_count: int
+
+class TaskProgress(Protocol):
+    """Snapshot of progress of GPU compute task.
+
+    Phase is one of "Pending", "GeneratingPotentials", "Preparing", "Computing",
+    "Finished", "Cancelled" and "Failed". Counts grow while task runs, potential
+    count is 0 until potentials are generated.
+    """
+
+    phase: str
+    potential_count: int
+    potentials_completed: int
+    levels_found: int
+    bytes_uploaded: int
+    bytes_read_back: int
+
 class TaskHandle:
     """Handle object for referencing GPU compute task."""
 
     def get_status_message(self) -> str:
-        """Get task status message."""
+        """Get task phase and progress formatted for display."""
     def is_done(self) -> bool:
         """Check if task has finished."""
     def wait(self) -> None:
         """Wait for task to finish."""
+    def cancel(self) -> None:
+        """Request task to stop.
+
+        Device finishes only dispatches already in flight, results of potentials
+        computed so far stay available, others are NaN.
+        """
+    def get_results(self) -> list[list[float]]:
+        """Get energies of vibrational levels, one list per potential.
+
+        Levels which could not be found are NaN. Raises RuntimeError if task is not
+        finished or if it failed.
+        """
+    def get_results_array(self) -> npt.NDArray[np.floating[Any]]:
+        """Get energies of vibrational levels as array with one row per potential.
+
+        Array is read-only view of results kept by task, nothing is copied, task stays
+        alive as long as array or its views exist. Levels which could not be found are
+        NaN. Raises RuntimeError if task is not finished or if it failed.
+        """
+    def get_timings(self) -> TaskTimings:
+        """Get time spent in phases of task.
+
+        Raises RuntimeError if task is not finished.
+        """
+    def get_progress(self) -> TaskProgress:
+        """Get progress of task, it doesn't block and can be polled while task runs."""
+    def stream_results(
+        self,
+    ) -> Iterator[tuple[int, npt.NDArray[np.floating[Any]]]]:
+        """Iterate over batches of results as soon as device finishes them.
+
+        Each item holds index of first potential of batch and array of energies of
+        vibrational levels of its potentials, one row per potential. Batches come in
+        order of completion. Task must have been submitted with stream_capacity, it
+        stalls once that many batches wait to be consumed. Raises error of task once
+        all batches were consumed if it failed.
+        """
+
+class BatchPlan(Protocol):
+    """Split of task into batches processed back-to-back."""
+
+    potentials_per_batch: int
+    potentials_per_buffer: int
+    buffer_set_count: int
+    batches_in_flight: int
+    batch_count: int
+    device_local_bytes: int
+    host_visible_bytes: int
+
+class HardwareConfig(Protocol):
+    """Hardware configuration of GPU compute task."""
+
+    potential_buffer_size: int
+    group_size: int
+    allocation_block_size: int
+    workgroup_size: int
 
 class ComputeDeviceInterface:
     """Interface to particular Vulkan device.
@@ -160,11 +288,71 @@ class ComputeDeviceInterface:
 
     def get_task_configurator(
         self,
-        __precision: Literal["float32", "float64"],
+        __precision: Literal["float16", "float32", "float64", "float64-emulated"],
+    ) -> TaskConfigurator:
+        """Get new task configurator instance.
+
+        "float16" stores potentials in half precision on device and computes in single
+        precision, results are single precision with roughly 1e-3 relative accuracy.
+        "float64" falls back to "float64-emulated" on devices without double precision
+        support in shaders, which computes with pairs of floats instead.
+        """
+    def submit_task(
+        self, task_config: TaskConfig, stream_capacity: int = 0
+    ) -> TaskHandle:
+        """Submit task for execution.
+
+        With non-zero stream_capacity results are delivered through
+        TaskHandle.stream_results() instead of get_results().
+        """
+    def plan_task(self, __config: TaskConfig) -> BatchPlan:
+        """Get split of task into batches with current memory budgets of device.
+
+        Task plans again when it starts, so plan may change if other processes
+        allocate or free device memory in the meantime.
+        """
+    def autotune_hardware_config(
+        self,
+        precision: Literal["float16", "float32", "float64", "float64-emulated"],
+        point_count: int,
+        level_count: int,
+        use_cache: bool = True,  # noqa: FBT001, FBT002
+    ) -> HardwareConfig:
+        """Find hardware configuration for tasks of given shape by benchmarking device.
+
+        Results are cached on disk per device UUID next to pipeline cache, so
+        benchmarks run only once for every device and task shape unless use_cache
+        is False.
+        """
+
+class MultiDeviceInterface:
+    """Interface splitting tasks between multiple Vulkan devices.
+
+    Potentials of each task are divided between devices in proportion to throughput
+    measured on previous tasks, results are returned in original order.
+    """
+
+    def get_task_configurator(
+        self,
+        __precision: Literal["float16", "float32", "float64", "float64-emulated"],
     ) -> TaskConfigurator:
-        """Get new task configurator instance."""
-    def submit_task(self, __config: TaskConfig) -> TaskHandle:
-        """Submit task for execution."""
+        """Get new task configurator instance.
+
+        "float16" stores potentials in half precision on device and computes in single
+        precision, results are single precision with roughly 1e-3 relative accuracy.
+        "float64" falls back to "float64-emulated" on devices without double precision
+        support in shaders, which computes with pairs of floats instead.
+        """
+    def submit_task(
+        self, task_config: TaskConfig, stream_capacity: int = 0
+    ) -> TaskHandle:
+        """Submit task for execution on all devices.
+
+        With non-zero stream_capacity results are delivered through
+        TaskHandle.stream_results() instead of get_results().
+        """
+    def get_throughput(self) -> list[float]:
+        """Get measured throughput of each device in potential points per second."""
 
 class EpseonComputeContext(Protocol):
     """Interface to computations on GPU with Vulkan."""
@@ -178,3 +366,11 @@ class EpseonComputeContext(Protocol):
         """Get information about available physical devices."""
     def get_device_interface(self, __device_id: int) -> ComputeDeviceInterface:
         """Get interface for running algorithms on Vulkan devices."""
+    def get_multi_device_interface(
+        self,
+        device_ids: Iterable[int] = (),
+    ) -> MultiDeviceInterface:
+        """Get interface splitting tasks between devices, all devices by default.
+
+        Device ID may be repeated, device is opened multiple times then.
+        """
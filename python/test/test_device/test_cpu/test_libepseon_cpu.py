@@ -1,9 +1,73 @@
 """Test components of `epseon_backend.device.cpu._libepseon_cpu` submodule."""
 from __future__ import annotations
 
+import pytest
+
 
 def test_greet() -> None:
     """Check if temporary `greet()` method exported from _libepseon_cpu is available."""
     from epseon_backend.device.cpu._libepseon_cpu import greet
 
     greet()
+
+
+def test_morse_levels_match_analytic_solution() -> None:
+    """Check if CPU backend finds vibrational levels of Morse potential."""
+    from epseon_backend.device.cpu._libepseon_cpu import (
+        EpseonComputeContext,
+        MorsePotentialConfig,
+    )
+
+    ctx = EpseonComputeContext.create(2)
+    assert ctx.get_thread_count() == 2  # noqa: PLR2004
+
+    dissociation_energy = 5500.0
+    well_width = 1.0
+    mass = 87.62
+    handle = ctx.submit_task(
+        ctx.get_task_configurator("float64")
+        .set_hardware_config(
+            potential_buffer_size=4000,
+            group_size=16,
+            allocation_block_size=0,
+        )
+        .set_morse_potential(
+            [
+                MorsePotentialConfig(
+                    dissociation_energy=dissociation_energy,
+                    equilibrium_bond_distance=4.0,
+                    well_width=well_width,
+                    min_r=2.0,
+                    max_r=20.0,
+                    point_count=4000,
+                ),
+            ],
+        )
+        .set_vibwa_algorithm(
+            mass_atom_0=mass,
+            mass_atom_1=mass,
+            integration_step=18.0 / 3999,
+            min_distance_to_asymptote=0.1,
+            min_level=0,
+            max_level=4,
+        ),
+    )
+    handle.wait()
+    assert handle.is_done()
+
+    (levels,) = handle.get_results()
+    b = 16.857629206 / (mass / 2)
+    omega = 2.0 * well_width * (dissociation_energy * b) ** 0.5
+    for v, energy in enumerate(levels):
+        expected = omega * (v + 0.5) - (omega * (v + 0.5)) ** 2 / (
+            4 * dissociation_energy
+        )
+        assert abs(energy - expected) < 1e-2  # noqa: PLR2004
+
+
+def test_create_unknown_instruction_set() -> None:
+    """Check if using incorrect instruction set name raises ValueError."""
+    from epseon_backend.device.cpu._libepseon_cpu import EpseonComputeContext
+
+    with pytest.raises(ValueError, match="sse9"):
+        EpseonComputeContext.create(1, "sse9")  # type: ignore[arg-type]
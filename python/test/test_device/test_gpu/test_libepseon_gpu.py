@@ -2,14 +2,19 @@
 from __future__ import annotations
 
 import logging
+import math
 import re
 from contextlib import suppress
-from typing import TYPE_CHECKING, Literal
+from typing import TYPE_CHECKING, Any, Literal
 
+import numpy as np
+import numpy.typing as npt
 import pytest
 from epseon_backend.format import convert_size_in_bytes_to_adaptive_unit
 
 if TYPE_CHECKING:
+    from pathlib import Path
+
     from epseon_backend.device.gpu._libepseon_gpu import (
         TaskConfig,
         TaskConfigurator,
@@ -153,10 +158,12 @@ class TestEpseonComputeContext:
         interface = ctx.get_device_interface(device_info.device_properties.device_id)
         assert id(interface)
 
-    @pytest.mark.parametrize("precision", ["float32", "float64"])
+    @pytest.mark.parametrize(
+        "precision", ["float16", "float32", "float64", "float64-emulated"]
+    )
     def test_get_and_use_task_configurator(
         self,
-        precision: Literal["float32", "float64"],
+        precision: Literal["float16", "float32", "float64", "float64-emulated"],
     ) -> None:
         """Check if getting information about available physical devices is possible."""
         from epseon_backend.device.gpu._libepseon_gpu import EpseonComputeContext
@@ -169,16 +176,20 @@ class TestEpseonComputeContext:
         cfg = self._configure_task(configurator)
         assert id(cfg)
 
-    def _configure_task(self, configurator: TaskConfigurator) -> TaskConfig:
+    def _configure_task(
+        self,
+        configurator: TaskConfigurator,
+        potentials: npt.NDArray[np.floating[Any]] | None = None,
+    ) -> TaskConfig:
         from epseon_backend.device.gpu._libepseon_gpu import MorsePotentialConfig
 
-        return (
-            configurator.set_hardware_config(
-                potential_buffer_size=16500,
-                group_size=512,
-                allocation_block_size=16 * 1024 * 1024,
-            )
-            .set_morse_potential(
+        hardware_config = configurator.set_hardware_config(
+            potential_buffer_size=16500,
+            group_size=512,
+            allocation_block_size=16 * 1024 * 1024,
+        )
+        if potentials is None:
+            potential_config = hardware_config.set_morse_potential(
                 [
                     MorsePotentialConfig(
                         dissociation_energy=5500.0,
@@ -198,14 +209,37 @@ class TestEpseonComputeContext:
                     ),
                 ],
             )
-            .set_vibwa_algorithm(
-                mass_atom_0=87.62,
-                mass_atom_1=87.62,
-                integration_step=0.1,
-                min_distance_to_asymptote=0.1,
-                min_level=0,
-                max_level=0,
-            )
+        else:
+            potential_config = hardware_config.set_potential_array(potentials)
+
+        return potential_config.set_vibwa_algorithm(
+            mass_atom_0=87.62,
+            mass_atom_1=87.62,
+            integration_step=0.1,
+            min_distance_to_asymptote=0.1,
+            min_level=0,
+            max_level=0,
+        )
+
+    def test_autotune_hardware_config(self) -> None:
+        """Check if tuned hardware configuration can be used to configure task."""
+        from epseon_backend.device.gpu._libepseon_gpu import EpseonComputeContext
+
+        ctx = EpseonComputeContext.create()
+
+        device_info = next(iter(ctx.get_physical_device_info()))
+        interface = ctx.get_device_interface(device_info.device_properties.device_id)
+        config = interface.autotune_hardware_config("float32", 501, 4)
+        assert config.potential_buffer_size == 501
+        assert config.group_size > 0
+        assert config.workgroup_size > 0
+
+        configurator = interface.get_task_configurator("float32")
+        configurator.set_hardware_config(
+            potential_buffer_size=config.potential_buffer_size,
+            group_size=config.group_size,
+            allocation_block_size=config.allocation_block_size,
+            workgroup_size=config.workgroup_size,
         )
 
     def test_get_and_use_task_configurator_unknown_precision(self) -> None:
@@ -323,10 +357,275 @@ class TestEpseonComputeContext:
         handle.wait()
         assert handle.is_done()
 
+    @pytest.mark.parametrize("precision", ["float32", "float64"])
+    def test_get_timings(self, precision: Literal["float32", "float64"]) -> None:
+        """Check if timings of finished task are reported."""
+        handle = self._submit_task(precision)
+        handle.wait()
+
+        timings = handle.get_timings()
+        assert timings.total > 0.0
+        assert timings.batch_count >= 1
+        assert timings.potential_generation <= timings.total
+        for device_time in (timings.device_upload, timings.device_compute):
+            assert device_time is None or device_time >= 0.0
+
+    def test_cancel_keeps_results_readable(self) -> None:
+        """Check if results of cancelled task can be read."""
+        handle = self._submit_task("float32")
+        handle.cancel()
+        handle.wait()
+
+        assert handle.is_done()
+        assert isinstance(handle.get_results(), list)
+        assert handle.get_timings().total > 0.0
+
+    def test_get_progress(self) -> None:
+        """Check if progress is reported while task runs and once it finishes."""
+        handle = self._submit_task("float32")
+        assert handle.get_progress().phase in (
+            "Pending",
+            "GeneratingPotentials",
+            "Preparing",
+            "Computing",
+            "Finished",
+        )
+        handle.wait()
+
+        progress = handle.get_progress()
+        assert progress.phase == "Finished"
+        assert progress.potentials_completed == progress.potential_count
+        assert progress.levels_found == sum(
+            not math.isnan(level) for levels in handle.get_results() for level in levels
+        )
+        assert progress.bytes_uploaded > 0
+        assert progress.bytes_read_back > 0
+        assert handle.get_status_message().startswith("Finished")
+
+    @pytest.mark.parametrize("precision", ["float32", "float64"])
+    def test_stream_results(self, precision: Literal["float32", "float64"]) -> None:
+        """Check if streamed batches cover all potentials of task."""
+        handle = self._submit_task(precision, stream_capacity=1)
+
+        solved: list[int] = []
+        for first_potential, levels in handle.stream_results():
+            assert levels.ndim == 2
+            solved.extend(range(first_potential, first_potential + levels.shape[0]))
+
+        assert handle.is_done()
+        assert sorted(solved) == list(range(handle.get_progress().potential_count))
+        assert handle.get_results() == []
+
+    @pytest.mark.parametrize(
+        ("precision", "dtype"), [("float32", np.float32), ("float64", np.float64)]
+    )
+    def test_get_results_array(
+        self, precision: Literal["float32", "float64"], dtype: type[np.floating[Any]]
+    ) -> None:
+        """Check if results array matches results lists and outlives handle."""
+        handle = self._submit_task(precision)
+        handle.wait()
+
+        results = handle.get_results_array()
+        assert results.dtype == dtype
+        assert not results.flags.writeable
+        np.testing.assert_array_equal(results, np.array(handle.get_results(), dtype))
+
+        expected = results.copy()
+        del handle
+        np.testing.assert_array_equal(results, expected)
+
+    @pytest.mark.parametrize(
+        ("precision", "dtype"), [("float32", np.float32), ("float64", np.float64)]
+    )
+    def test_set_potential_array(
+        self, precision: Literal["float32", "float64"], dtype: type[np.floating[Any]]
+    ) -> None:
+        """Check if curves from array give the same levels as equal Morse potentials."""
+        r = np.linspace(0.0, 10.0, 16500)
+        curve = 5500.0 * (1.0 - np.exp(-10.0 * (r - 0.6))) ** 2
+        potentials = np.stack([curve, curve]).astype(dtype)
+
+        handle = self._submit_task(precision, potentials=potentials)
+        # Task keeps array alive on its own.
+        del potentials
+        handle.wait()
+
+        expected = self._submit_task(precision)
+        expected.wait()
+        np.testing.assert_allclose(
+            handle.get_results_array(), expected.get_results_array(), rtol=1e-4
+        )
+
+    @pytest.mark.parametrize(
+        "potentials",
+        [
+            np.zeros((2, 16500), dtype=np.float64),
+            np.zeros((2, 16500), dtype=np.float32, order="F"),
+        ],
+    )
+    def test_set_potential_array_rejects_conversion(
+        self, potentials: npt.NDArray[np.floating[Any]]
+    ) -> None:
+        """Check if arrays which would have to be copied are rejected."""
+        from epseon_backend.device.gpu._libepseon_gpu import EpseonComputeContext
+
+        ctx = EpseonComputeContext.create()
+
+        device_info = next(iter(ctx.get_physical_device_info()))
+        interface = ctx.get_device_interface(device_info.device_properties.device_id)
+        configurator = interface.get_task_configurator("float32")
+
+        with pytest.raises(TypeError):
+            self._configure_task(configurator, potentials)
+
+    def test_set_potential_array_rejects_1d(self) -> None:
+        """Check if array which is not 2D is rejected."""
+        from epseon_backend.device.gpu._libepseon_gpu import EpseonComputeContext
+
+        ctx = EpseonComputeContext.create()
+
+        device_info = next(iter(ctx.get_physical_device_info()))
+        interface = ctx.get_device_interface(device_info.device_properties.device_id)
+        configurator = interface.get_task_configurator("float32")
+
+        with pytest.raises(RuntimeError):
+            self._configure_task(configurator, np.zeros(16500, dtype=np.float32))
+
+    @pytest.mark.parametrize(
+        ("precision", "dtype"), [("float32", np.float32), ("float64", np.float64)]
+    )
+    def test_set_potential_array_again_after_submit(
+        self, precision: Literal["float32", "float64"], dtype: type[np.floating[Any]]
+    ) -> None:
+        """Check if array set after submit neither changes nor hangs submitted task."""
+        from epseon_backend.device.gpu._libepseon_gpu import EpseonComputeContext
+
+        ctx = EpseonComputeContext.create()
+
+        device_info = next(iter(ctx.get_physical_device_info()))
+        interface = ctx.get_device_interface(device_info.device_properties.device_id)
+        configurator = interface.get_task_configurator(precision)
+        hardware_config = configurator.set_hardware_config(
+            potential_buffer_size=16500,
+            group_size=512,
+            allocation_block_size=16 * 1024 * 1024,
+        )
+
+        r = np.linspace(0.0, 10.0, 16500)
+        curve = 5500.0 * (1.0 - np.exp(-10.0 * (r - 0.6))) ** 2
+        cfg = hardware_config.set_potential_array(
+            np.stack([curve, curve]).astype(dtype)
+        ).set_vibwa_algorithm(
+            mass_atom_0=87.62,
+            mass_atom_1=87.62,
+            integration_step=0.1,
+            min_distance_to_asymptote=0.1,
+            min_level=0,
+            max_level=0,
+        )
+        handle = interface.submit_task(cfg)
+        # Submitted task is left as the only owner of first array.
+        hardware_config.set_potential_array(np.zeros((2, 16500), dtype=dtype))
+        handle.wait()
+
+        expected = self._submit_task(precision)
+        expected.wait()
+        np.testing.assert_allclose(
+            handle.get_results_array(), expected.get_results_array(), rtol=1e-4
+        )
+
+    @pytest.mark.parametrize(
+        ("precision", "dtype"), [("float32", np.float32), ("float64", np.float64)]
+    )
+    def test_set_potential_files(
+        self,
+        precision: Literal["float32", "float64"],
+        dtype: type[np.floating[Any]],
+        tmp_path: Path,
+    ) -> None:
+        """Check if curves from potential files give the same levels as from array."""
+        import struct
+
+        from epseon_backend.device.gpu._libepseon_gpu import EpseonComputeContext
+
+        r = np.linspace(0.0, 10.0, 16500)
+        curve = 5500.0 * (1.0 - np.exp(-10.0 * (r - 0.6))) ** 2
+        potentials = np.stack([curve, curve]).astype(dtype)
+        # Header of potential file, curves follow it at offset 64.
+        header = struct.pack(
+            "<8sIIIIQddQQ",
+            b"EPSEONPT",
+            1,
+            potentials.itemsize * 8,
+            potentials.shape[1],
+            0,
+            potentials.shape[0],
+            r[0],
+            r[-1],
+            64,
+            0,
+        )
+        path = tmp_path / "curves.pot"
+        values = potentials.astype(potentials.dtype.newbyteorder("<"))
+        path.write_bytes(header + values.tobytes())
+
+        ctx = EpseonComputeContext.create()
+        interface = ctx.get_device_interface(0)
+        configurator = interface.get_task_configurator(precision)
+        cfg = (
+            configurator.set_hardware_config(
+                potential_buffer_size=16500,
+                group_size=512,
+                allocation_block_size=16 * 1024 * 1024,
+            )
+            .set_potential_files([str(path)])
+            .set_vibwa_algorithm(
+                mass_atom_0=87.62,
+                mass_atom_1=87.62,
+                integration_step=0.1,
+                min_distance_to_asymptote=0.1,
+                min_level=0,
+                max_level=0,
+            )
+        )
+        handle = interface.submit_task(cfg)
+        handle.wait()
+
+        expected = self._submit_task(precision, potentials=potentials)
+        expected.wait()
+        np.testing.assert_array_equal(
+            handle.get_results_array(), expected.get_results_array()
+        )
+
+    def test_set_potential_files_rejects_missing_file(self, tmp_path: Path) -> None:
+        """Check if files which can't be read are rejected when they are set."""
+        from epseon_backend.device.gpu._libepseon_gpu import EpseonComputeContext
+
+        ctx = EpseonComputeContext.create()
+        configurator = ctx.get_device_interface(0).get_task_configurator("float32")
+        hardware_config = configurator.set_hardware_config(
+            potential_buffer_size=16500,
+            group_size=512,
+            allocation_block_size=16 * 1024 * 1024,
+        )
+        with pytest.raises(RuntimeError):
+            hardware_config.set_potential_files([str(tmp_path / "missing.pot")])
+
+    def test_stream_results_not_enabled(self) -> None:
+        """Check if streaming results of task submitted without stream fails."""
+        handle = self._submit_task("float32")
+        handle.wait()
+
+        with pytest.raises(RuntimeError):
+            handle.stream_results()
+
     def _submit_task(
         self,
         precision: Literal["float32", "float64"],
         device_id: int = 0,
+        stream_capacity: int = 0,
+        potentials: npt.NDArray[np.floating[Any]] | None = None,
     ) -> TaskHandle:
         from epseon_backend.device.gpu._libepseon_gpu import EpseonComputeContext
 
@@ -334,6 +633,6 @@ class TestEpseonComputeContext:
 
         interface = ctx.get_device_interface(device_id)
         configurator = interface.get_task_configurator(precision)
-        cfg = self._configure_task(configurator)
+        cfg = self._configure_task(configurator, potentials)
 
-        return interface.submit_task(cfg)
+        return interface.submit_task(cfg, stream_capacity=stream_capacity)